@@ -0,0 +1,107 @@
+#include "BenchHelpers.h"
+#include "SerializeWave.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+const std::vector<int64_t> COMPRESSION_METHODS = {
+    static_cast<int64_t>(CompressionMethod::LZ4),
+    static_cast<int64_t>(CompressionMethod::Zstd)};
+
+const std::vector<int64_t> WAVE_SIZES = benchmark::CreateRange(64, 1 << 20, 16);
+
+/// Return a serialized double wave as typical reply payload
+std::string GetPayload(CountInt numPoints)
+{
+  auto waveH       = MakeBenchWave(NT_FP64, numPoints);
+  const auto reply = SerializeWave(waveH).dump();
+  ReleaseWave(&waveH);
+
+  return reply;
+}
+
+/// @return true if the method is available
+bool SetupMethod(benchmark::State &state, CompressionMethod method)
+{
+  state.SetLabel(GetCompressionMethodString(method));
+
+  if(!IsCompressionMethodAvailable(method))
+  {
+    state.SkipWithError("compression method not available");
+    return false;
+  }
+
+  return true;
+}
+
+/// Arguments: compression method, number of wave points
+void BM_Compress(benchmark::State &state)
+{
+  const auto method = static_cast<CompressionMethod>(state.range(0));
+
+  if(!SetupMethod(state, method))
+  {
+    return;
+  }
+
+  const auto payload = GetPayload(static_cast<CountInt>(state.range(1)));
+  const CompressionSettings settings{method, 0};
+
+  std::string result;
+
+  for(auto _ : state)
+  {
+    result.clear();
+    benchmark::DoNotOptimize(
+        CompressFrame(settings, payload.data(), payload.size(), result));
+  }
+
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(payload.size()));
+  state.counters["ratio"] = static_cast<double>(result.size()) /
+                            static_cast<double>(payload.size());
+}
+
+/// Arguments: compression method, number of wave points
+void BM_Decompress(benchmark::State &state)
+{
+  const auto method = static_cast<CompressionMethod>(state.range(0));
+
+  if(!SetupMethod(state, method))
+  {
+    return;
+  }
+
+  const auto payload = GetPayload(static_cast<CountInt>(state.range(1)));
+  const CompressionSettings settings{method, 0};
+
+  std::string compressed;
+
+  if(!CompressFrame(settings, payload.data(), payload.size(), compressed))
+  {
+    state.SkipWithError("payload is not compressible");
+    return;
+  }
+
+  std::string result;
+
+  for(auto _ : state)
+  {
+    result.clear();
+    benchmark::DoNotOptimize(
+        DecompressFrame(compressed.data(), compressed.size(), result));
+  }
+
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(payload.size()));
+  state.counters["ratio"] = static_cast<double>(compressed.size()) /
+                            static_cast<double>(payload.size());
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_Compress)->ArgsProduct({COMPRESSION_METHODS, WAVE_SIZES});
+BENCHMARK(BM_Decompress)->ArgsProduct({COMPRESSION_METHODS, WAVE_SIZES});
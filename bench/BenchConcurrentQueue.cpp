@@ -0,0 +1,64 @@
+#include "BenchHelpers.h"
+#include "ConcurrentQueue.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+using QueueElement = std::shared_ptr<std::string>;
+
+ConcurrentQueue<QueueElement> queue;
+
+/// Every thread pushes and pops, so all threads contend for the same lock
+void BM_ConcurrentQueuePushPop(benchmark::State &state)
+{
+  auto elem = std::make_shared<std::string>("payload");
+  QueueElement popped;
+
+  for(auto _ : state)
+  {
+    queue.push(elem);
+    benchmark::DoNotOptimize(queue.try_pop(popped));
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+/// Thread zero is the consumer and drains the queue as the message handler
+/// does during IDLE, all other threads are producers
+void BM_ConcurrentQueueProducerConsumer(benchmark::State &state)
+{
+  auto elem = std::make_shared<std::string>("payload");
+
+  if(state.thread_index() == 0)
+  {
+    int64_t numPopped = 0;
+
+    for(auto _ : state)
+    {
+      queue.apply_to_all([&numPopped](const QueueElement &) { numPopped++; });
+    }
+
+    state.counters["popped"] =
+        benchmark::Counter(static_cast<double>(numPopped),
+                           benchmark::Counter::kIsRate);
+  }
+  else
+  {
+    for(auto _ : state)
+    {
+      queue.push(elem);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+  }
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_ConcurrentQueuePushPop)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ConcurrentQueueProducerConsumer)
+    ->ThreadRange(2, 16)
+    ->UseRealTime();
@@ -0,0 +1,76 @@
+#include "BenchHelpers.h"
+#include "MessageEncoding.h"
+#include "SerializeWave.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+const std::vector<int64_t> ENCODINGS = {
+    static_cast<int64_t>(MessageEncoding::JSON),
+    static_cast<int64_t>(MessageEncoding::MessagePack),
+    static_cast<int64_t>(MessageEncoding::CBOR)};
+
+const std::vector<int64_t> WAVE_SIZES = benchmark::CreateRange(16, 1 << 20, 16);
+
+/// Return a double wave reply as it is sent by GetWave
+json GetReply(CountInt numPoints)
+{
+  auto waveH = MakeBenchWave(NT_FP64, numPoints);
+
+  json reply;
+  reply["errorCode"]["value"] = REQ_SUCCESS;
+  reply["result"]["type"]     = "wave";
+  reply["result"]["value"]    = SerializeWave(waveH);
+
+  ReleaseWave(&waveH);
+
+  return reply;
+}
+
+/// Arguments: encoding, number of wave points
+void BM_EncodeReply(benchmark::State &state)
+{
+  const auto encoding = static_cast<MessageEncoding>(state.range(0));
+  const auto reply    = GetReply(static_cast<CountInt>(state.range(1)));
+
+  size_t numBytes = 0;
+
+  for(auto _ : state)
+  {
+    const auto str = EncodeMessage(reply, encoding);
+    numBytes       = str.size();
+    benchmark::DoNotOptimize(str.data());
+  }
+
+  state.SetLabel(GetMessageEncodingString(encoding));
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(numBytes));
+  state.counters["size"] = static_cast<double>(numBytes);
+}
+
+/// Arguments: encoding, number of wave points
+///
+/// Decoding on the client side, the XOP decodes requests in the same way.
+void BM_DecodeReply(benchmark::State &state)
+{
+  const auto encoding = static_cast<MessageEncoding>(state.range(0));
+  const auto payload  = EncodeMessage(
+      GetReply(static_cast<CountInt>(state.range(1))), encoding);
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(DecodeMessage(payload, encoding));
+  }
+
+  state.SetLabel(GetMessageEncodingString(encoding));
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(payload.size()));
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_EncodeReply)->ArgsProduct({ENCODINGS, WAVE_SIZES});
+BENCHMARK(BM_DecodeReply)->ArgsProduct({ENCODINGS, WAVE_SIZES});
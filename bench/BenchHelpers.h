@@ -0,0 +1,137 @@
+#pragma once
+
+#include "ZeroMQ.h"
+#include "FakeIgor.h"
+
+#include <benchmark/benchmark.h>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// Transports of the socket benchmarks, passed as benchmark argument
+enum class Transport
+{
+  Inproc,
+  IPC,
+  TCP
+};
+
+const std::vector<int64_t> ALL_TRANSPORTS = {
+    static_cast<int64_t>(Transport::Inproc),
+    static_cast<int64_t>(Transport::IPC), static_cast<int64_t>(Transport::TCP)};
+
+inline std::string GetTransportName(Transport transport)
+{
+  switch(transport)
+  {
+  case Transport::Inproc:
+    return "inproc";
+  case Transport::IPC:
+    return "ipc";
+  case Transport::TCP:
+    return "tcp";
+  }
+
+  return "unknown";
+}
+
+/// @brief Return an endpoint for binding, ipc and tcp use wildcards and the
+/// actual endpoint has to be queried after binding
+inline std::string GetBindPoint(Transport transport, const std::string &name)
+{
+  switch(transport)
+  {
+  case Transport::Inproc:
+    return "inproc://" + name;
+  case Transport::IPC:
+    return "ipc://*";
+  case Transport::TCP:
+    return "tcp://127.0.0.1:*";
+  }
+
+  return {};
+}
+
+inline std::string GetWaveTypeName(int type)
+{
+  switch(type)
+  {
+  case NT_FP64:
+    return "double";
+  case NT_FP32:
+    return "float";
+  case NT_I64:
+    return "int64";
+  case NT_I32:
+    return "int32";
+  case NT_I16:
+    return "int16";
+  case NT_I8 | NT_UNSIGNED:
+    return "uint8";
+  case TEXT_WAVE_TYPE:
+    return "text";
+  default:
+    return fmt::format("type {}", type);
+  }
+}
+
+/// @brief Make a free wave with a smooth, but not constant, content
+inline waveHndl MakeBenchWave(int type, CountInt numPoints)
+{
+  auto waveH = FakeIgor::MakeWave("bench", nullptr, {numPoints}, type);
+  ASSERT(waveH != nullptr);
+
+  std::vector<IndexInt> index(MAX_DIMENSIONS);
+
+  for(CountInt i = 0; i < numPoints; i++)
+  {
+    index[0]   = i;
+    auto value = 100.0 * std::sin(static_cast<double>(i) / 100.0);
+
+    if(type == TEXT_WAVE_TYPE)
+    {
+      SetWaveElement(waveH, index, fmt::format("{:.3f}", value));
+    }
+    else
+    {
+      SetWaveElement(waveH, index, value);
+    }
+  }
+
+  return waveH;
+}
+
+/// @brief Return a CallFunction request
+inline std::string MakeCallFunctionRequest(const std::string &name,
+                                           const json &params = json::array())
+{
+  json doc = {{"version", 1},
+              {"messageID", "bench"},
+              {"CallFunction", {{"name", name}, {"params", params}}}};
+
+  return doc.dump();
+}
+
+/// @brief Stop the benchmark on XOP function errors
+///
+/// @return true on success
+inline bool CheckXOPResult(benchmark::State &state, int rc)
+{
+  if(rc == 0)
+  {
+    return true;
+  }
+
+  state.SkipWithError(fmt::format("XOP function failed with {}", rc).c_str());
+
+  return false;
+}
+
+/// @brief Register the user functions called by the benchmarks
+///
+/// - `BenchLength(string str)`: returns the length of str
+/// - `BenchWave(variable numPoints)`: returns a free double wave
+void RegisterBenchFunctions();
+
+/// @brief Close all sockets and stop the message handler
+void ResetXOPState();
@@ -0,0 +1,70 @@
+#include "BenchHelpers.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+const char BENCH_LOGGING_PACKAGE[] = "ZeroMQ-XOP-Bench";
+
+/// Arguments: payload size in bytes
+void BM_LoggingJSON(benchmark::State &state)
+{
+  const auto size = static_cast<size_t>(state.range(0));
+
+  Logging logging(BENCH_LOGGING_PACKAGE);
+  const json doc = {{"version", 1},
+                    {"messageID", "bench"},
+                    {"data", std::string(size, 'a')}};
+
+  for(auto _ : state)
+  {
+    logging.AddLogEntry(doc, "identity", MessageDirection::Incoming);
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Arguments: payload size in bytes
+void BM_LoggingString(benchmark::State &state)
+{
+  const auto size = static_cast<size_t>(state.range(0));
+
+  Logging logging(BENCH_LOGGING_PACKAGE);
+  const std::string str(size, 'a');
+
+  for(auto _ : state)
+  {
+    logging.AddLogEntry(str, MessageDirection::Outgoing);
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Arguments: payload size in bytes
+///
+/// Logging through GlobalData as the XOP functions do it, which includes
+/// the lock.
+void BM_LoggingGlobalData(benchmark::State &state)
+{
+  const auto size = static_cast<size_t>(state.range(0));
+
+  GlobalData::Instance().SetLoggingFlag(true);
+  const std::string str(size, 'a');
+
+  for(auto _ : state)
+  {
+    GlobalData::Instance().AddLogEntry(str, MessageDirection::Outgoing);
+  }
+
+  GlobalData::Instance().SetLoggingFlag(false);
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_LoggingJSON)->Range(16, 1 << 16);
+BENCHMARK(BM_LoggingString)->Range(16, 1 << 16);
+BENCHMARK(BM_LoggingGlobalData)->Range(16, 1 << 16);
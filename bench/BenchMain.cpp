@@ -0,0 +1,65 @@
+#include "BenchHelpers.h"
+#include "MessageHandler.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+void RegisterBenchFunctions()
+{
+  FakeIgor::AddFunction(
+      "BenchLength", NT_FP64, {HSTRING_TYPE},
+      [](unsigned char *params, void *result) {
+        Handle h = nullptr;
+        memcpy(&h, params, sizeof(Handle));
+
+        const double length = h ? static_cast<double>(WMGetHandleSize(h)) : 0;
+        memcpy(result, &length, sizeof(double));
+
+        return 0;
+      });
+
+  FakeIgor::AddFunction("BenchWave", WAVE_TYPE, {NT_FP64},
+                        [](unsigned char *params, void *result) {
+                          double numPoints = 0;
+                          memcpy(&numPoints, params, sizeof(double));
+
+                          auto waveH = MakeBenchWave(
+                              NT_FP64, static_cast<CountInt>(numPoints));
+                          memcpy(result, &waveH, sizeof(waveHndl));
+
+                          return 0;
+                        });
+}
+
+void ResetXOPState()
+{
+  zeromq_stopParams p{};
+  zeromq_stop(&p);
+}
+
+int main(int argc, char **argv)
+{
+  // the benchmark thread is Igor's main thread, messages are handled during
+  // IDLE as in XOPEntry
+  FakeIgor::Reset();
+  FakeIgor::SetIdleHandler([]() {
+    MessageHandler::Instance().HandleAllQueuedMessages();
+    OutputQueuedNotices();
+  });
+
+  RegisterBenchFunctions();
+
+  benchmark::Initialize(&argc, argv);
+
+  if(benchmark::ReportUnrecognizedArguments(argc, argv))
+  {
+    return EXIT_FAILURE;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  ResetXOPState();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,195 @@
+#include "BenchHelpers.h"
+#include "RequestInterface.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+/// Arguments: number of parameters
+void BM_RequestInterfaceParse(benchmark::State &state)
+{
+  const auto numParams = state.range(0);
+
+  auto params = json::array();
+  for(int64_t i = 0; i < numParams; i++)
+  {
+    if(i % 2)
+    {
+      params.push_back(fmt::format("parameter {}", i));
+    }
+    else
+    {
+      params.push_back(static_cast<double>(i) * 1.5);
+    }
+  }
+
+  const auto payload = MakeCallFunctionRequest("BenchLength", params);
+
+  for(auto _ : state)
+  {
+    RequestInterface req(DEFAULT_SERVER_NAME, "identity", payload);
+    benchmark::DoNotOptimize(req);
+  }
+
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(payload.size()));
+}
+
+/// Arguments: approximate size of the request in bytes
+///
+/// The parameters are numbers and strings, as in typical requests sending
+/// acquired data to Igor.
+void BM_RequestInterfaceParseSize(benchmark::State &state)
+{
+  const auto size = static_cast<size_t>(state.range(0));
+
+  auto params = json::array();
+  for(int64_t i = 0; params.dump().size() < size; i++)
+  {
+    for(int64_t j = 0; j < 64; j++)
+    {
+      params.push_back(100.0 * std::sin(static_cast<double>(i * 64 + j)));
+    }
+
+    params.push_back(fmt::format("parameter {}", i));
+  }
+
+  const auto payload = MakeCallFunctionRequest("BenchLength", params);
+
+  for(auto _ : state)
+  {
+    RequestInterface req(DEFAULT_SERVER_NAME, "identity", payload);
+    benchmark::DoNotOptimize(req);
+  }
+
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(payload.size()));
+}
+
+/// Parse an invalid request, this includes throwing and catching the error
+void BM_RequestInterfaceParseInvalid(benchmark::State &state)
+{
+  const std::string payload = R"({"version" : 1, "CallFunction" : 1})";
+
+  for(auto _ : state)
+  {
+    try
+    {
+      RequestInterface req(DEFAULT_SERVER_NAME, "identity", payload);
+      benchmark::DoNotOptimize(req);
+    }
+    catch(const RequestInterfaceException &e)
+    {
+      benchmark::DoNotOptimize(e.GetErrorCode());
+    }
+  }
+}
+
+/// Arguments: number of points of the returned wave, zero for a numeric
+/// return value
+///
+/// The complete processing of a request in the main thread: parsing,
+/// checking, calling the function and creating the reply string.
+void BM_RequestInterfaceCall(benchmark::State &state)
+{
+  const auto numPoints = state.range(0);
+
+  const auto payload =
+      numPoints == 0
+          ? MakeCallFunctionRequest("BenchLength", json::array({"abcd"}))
+          : MakeCallFunctionRequest("BenchWave", json::array({numPoints}));
+
+  for(auto _ : state)
+  {
+    RequestInterface req(DEFAULT_SERVER_NAME, "identity", payload);
+    req.CanBeProcessed();
+    const auto reply = req.Call().dump();
+    benchmark::DoNotOptimize(reply.data());
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+/// Arguments: number of points of the wave
+///
+/// The native GetWave operation for a wave in root, to compare with
+/// BM_RequestInterfaceCall, which calls a function returning the wave.
+void BM_RequestInterfaceNativeGetWave(benchmark::State &state)
+{
+  const auto numPoints = state.range(0);
+
+  DataFolderHandle root = nullptr;
+  GetRootDataFolder(0, &root);
+
+  auto waveH = FakeIgor::MakeWave("benchNative", root, {numPoints}, NT_FP64);
+
+  std::vector<double> values(static_cast<size_t>(numPoints));
+  for(size_t i = 0; i < values.size(); i++)
+  {
+    values[i] = 100.0 * std::sin(static_cast<double>(i) / 100.0);
+  }
+
+  MDStoreDPDataInNumericWave(waveH, values.data());
+
+  const json doc = {{"version", 1},
+                    {"messageID", "bench"},
+                    {"GetWave", {{"path", "root:benchNative"}}}};
+  const auto payload = doc.dump();
+
+  for(auto _ : state)
+  {
+    RequestInterface req(DEFAULT_SERVER_NAME, "identity", payload);
+    req.CanBeProcessed();
+    const auto reply = req.Call().dump();
+    benchmark::DoNotOptimize(reply.data());
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_RequestInterfaceNativeSetWaveDataBinary(benchmark::State &state)
+{
+  const auto numPoints = state.range(0);
+
+  DataFolderHandle root = nullptr;
+  GetRootDataFolder(0, &root);
+
+  FakeIgor::MakeWave("benchUpload", root, {numPoints}, NT_FP64);
+
+  std::vector<double> values(static_cast<size_t>(numPoints));
+  for(size_t i = 0; i < values.size(); i++)
+  {
+    values[i] = 100.0 * std::sin(static_cast<double>(i) / 100.0);
+  }
+
+  const std::string binary(reinterpret_cast<const char *>(values.data()),
+                           values.size() * sizeof(double));
+
+  const json doc = {{"version", 1},
+                    {"messageID", "bench"},
+                    {"SetWaveData", {{"path", "root:benchUpload"}}}};
+  const auto payload = doc.dump();
+
+  for(auto _ : state)
+  {
+    RequestInterface req(DEFAULT_SERVER_NAME, "identity", payload, binary);
+    req.CanBeProcessed();
+    const auto reply = req.Call().dump();
+    benchmark::DoNotOptimize(reply.data());
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(binary.size()));
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_RequestInterfaceParse)->Arg(0)->Arg(1)->Arg(8)->Arg(64);
+BENCHMARK(BM_RequestInterfaceParseSize)->Arg(256)->Arg(100 * 1024);
+BENCHMARK(BM_RequestInterfaceParseInvalid);
+BENCHMARK(BM_RequestInterfaceCall)->Arg(0)->Range(16, 1 << 20);
+BENCHMARK(BM_RequestInterfaceNativeGetWave)->Range(16, 1 << 20);
+BENCHMARK(BM_RequestInterfaceNativeSetWaveDataBinary)->Range(16, 1 << 20);
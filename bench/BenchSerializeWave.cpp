@@ -0,0 +1,86 @@
+#include "BenchHelpers.h"
+#include "SerializeWave.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+const std::vector<int64_t> WAVE_TYPES = {
+    NT_FP64, NT_FP32, NT_I64, NT_I32, NT_I16, NT_I8 | NT_UNSIGNED,
+    TEXT_WAVE_TYPE};
+
+const std::vector<int64_t> WAVE_SIZES = benchmark::CreateRange(16, 1 << 20, 16);
+
+/// Arguments: wave type, number of points
+void BM_SerializeWave(benchmark::State &state)
+{
+  const auto type      = static_cast<int>(state.range(0));
+  const auto numPoints = static_cast<CountInt>(state.range(1));
+
+  auto waveH = MakeBenchWave(type, numPoints);
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(SerializeWave(waveH));
+  }
+
+  state.SetLabel(GetWaveTypeName(type));
+  state.SetItemsProcessed(state.iterations() * numPoints);
+
+  ReleaseWave(&waveH);
+}
+
+/// Arguments: wave type, number of points
+///
+/// Includes converting the JSON document to a string as done for the reply.
+void BM_SerializeWaveDump(benchmark::State &state)
+{
+  const auto type      = static_cast<int>(state.range(0));
+  const auto numPoints = static_cast<CountInt>(state.range(1));
+
+  auto waveH = MakeBenchWave(type, numPoints);
+  size_t numBytes = 0;
+
+  for(auto _ : state)
+  {
+    const auto str = SerializeWave(waveH).dump();
+    numBytes       = str.size();
+    benchmark::DoNotOptimize(str.data());
+  }
+
+  state.SetLabel(GetWaveTypeName(type));
+  state.SetItemsProcessed(state.iterations() * numPoints);
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(numBytes));
+
+  ReleaseWave(&waveH);
+}
+
+/// Arguments: number of points
+void BM_SerializeWaveDecimated(benchmark::State &state)
+{
+  const auto numPoints = static_cast<CountInt>(state.range(0));
+
+  auto waveH = MakeBenchWave(NT_FP64, numPoints);
+
+  WaveSerializationOptions options;
+  options.decimation = DecimationMethod::MinMax;
+  options.points     = 2000;
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(SerializeWave(waveH, options));
+  }
+
+  state.SetItemsProcessed(state.iterations() * numPoints);
+
+  ReleaseWave(&waveH);
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_SerializeWave)->ArgsProduct({WAVE_TYPES, WAVE_SIZES});
+BENCHMARK(BM_SerializeWaveDump)->ArgsProduct({WAVE_TYPES, WAVE_SIZES});
+BENCHMARK(BM_SerializeWaveDecimated)->Range(1 << 14, 1 << 22);
@@ -0,0 +1,406 @@
+#include "BenchHelpers.h"
+
+#include <atomic>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// Round trips over plain libzmq sockets as baseline, and through the XOP with
+/// the message handler, the IDLE processing in the main thread and calling a
+/// user function.
+
+namespace
+{
+
+const std::vector<int64_t> PAYLOAD_SIZES =
+    benchmark::CreateRange(16, 1 << 20, 64);
+
+void *GetRawContext()
+{
+  static void *context = zmq_ctx_new();
+  return context;
+}
+
+void *CreateRawSocket(int type)
+{
+  auto socket = zmq_socket(GetRawContext(), type);
+  ZEROMQ_ASSERT(socket != nullptr);
+
+  const int lingerTime = 0;
+  auto rc = zmq_setsockopt(socket, ZMQ_LINGER, &lingerTime, sizeof(lingerTime));
+  ZEROMQ_ASSERT(rc == 0);
+
+  return socket;
+}
+
+/// Receive all frames of a message, return false on timeout
+bool ReceiveMultipart(void *socket, std::vector<std::string> &frames)
+{
+  frames.clear();
+
+  zmq_msg_t msg;
+  zmq_msg_init(&msg);
+
+  do
+  {
+    if(zmq_msg_recv(&msg, socket, 0) < 0)
+    {
+      zmq_msg_close(&msg);
+      return false;
+    }
+
+    frames.push_back(CreateStringFromZMsg(&msg));
+  } while(zmq_msg_more(&msg));
+
+  zmq_msg_close(&msg);
+
+  return true;
+}
+
+void SendMultipart(void *socket, const std::vector<std::string> &frames)
+{
+  for(size_t i = 0; i < frames.size(); i++)
+  {
+    const auto flags = (i + 1 < frames.size()) ? ZMQ_SNDMORE : 0;
+    auto rc = zmq_send(socket, frames[i].data(), frames[i].size(), flags);
+    ZEROMQ_ASSERT(rc >= 0);
+  }
+}
+
+/// Arguments: transport, payload size
+void BM_RawRouterDealer(benchmark::State &state)
+{
+  const auto transport = static_cast<Transport>(state.range(0));
+  const auto size      = static_cast<size_t>(state.range(1));
+
+  auto router = CreateRawSocket(ZMQ_ROUTER);
+  auto rc     = zmq_bind(router, GetBindPoint(transport, "raw-router").c_str());
+  ZEROMQ_ASSERT(rc == 0);
+
+  const int timeout = 10;
+  rc = zmq_setsockopt(router, ZMQ_RCVTIMEO, &timeout, sizeof(timeout));
+  ZEROMQ_ASSERT(rc == 0);
+
+  std::atomic<bool> stop{false};
+
+  std::thread echo([&]() {
+    std::vector<std::string> frames;
+
+    while(!stop)
+    {
+      if(ReceiveMultipart(router, frames))
+      {
+        SendMultipart(router, frames);
+      }
+    }
+  });
+
+  auto dealer = CreateRawSocket(ZMQ_DEALER);
+  rc          = zmq_connect(dealer, GetLastEndPoint(router).c_str());
+  ZEROMQ_ASSERT(rc == 0);
+
+  const std::vector<std::string> request = {"", std::string(size, 'a')};
+  std::vector<std::string> reply;
+
+  for(auto _ : state)
+  {
+    SendMultipart(dealer, request);
+    ReceiveMultipart(dealer, reply);
+  }
+
+  stop = true;
+  echo.join();
+
+  zmq_close(dealer);
+  zmq_close(router);
+
+  state.SetLabel(GetTransportName(transport));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Arguments: transport, payload size
+void BM_RawPubSub(benchmark::State &state)
+{
+  const auto transport = static_cast<Transport>(state.range(0));
+  const auto size      = static_cast<size_t>(state.range(1));
+
+  auto pub = CreateRawSocket(ZMQ_PUB);
+  auto rc  = zmq_bind(pub, GetBindPoint(transport, "raw-pub").c_str());
+  ZEROMQ_ASSERT(rc == 0);
+
+  auto sub = CreateRawSocket(ZMQ_SUB);
+  rc       = zmq_setsockopt(sub, ZMQ_SUBSCRIBE, "", 0);
+  ZEROMQ_ASSERT(rc == 0);
+  rc = zmq_connect(sub, GetLastEndPoint(pub).c_str());
+  ZEROMQ_ASSERT(rc == 0);
+
+  const std::vector<std::string> message = {"bench", std::string(size, 'a')};
+  std::vector<std::string> received;
+
+  // wait until the subscription has arrived at the publisher
+  const int timeout = 10;
+  rc = zmq_setsockopt(sub, ZMQ_RCVTIMEO, &timeout, sizeof(timeout));
+  ZEROMQ_ASSERT(rc == 0);
+
+  do
+  {
+    SendMultipart(pub, message);
+  } while(!ReceiveMultipart(sub, received));
+
+  // drain the remaining warm-up messages
+  while(ReceiveMultipart(sub, received))
+  {
+  }
+
+  for(auto _ : state)
+  {
+    SendMultipart(pub, message);
+    ReceiveMultipart(sub, received);
+  }
+
+  zmq_close(sub);
+  zmq_close(pub);
+
+  state.SetLabel(GetTransportName(transport));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Arguments: transport, payload size
+///
+/// A CallFunction request from the XOP client to the XOP server, the reply is
+/// created during IDLE which is processed while waiting in
+/// zeromq_client_recv.
+///
+/// Uses a named server as the default server only accepts messages up to
+/// 1024 bytes.
+void BM_XOPRoundTrip(benchmark::State &state)
+{
+  const auto transport = static_cast<Transport>(state.range(0));
+  const auto size      = static_cast<size_t>(state.range(1));
+
+  ResetXOPState();
+
+  const std::string server = "bench";
+
+  zeromq_server_instance_createParams createParams{};
+  createParams.name           = GetHandleFromString(server);
+  createParams.maxMessageSize = -1;
+
+  zeromq_server_instance_bindParams bindParams{};
+  bindParams.name = GetHandleFromString(server);
+  bindParams.localPoint =
+      GetHandleFromString(GetBindPoint(transport, "xop-server"));
+
+  if(!CheckXOPResult(state, zeromq_server_instance_create(&createParams)) ||
+     !CheckXOPResult(state, zeromq_server_instance_bind(&bindParams)))
+  {
+    return;
+  }
+
+  const auto endpoint = GetLastEndPoint(
+      GlobalData::Instance().ZMQSocket(SocketTypes::Server, server));
+
+  zeromq_client_connectParams connectParams{};
+  connectParams.remotePoint = GetHandleFromString(endpoint);
+
+  zeromq_server_instance_startParams startParams{};
+  startParams.name = GetHandleFromString(server);
+
+  if(!CheckXOPResult(state, zeromq_client_connect(&connectParams)) ||
+     !CheckXOPResult(state, zeromq_server_instance_start(&startParams)))
+  {
+    return;
+  }
+
+  const auto request = MakeCallFunctionRequest(
+      "BenchLength", json::array({std::string(size, 'a')}));
+
+  for(auto _ : state)
+  {
+    zeromq_client_sendParams sendParams{};
+    sendParams.msg = GetHandleFromString(request);
+
+    zeromq_client_recvParams recvParams{};
+
+    if(!CheckXOPResult(state, zeromq_client_send(&sendParams)) ||
+       !CheckXOPResult(state, zeromq_client_recv(&recvParams)))
+    {
+      break;
+    }
+
+    WMDisposeHandle(recvParams.result);
+  }
+
+  ResetXOPState();
+
+  state.SetLabel(GetTransportName(transport));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Arguments: transport, payload size
+void BM_XOPPubSub(benchmark::State &state)
+{
+  const auto transport = static_cast<Transport>(state.range(0));
+  const auto size      = static_cast<size_t>(state.range(1));
+
+  ResetXOPState();
+
+  zeromq_pub_bindParams bindParams{};
+  bindParams.localPoint =
+      GetHandleFromString(GetBindPoint(transport, "xop-pub"));
+
+  if(!CheckXOPResult(state, zeromq_pub_bind(&bindParams)))
+  {
+    return;
+  }
+
+  const auto endpoint = GetLastEndPoint(
+      GlobalData::Instance().ZMQSocket(SocketTypes::Publisher));
+
+  zeromq_sub_connectParams connectParams{};
+  connectParams.remotePoint = GetHandleFromString(endpoint);
+
+  zeromq_sub_add_filterParams filterParams{};
+  filterParams.filter = GetHandleFromString("bench");
+
+  if(!CheckXOPResult(state, zeromq_sub_connect(&connectParams)) ||
+     !CheckXOPResult(state, zeromq_sub_add_filter(&filterParams)))
+  {
+    return;
+  }
+
+  const std::string payload(size, 'a');
+
+  auto PublishAndReceive = [&]() {
+    zeromq_pub_sendParams sendParams{};
+    sendParams.filter = GetHandleFromString("bench");
+    sendParams.msg    = GetHandleFromString(payload);
+
+    Handle filter = nullptr;
+    zeromq_sub_recvParams recvParams{};
+    recvParams.filter = &filter;
+
+    auto rc = zeromq_pub_send(&sendParams);
+
+    if(rc == 0)
+    {
+      rc = zeromq_sub_recv(&recvParams);
+    }
+
+    const auto received =
+        recvParams.result != nullptr && WMGetHandleSize(recvParams.result) > 0;
+
+    WMDisposeHandle(filter);
+    WMDisposeHandle(recvParams.result);
+
+    return std::make_pair(rc, received);
+  };
+
+  // wait until the subscription has arrived at the publisher
+  GlobalData::Instance().SetRecvBusyWaitingFlag(false);
+
+  for(;;)
+  {
+    const auto [rc, received] = PublishAndReceive();
+
+    if(!CheckXOPResult(state, rc))
+    {
+      GlobalData::Instance().SetRecvBusyWaitingFlag(true);
+      return;
+    }
+
+    if(received)
+    {
+      break;
+    }
+  }
+
+  GlobalData::Instance().SetRecvBusyWaitingFlag(true);
+
+  for(auto _ : state)
+  {
+    if(!CheckXOPResult(state, PublishAndReceive().first))
+    {
+      break;
+    }
+  }
+
+  ResetXOPState();
+
+  state.SetLabel(GetTransportName(transport));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Arguments: thread sockets, payload size
+///
+/// Publishing from several threads on the default channel, either sharing its
+/// socket or with one socket per thread. There is no subscriber, so libzmq
+/// drops the messages right away.
+void BM_XOPPublishThreads(benchmark::State &state)
+{
+  const auto threadSockets = state.range(0) != 0;
+  const auto size          = static_cast<size_t>(state.range(1));
+
+  // the loop starts for all threads after the setup of the first one
+  if(state.thread_index() == 0)
+  {
+    ResetXOPState();
+
+    zeromq_pub_bindParams bindParams{};
+    bindParams.localPoint =
+        GetHandleFromString(GetBindPoint(Transport::Inproc, "xop-pub-threads"));
+
+    zeromq_pub_set_thread_socketsParams threadSocketsParams{};
+    threadSocketsParams.channel = GetHandleFromString(DEFAULT_PUB_CHANNEL_NAME);
+    threadSocketsParams.enable  = threadSockets;
+
+    // no early return, the other threads wait for this one at the loop start
+    if(CheckXOPResult(state, zeromq_pub_bind(&bindParams)))
+    {
+      CheckXOPResult(state,
+                     zeromq_pub_set_thread_sockets(&threadSocketsParams));
+    }
+  }
+
+  const std::string payload(size, 'a');
+
+  for(auto _ : state)
+  {
+    zeromq_pub_sendParams sendParams{};
+    sendParams.filter = GetHandleFromString("bench");
+    sendParams.msg    = GetHandleFromString(payload);
+
+    if(!CheckXOPResult(state, zeromq_pub_send(&sendParams)))
+    {
+      break;
+    }
+  }
+
+  // all threads have finished their loop
+  if(state.thread_index() == 0)
+  {
+    ResetXOPState();
+  }
+
+  state.SetLabel(threadSockets ? "thread sockets" : "shared socket");
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_RawRouterDealer)
+    ->ArgsProduct({ALL_TRANSPORTS, PAYLOAD_SIZES})
+    ->UseRealTime();
+BENCHMARK(BM_RawPubSub)
+    ->ArgsProduct({ALL_TRANSPORTS, PAYLOAD_SIZES})
+    ->UseRealTime();
+BENCHMARK(BM_XOPRoundTrip)
+    ->ArgsProduct({ALL_TRANSPORTS, PAYLOAD_SIZES})
+    ->UseRealTime();
+BENCHMARK(BM_XOPPubSub)
+    ->ArgsProduct({ALL_TRANSPORTS, PAYLOAD_SIZES})
+    ->UseRealTime();
+BENCHMARK(BM_XOPPublishThreads)
+    ->ArgsProduct({{0, 1}, {1 << 10, 1 << 16}})
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
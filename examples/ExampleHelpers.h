@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <zmq.h>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// Helpers shared by the example programs
+
+#define ZEROMQ_ASSERT(A)                                                       \
+  if (!(A)) {                                                                  \
+    auto err = zmq_errno();                                                    \
+    fprintf(stderr,                                                            \
+            "The zmq library call in %s line %d file "                         \
+            "%s failed with errno=%d and msg=\"%s\"\r",                        \
+            __func__, __LINE__, __FILE__, err, zmq_strerror(err));             \
+    exit(1);                                                                   \
+  }
+
+// Print the usage text of the program and exit with an error
+inline void ExitWithUsage(const char *usage) {
+  std::cerr << usage;
+  exit(1);
+}
+
+// Split the arguments into `--name value` options and positional arguments
+//
+// `handleOption(name, value)` is called for every option and returns false
+// for unknown ones. Exceptions thrown by it, e.g. from std::stoi, are reported
+// as invalid values.
+template <typename Handler>
+bool ParseArguments(int argc, char **argv, std::vector<std::string> &positional,
+                    Handler handleOption) {
+  for (int i = 1; i < argc; i++) {
+    const std::string arg(argv[i]);
+
+    if (arg.compare(0, 2, "--") != 0) {
+      positional.push_back(arg);
+      continue;
+    }
+
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << arg << std::endl;
+      return false;
+    }
+
+    const std::string value(argv[++i]);
+
+    try {
+      if (!handleOption(arg, value)) {
+        std::cerr << "Unknown option " << arg << std::endl;
+        return false;
+      }
+    } catch (const std::exception &) {
+      std::cerr << "Invalid value " << value << " for " << arg << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Return the string value of the given key or an empty string
+inline std::string FindStringValue(const std::string &doc,
+                                   const std::string &key) {
+  auto pos = doc.find("\"" + key + "\"");
+
+  if (pos == std::string::npos) {
+    return {};
+  }
+
+  pos = doc.find('"', doc.find(':', pos) + 1);
+  const auto end = doc.find('"', pos + 1);
+
+  if (pos == std::string::npos || end == std::string::npos) {
+    return {};
+  }
+
+  return doc.substr(pos + 1, end - pos - 1);
+}
+
+inline void SendString(void *socket, const std::string &str, int flags) {
+  auto rc = zmq_send(socket, str.c_str(), str.size(), flags);
+  ZEROMQ_ASSERT(rc >= 0);
+}
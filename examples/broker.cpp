@@ -0,0 +1,647 @@
+#include "ExampleHelpers.h"
+#include "Errors.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <zmq.h>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// Broker for several Igor Pro instances running the ZeroMQ XOP
+//
+// Clients connect with DEALER or REQ sockets to the frontend ROUTER socket and
+// send the usual JSON requests. Every request is forwarded to the healthy
+// backend with the least outstanding requests. The XOP does not echo routing
+// frames and replies to invalid requests before queued ones, so the broker
+// uses one DEALER socket per client and backend and forwards everything
+// received on it to that client. Backends with a heartbeat endpoint are only
+// used while their `heartbeat` messages arrive.
+//
+// Streamed replies get a stream id unique for the broker, as every backend
+// numbers its streams on its own. Credit messages are translated back and
+// forwarded to the backend sending the stream, and only the last chunk of a
+// stream counts as reply.
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// connections without outstanding requests are closed after that time
+const std::chrono::seconds CONNECTION_IDLE_TIMEOUT(60);
+
+// credit messages are small, larger payloads are forwarded without looking at
+// them
+const size_t MAX_CREDIT_MESSAGE_SIZE = 256;
+
+struct Options {
+  std::string frontend;
+  std::vector<std::string> backends;
+  int heartbeatTimeout = 15000; // ms, three times the default interval
+};
+
+struct Backend {
+  std::string endpoint;
+  std::string heartbeatEndpoint;
+  void *heartbeat = nullptr; // SUB socket
+  Clock::time_point lastHeartbeat;
+  bool alive = false;
+  uint64_t outstanding = 0;
+  uint64_t forwarded = 0;
+};
+
+using ConnectionKey = std::pair<std::string, size_t>; // client, backend
+
+// DEALER socket of one client to one backend
+struct Connection {
+  void *socket = nullptr;
+  size_t backend = 0;
+  std::string identity; // of the client
+  uint64_t outstanding = 0;
+  Clock::time_point lastUsed;
+};
+
+// Streamed reply running on a connection
+struct Stream {
+  ConnectionKey connection;
+  uint64_t backendId = 0; // stream id of the backend
+};
+
+const char USAGE[] =
+    "Usage: zmq_xop_broker [options] <frontend> <backend>...\n"
+    "\n"
+    "<frontend> is the endpoint the clients connect to, each <backend>\n"
+    "is the server endpoint of an XOP and optionally its publisher\n"
+    "endpoint for the heartbeats, e.g. tcp://127.0.0.1:5670,\n"
+    "tcp://127.0.0.1:5770.\n"
+    "\n"
+    "Options:\n"
+    "  --heartbeat-timeout MS  backends without heartbeat for that long\n"
+    "                          are not used (default: 15000)\n";
+
+bool ParseOptions(int argc, char **argv, Options &opts) {
+  std::vector<std::string> positional;
+
+  const auto handleOption = [&opts](const std::string &arg,
+                                    const std::string &value) {
+    if (arg == "--heartbeat-timeout") {
+      opts.heartbeatTimeout = std::stoi(value);
+    } else {
+      return false;
+    }
+
+    return true;
+  };
+
+  if (!ParseArguments(argc, argv, positional, handleOption)) {
+    return false;
+  }
+
+  if (positional.size() < 2 || opts.heartbeatTimeout <= 0) {
+    return false;
+  }
+
+  opts.frontend = positional[0];
+  opts.backends.assign(positional.begin() + 1, positional.end());
+
+  return true;
+}
+
+std::string GetString(zmq_msg_t *msg) {
+  return std::string(static_cast<char *>(zmq_msg_data(msg)),
+                     zmq_msg_size(msg));
+}
+
+// Receive and drop the remaining frames of the current message
+void DiscardFrames(void *socket, zmq_msg_t *msg) {
+  while (zmq_msg_more(msg)) {
+    auto rc = zmq_msg_recv(msg, socket, 0);
+    ZEROMQ_ASSERT(rc >= 0);
+  }
+}
+
+// Forward the received frame and the remaining frames of the current message,
+// the frames are handed over to libzmq without copying
+void ForwardFrames(void *from, void *to, zmq_msg_t *msg) {
+  for (;;) {
+    // sending clears the message
+    const bool more = zmq_msg_more(msg);
+
+    auto rc = zmq_msg_send(msg, to, more ? ZMQ_SNDMORE : 0);
+    ZEROMQ_ASSERT(rc >= 0);
+
+    if (!more) {
+      return;
+    }
+
+    rc = zmq_msg_recv(msg, from, 0);
+    ZEROMQ_ASSERT(rc >= 0);
+  }
+}
+
+// Return the position of the value of the given key or npos
+//
+// Only keys followed by a colon are considered, so that string values equal to
+// the key are skipped.
+size_t FindValue(const std::string &doc, const std::string &key) {
+  const auto quotedKey = "\"" + key + "\"";
+
+  for (auto pos = doc.find(quotedKey); pos != std::string::npos;
+       pos = doc.find(quotedKey, pos + 1)) {
+    auto colon = doc.find_first_not_of(" \t\r\n", pos + quotedKey.size());
+
+    if (colon != std::string::npos && doc[colon] == ':') {
+      return doc.find_first_not_of(" \t\r\n", colon + 1);
+    }
+  }
+
+  return std::string::npos;
+}
+
+// Return the length of the unsigned number at the given position
+size_t GetNumberLength(const std::string &doc, size_t pos) {
+  if (pos == std::string::npos) {
+    return 0;
+  }
+
+  const auto end = doc.find_first_not_of("0123456789", pos);
+
+  return (end == std::string::npos ? doc.size() : end) - pos;
+}
+
+// Read the unsigned number value of the given key
+//
+// Returns false if there is none.
+bool GetNumberValue(const std::string &doc, const std::string &key,
+                    uint64_t &value) {
+  const auto pos = FindValue(doc, key);
+  const auto length = GetNumberLength(doc, pos);
+
+  if (length == 0 || length > 19) {
+    return false;
+  }
+
+  value = std::stoull(doc.substr(pos, length));
+
+  return true;
+}
+
+// Replace the unsigned number value of the given key
+void ReplaceNumberValue(std::string &doc, const std::string &key,
+                        uint64_t value) {
+  const auto pos = FindValue(doc, key);
+  doc.replace(pos, GetNumberLength(doc, pos), std::to_string(value));
+}
+
+// Return true if the value of the given key is `true`
+bool IsTrue(const std::string &doc, const std::string &key) {
+  const auto pos = FindValue(doc, key);
+
+  return pos != std::string::npos && doc.compare(pos, 4, "true") == 0;
+}
+
+void *CreateSocket(void *context, int type) {
+  auto socket = zmq_socket(context, type);
+  ZEROMQ_ASSERT(socket != nullptr);
+
+  int val = 0;
+  auto rc = zmq_setsockopt(socket, ZMQ_LINGER, &val, sizeof(val));
+  ZEROMQ_ASSERT(rc == 0);
+
+  return socket;
+}
+
+class Broker {
+public:
+  Broker(void *context, const Options &opts)
+      : m_context(context),
+        m_heartbeatTimeout(std::chrono::milliseconds(opts.heartbeatTimeout)) {
+    m_frontend = CreateSocket(context, ZMQ_ROUTER);
+
+    auto rc = zmq_bind(m_frontend, opts.frontend.c_str());
+    ZEROMQ_ASSERT(rc == 0);
+
+    for (const auto &arg : opts.backends) {
+      Backend backend;
+
+      const auto comma = arg.find(',');
+      backend.endpoint = arg.substr(0, comma);
+
+      if (comma != std::string::npos) {
+        backend.heartbeatEndpoint = arg.substr(comma + 1);
+        backend.heartbeat = CreateSocket(context, ZMQ_SUB);
+
+        rc = zmq_setsockopt(backend.heartbeat, ZMQ_SUBSCRIBE, "heartbeat", 9);
+        ZEROMQ_ASSERT(rc == 0);
+
+        rc = zmq_connect(backend.heartbeat, backend.heartbeatEndpoint.c_str());
+        ZEROMQ_ASSERT(rc == 0);
+      } else {
+        // without heartbeats the backend is always used
+        backend.alive = true;
+      }
+
+      m_backends.push_back(backend);
+    }
+
+    rc = zmq_msg_init(&m_msg);
+    ZEROMQ_ASSERT(rc == 0);
+  }
+
+  ~Broker() {
+    for (auto &entry : m_connections) {
+      zmq_close(entry.second.socket);
+    }
+
+    for (auto &backend : m_backends) {
+      if (backend.heartbeat) {
+        zmq_close(backend.heartbeat);
+      }
+    }
+
+    zmq_close(m_frontend);
+    zmq_msg_close(&m_msg);
+  }
+
+  Broker(const Broker &) = delete;
+  Broker &operator=(const Broker &) = delete;
+
+  void Run() {
+    std::vector<zmq_pollitem_t> items;
+    std::vector<Connection *> itemConnections;
+
+    for (;;) {
+      items.clear();
+      itemConnections.clear();
+
+      items.push_back({m_frontend, 0, ZMQ_POLLIN, 0});
+
+      for (auto &backend : m_backends) {
+        if (backend.heartbeat) {
+          items.push_back({backend.heartbeat, 0, ZMQ_POLLIN, 0});
+        }
+      }
+
+      const auto firstConnection = items.size();
+
+      for (auto &entry : m_connections) {
+        items.push_back({entry.second.socket, 0, ZMQ_POLLIN, 0});
+        itemConnections.push_back(&entry.second);
+      }
+
+      auto rc = zmq_poll(items.data(), static_cast<int>(items.size()), 100);
+      ZEROMQ_ASSERT(rc >= 0);
+
+      for (auto &backend : m_backends) {
+        ReceiveHeartbeats(backend);
+      }
+
+      for (size_t i = firstConnection; i < items.size(); i++) {
+        if (items[i].revents & ZMQ_POLLIN) {
+          ForwardReplies(*itemConnections[i - firstConnection]);
+        }
+      }
+
+      UpdateHealth();
+      CloseIdleConnections();
+
+      if (items[0].revents & ZMQ_POLLIN) {
+        ForwardRequests();
+      }
+    }
+  }
+
+private:
+  void ReceiveHeartbeats(Backend &backend) {
+    if (!backend.heartbeat) {
+      return;
+    }
+
+    while (zmq_msg_recv(&m_msg, backend.heartbeat, ZMQ_DONTWAIT) >= 0) {
+      DiscardFrames(backend.heartbeat, &m_msg);
+      backend.lastHeartbeat = Clock::now();
+    }
+  }
+
+  void UpdateHealth() {
+    const auto now = Clock::now();
+
+    for (auto &backend : m_backends) {
+      if (!backend.heartbeat) {
+        continue;
+      }
+
+      const bool alive = backend.lastHeartbeat != Clock::time_point() &&
+                         now - backend.lastHeartbeat < m_heartbeatTimeout;
+
+      if (alive == backend.alive) {
+        continue;
+      }
+
+      backend.alive = alive;
+      std::cerr << "Backend " << backend.endpoint << " is "
+                << (alive ? "up" : "down") << std::endl;
+
+      // replies of a dead backend are not expected anymore
+      if (!alive) {
+        backend.outstanding = 0;
+      }
+    }
+  }
+
+  void CloseIdleConnections() {
+    const auto now = Clock::now();
+
+    for (auto it = m_connections.begin(); it != m_connections.end();) {
+      auto &conn = it->second;
+
+      if (conn.outstanding == 0 &&
+          now - conn.lastUsed > CONNECTION_IDLE_TIMEOUT) {
+        zmq_close(conn.socket);
+        it = m_connections.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  // Return the alive backend with the least outstanding requests, -1 if there
+  // is none. Ties are broken round robin.
+  int SelectBackend() {
+    int selected = -1;
+    const auto numBackends = m_backends.size();
+
+    for (size_t i = 0; i < numBackends; i++) {
+      const auto index = (m_next + i) % numBackends;
+      const auto &backend = m_backends[index];
+
+      if (!backend.alive) {
+        continue;
+      }
+
+      if (selected < 0 ||
+          backend.outstanding < m_backends[selected].outstanding) {
+        selected = static_cast<int>(index);
+      }
+    }
+
+    m_next = (m_next + 1) % numBackends;
+
+    return selected;
+  }
+
+  Connection &GetConnection(const std::string &identity, size_t backend) {
+    const auto key = ConnectionKey(identity, backend);
+    auto it = m_connections.find(key);
+
+    if (it != m_connections.end()) {
+      return it->second;
+    }
+
+    Connection conn;
+    conn.socket = CreateSocket(m_context, ZMQ_DEALER);
+    conn.backend = backend;
+    conn.identity = identity;
+
+    // the XOP logs the identity of the caller
+    const auto dealerIdentity = "broker for xop: " + identity;
+    auto rc = zmq_setsockopt(conn.socket, ZMQ_IDENTITY, dealerIdentity.c_str(),
+                             std::min<size_t>(dealerIdentity.size(), 255));
+    ZEROMQ_ASSERT(rc == 0);
+
+    rc = zmq_connect(conn.socket, m_backends[backend].endpoint.c_str());
+    ZEROMQ_ASSERT(rc == 0);
+
+    return m_connections.emplace(key, conn).first->second;
+  }
+
+  // Expected frames: identity, empty, payload and optional binary frames
+  void ForwardRequests() {
+    while (zmq_msg_recv(&m_msg, m_frontend, ZMQ_DONTWAIT) >= 0) {
+      const std::string identity(static_cast<char *>(zmq_msg_data(&m_msg)),
+                                 zmq_msg_size(&m_msg));
+
+      if (!zmq_msg_more(&m_msg)) {
+        continue;
+      }
+
+      auto rc = zmq_msg_recv(&m_msg, m_frontend, 0);
+      ZEROMQ_ASSERT(rc >= 0);
+
+      if (zmq_msg_size(&m_msg) != 0 || !zmq_msg_more(&m_msg)) {
+        // the XOP would not reply to it
+        DiscardFrames(m_frontend, &m_msg);
+        continue;
+      }
+
+      // payload
+      rc = zmq_msg_recv(&m_msg, m_frontend, 0);
+      ZEROMQ_ASSERT(rc >= 0);
+
+      if (zmq_msg_size(&m_msg) <= MAX_CREDIT_MESSAGE_SIZE &&
+          ForwardCredit(identity)) {
+        continue;
+      }
+
+      const auto selected = SelectBackend();
+
+      if (selected < 0) {
+        ReplyNoBackend(identity);
+        continue;
+      }
+
+      auto &backend = m_backends[selected];
+      auto &conn = GetConnection(identity, static_cast<size_t>(selected));
+
+      SendString(conn.socket, "", ZMQ_SNDMORE);
+      ForwardFrames(m_frontend, conn.socket, &m_msg);
+
+      backend.outstanding++;
+      backend.forwarded++;
+      conn.outstanding++;
+      conn.lastUsed = Clock::now();
+    }
+  }
+
+  // Forward the received payload to the connection sending the stream if it
+  // is a credit message, it is not counted as request as no reply is sent for
+  // it
+  //
+  // Returns false for other messages and credit messages without stream id,
+  // the latter are forwarded as request and the XOP replies with an error.
+  bool ForwardCredit(const std::string &identity) {
+    auto payload = GetString(&m_msg);
+    uint64_t id = 0;
+
+    if (FindValue(payload, "credit") == std::string::npos ||
+        !GetNumberValue(payload, "id", id)) {
+      return false;
+    }
+
+    DiscardFrames(m_frontend, &m_msg);
+
+    auto it = m_streams.find(id);
+
+    if (it == m_streams.end() || it->second.connection.first != identity) {
+      // the stream has already finished or was aborted
+      return true;
+    }
+
+    auto connIt = m_connections.find(it->second.connection);
+
+    if (connIt == m_connections.end()) {
+      return true;
+    }
+
+    ReplaceNumberValue(payload, "id", it->second.backendId);
+
+    auto &conn = connIt->second;
+    SendString(conn.socket, "", ZMQ_SNDMORE);
+    SendString(conn.socket, payload, 0);
+
+    conn.lastUsed = Clock::now();
+
+    return true;
+  }
+
+  // Translate the stream id of the header of a streamed reply chunk
+  //
+  // Returns true for the last chunk of the stream.
+  bool TranslateStreamHeader(const ConnectionKey &key, std::string &header) {
+    uint64_t backendId = 0;
+
+    if (!GetNumberValue(header, "id", backendId)) {
+      return true;
+    }
+
+    const auto last = IsTrue(header, "last");
+    const auto streamKey = std::make_pair(key, backendId);
+
+    auto it = m_streamIds.find(streamKey);
+
+    if (it == m_streamIds.end()) {
+      it = m_streamIds.emplace(streamKey, ++m_lastStreamId).first;
+      m_streams[it->second] = {key, backendId};
+    }
+
+    const auto id = it->second;
+    ReplaceNumberValue(header, "id", id);
+
+    if (last) {
+      m_streams.erase(id);
+      m_streamIds.erase(it);
+    }
+
+    return last;
+  }
+
+  void ReplyNoBackend(const std::string &identity) {
+    const auto payload = GetString(&m_msg);
+    DiscardFrames(m_frontend, &m_msg);
+
+    std::string reply = "{\"errorCode\":{\"value\":" +
+                        std::to_string(REQ_NO_BACKEND) +
+                        ",\"msg\":\"Broker: No backend available.\"}";
+
+    const auto messageId = FindStringValue(payload, "messageID");
+
+    if (!messageId.empty()) {
+      reply += ",\"messageID\":\"" + messageId + "\"";
+    }
+
+    reply += "}";
+
+    SendString(m_frontend, identity, ZMQ_SNDMORE);
+    SendString(m_frontend, "", ZMQ_SNDMORE);
+    SendString(m_frontend, reply, 0);
+  }
+
+  // Expected frames: empty and payload, or empty, header and payload for
+  // streamed replies
+  void ForwardReplies(Connection &conn) {
+    auto &backend = m_backends[conn.backend];
+    const auto key = ConnectionKey(conn.identity, conn.backend);
+
+    while (zmq_msg_recv(&m_msg, conn.socket, ZMQ_DONTWAIT) >= 0) {
+      if (zmq_msg_size(&m_msg) != 0 || !zmq_msg_more(&m_msg)) {
+        // not sent by the XOP
+        DiscardFrames(conn.socket, &m_msg);
+        continue;
+      }
+
+      SendString(m_frontend, conn.identity, ZMQ_SNDMORE);
+      SendString(m_frontend, "", ZMQ_SNDMORE);
+
+      auto rc = zmq_msg_recv(&m_msg, conn.socket, 0);
+      ZEROMQ_ASSERT(rc >= 0);
+
+      bool complete = true;
+
+      if (zmq_msg_more(&m_msg)) {
+        auto header = GetString(&m_msg);
+        complete = TranslateStreamHeader(key, header);
+        SendString(m_frontend, header, ZMQ_SNDMORE);
+
+        rc = zmq_msg_recv(&m_msg, conn.socket, 0);
+        ZEROMQ_ASSERT(rc >= 0);
+      }
+
+      ForwardFrames(conn.socket, m_frontend, &m_msg);
+
+      conn.lastUsed = Clock::now();
+
+      if (!complete) {
+        continue;
+      }
+
+      if (backend.outstanding > 0) {
+        backend.outstanding--;
+      }
+
+      if (conn.outstanding > 0) {
+        conn.outstanding--;
+      }
+    }
+  }
+
+  void *m_context;
+  void *m_frontend = nullptr;
+  Clock::duration m_heartbeatTimeout;
+  std::vector<Backend> m_backends;
+  std::map<ConnectionKey, Connection> m_connections;
+  std::map<uint64_t, Stream> m_streams; // by broker stream id
+  std::map<std::pair<ConnectionKey, uint64_t>, uint64_t> m_streamIds;
+  uint64_t m_lastStreamId = 0;
+  size_t m_next = 0;
+  zmq_msg_t m_msg;
+};
+
+} // anonymous namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+
+  if (!ParseOptions(argc, argv, opts)) {
+    ExitWithUsage(USAGE);
+  }
+
+  auto zmq_context = zmq_ctx_new();
+  ZEROMQ_ASSERT(zmq_context != nullptr);
+
+  {
+    Broker broker(zmq_context, opts);
+    broker.Run();
+  }
+
+  auto rc = zmq_ctx_term(zmq_context);
+  ZEROMQ_ASSERT(rc == 0);
+
+  return 0;
+}
@@ -1,3 +1,6 @@
+#include "ExampleHelpers.h"
+
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <zmq.h>
@@ -5,16 +8,6 @@
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
 
-#define ZEROMQ_ASSERT(A)                                                       \
-  if (!(A)) {                                                                  \
-    auto err = zmq_errno();                                                    \
-    fprintf(stderr,                                                            \
-            "The zmq library call in %s line %d file "                         \
-            "%s failed with errno=%d and msg=\"%s\"\r",                        \
-            __func__, __LINE__, __FILE__, err, zmq_strerror(err));             \
-    exit(1);                                                                   \
-  }
-
 int main(int argc, char **argv) {
   if (argc < 3) {
     std::cerr << "Expected exactly two arguments." << std::endl;
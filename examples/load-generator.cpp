@@ -0,0 +1,582 @@
+#include "ExampleHelpers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zmq.h>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// Load generator for the ZeroMQ XOP server
+//
+// Every client has its own DEALER socket and thread. Requests are created from
+// a template and matched with their replies by the messageID. With a fixed
+// rate the latency is measured from the scheduled send time, so that a slow
+// server is not hidden by sending less requests (coordinated omission).
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Options {
+  std::string remotePoint;
+  std::string messageTemplate;
+  int clients = 1;
+  double rate = 0; // requests per second of all clients, 0 is closed loop
+  double duration = 10;
+  double warmup = 1;
+  int timeout = 5000; // ms
+  unsigned int seed = 0;
+  std::string format = "csv";
+  std::string output;
+};
+
+const char USAGE[] =
+    "Usage: zmq_xop_loadgen [options] <remote point> <template>\n"
+    "\n"
+    "Options:\n"
+    "  --clients N    number of concurrent DEALER sockets (default: 1)\n"
+    "  --rate R       total requests per second, 0 sends the next\n"
+    "                 request after the reply (default: 0)\n"
+    "  --duration S   measurement duration in seconds (default: 10)\n"
+    "  --warmup S     warm-up duration in seconds (default: 1)\n"
+    "  --timeout MS   reply timeout in milliseconds (default: 5000)\n"
+    "  --seed N       seed for the template randomization\n"
+    "  --format F     csv or json (default: csv)\n"
+    "  --output FILE  write the results to FILE instead of stdout\n"
+    "\n"
+    "Template placeholders:\n"
+    "  {{int:MIN:MAX}}     uniformly distributed integer\n"
+    "  {{double:MIN:MAX}}  uniformly distributed number\n"
+    "  {{string:LEN}}      random alphanumeric string\n"
+    "  {{choice:A|B|C}}    one of the given values\n"
+    "  {{seq}}             request number of the client\n"
+    "  {{client}}          client number\n"
+    "\n"
+    "The template must not contain a messageID, it is added for\n"
+    "matching replies.\n";
+
+bool ParseOptions(int argc, char **argv, Options &opts) {
+  std::vector<std::string> positional;
+
+  const auto handleOption = [&opts](const std::string &arg,
+                                    const std::string &value) {
+    if (arg == "--clients") {
+      opts.clients = std::stoi(value);
+    } else if (arg == "--rate") {
+      opts.rate = std::stod(value);
+    } else if (arg == "--duration") {
+      opts.duration = std::stod(value);
+    } else if (arg == "--warmup") {
+      opts.warmup = std::stod(value);
+    } else if (arg == "--timeout") {
+      opts.timeout = std::stoi(value);
+    } else if (arg == "--seed") {
+      opts.seed = static_cast<unsigned int>(std::stoul(value));
+    } else if (arg == "--format") {
+      opts.format = value;
+    } else if (arg == "--output") {
+      opts.output = value;
+    } else {
+      return false;
+    }
+
+    return true;
+  };
+
+  if (!ParseArguments(argc, argv, positional, handleOption)) {
+    return false;
+  }
+
+  if (positional.size() != 2) {
+    return false;
+  }
+
+  opts.remotePoint = positional[0];
+  opts.messageTemplate = positional[1];
+
+  if (opts.clients < 1 || opts.rate < 0 || opts.duration <= 0 ||
+      opts.warmup < 0 || opts.timeout <= 0 ||
+      (opts.format != "csv" && opts.format != "json")) {
+    std::cerr << "Invalid option values." << std::endl;
+    return false;
+  }
+
+  if (opts.messageTemplate.find("\"messageID\"") != std::string::npos) {
+    std::cerr << "The template must not contain a messageID." << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+// Message template split into literal text and placeholders
+class MessageTemplate {
+public:
+  explicit MessageTemplate(const std::string &str) {
+    size_t pos = 0;
+
+    for (;;) {
+      auto start = str.find("{{", pos);
+
+      if (start == std::string::npos) {
+        m_segments.push_back({Kind::Literal, str.substr(pos), {}});
+        break;
+      }
+
+      auto end = str.find("}}", start);
+
+      if (end == std::string::npos) {
+        throw std::runtime_error("Unterminated placeholder in template");
+      }
+
+      m_segments.push_back({Kind::Literal, str.substr(pos, start - pos), {}});
+      m_segments.push_back(ParsePlaceholder(str.substr(start + 2,
+                                                       end - start - 2)));
+      pos = end + 2;
+    }
+
+    // add the messageID after the opening brace
+    auto &first = m_segments.front().text;
+    auto brace = first.find('{');
+
+    if (brace == std::string::npos) {
+      throw std::runtime_error("The template must start with a JSON object");
+    }
+
+    m_prefix = first.substr(0, brace + 1);
+    first.erase(0, brace + 1);
+  }
+
+  std::string Render(const std::string &messageId, int client, uint64_t seq,
+                     std::mt19937_64 &rng) const {
+    std::string result = m_prefix + "\"messageID\":\"" + messageId + "\",";
+
+    for (const auto &segment : m_segments) {
+      switch (segment.kind) {
+      case Kind::Literal:
+        result += segment.text;
+        break;
+      case Kind::Int: {
+        std::uniform_int_distribution<long long> dist(
+            std::stoll(segment.args[0]), std::stoll(segment.args[1]));
+        result += std::to_string(dist(rng));
+        break;
+      }
+      case Kind::Double: {
+        std::uniform_real_distribution<double> dist(
+            std::stod(segment.args[0]), std::stod(segment.args[1]));
+        std::ostringstream ss;
+        ss.precision(17);
+        ss << dist(rng);
+        result += ss.str();
+        break;
+      }
+      case Kind::String: {
+        static const char chars[] = "abcdefghijklmnopqrstuvwxyz"
+                                    "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+        std::uniform_int_distribution<size_t> dist(0, sizeof(chars) - 2);
+        const auto length = std::stoul(segment.args[0]);
+
+        for (size_t i = 0; i < length; i++) {
+          result += chars[dist(rng)];
+        }
+        break;
+      }
+      case Kind::Choice: {
+        std::uniform_int_distribution<size_t> dist(0, segment.args.size() - 1);
+        result += segment.args[dist(rng)];
+        break;
+      }
+      case Kind::Seq:
+        result += std::to_string(seq);
+        break;
+      case Kind::Client:
+        result += std::to_string(client);
+        break;
+      }
+    }
+
+    return result;
+  }
+
+private:
+  enum class Kind { Literal, Int, Double, String, Choice, Seq, Client };
+
+  struct Segment {
+    Kind kind;
+    std::string text;
+    std::vector<std::string> args;
+  };
+
+  static std::vector<std::string> Split(const std::string &str, char sep) {
+    std::vector<std::string> result;
+    std::stringstream ss(str);
+    std::string elem;
+
+    while (std::getline(ss, elem, sep)) {
+      result.push_back(elem);
+    }
+
+    return result;
+  }
+
+  static Segment ParsePlaceholder(const std::string &str) {
+    const auto colon = str.find(':');
+    const auto name = str.substr(0, colon);
+    const auto rest =
+        colon == std::string::npos ? std::string() : str.substr(colon + 1);
+
+    Segment segment{Kind::Literal, {}, {}};
+
+    if (name == "int" || name == "double") {
+      segment.kind = name == "int" ? Kind::Int : Kind::Double;
+      segment.args = Split(rest, ':');
+
+      if (segment.args.size() != 2) {
+        throw std::runtime_error("Expected {{" + name + ":MIN:MAX}}");
+      }
+    } else if (name == "string") {
+      segment.kind = Kind::String;
+      segment.args = {rest};
+    } else if (name == "choice") {
+      segment.kind = Kind::Choice;
+      segment.args = Split(rest, '|');
+
+      if (segment.args.empty()) {
+        throw std::runtime_error("Expected {{choice:A|B}}");
+      }
+    } else if (name == "seq") {
+      segment.kind = Kind::Seq;
+    } else if (name == "client") {
+      segment.kind = Kind::Client;
+    } else {
+      throw std::runtime_error("Unknown placeholder {{" + str + "}}");
+    }
+
+    return segment;
+  }
+
+  std::string m_prefix;
+  std::vector<Segment> m_segments;
+};
+
+struct ClientResult {
+  std::vector<int64_t> latencies; // ns
+  uint64_t sent = 0;
+  uint64_t errors = 0;
+  uint64_t timeouts = 0;
+};
+
+// Return true if the reply has a non-zero errorCode value
+bool HasError(const std::string &reply) {
+  auto pos = reply.find("\"errorCode\"");
+
+  if (pos == std::string::npos) {
+    return true;
+  }
+
+  pos = reply.find("\"value\"", pos);
+
+  if (pos == std::string::npos) {
+    return true;
+  }
+
+  pos = reply.find(':', pos);
+  return pos == std::string::npos || std::atoi(reply.c_str() + pos + 1) != 0;
+}
+
+void *CreateSocket(void *context, const Options &opts, int client) {
+  auto socket = zmq_socket(context, ZMQ_DEALER);
+  ZEROMQ_ASSERT(socket != nullptr);
+
+  int val = 0;
+  auto rc = zmq_setsockopt(socket, ZMQ_LINGER, &val, sizeof(val));
+  ZEROMQ_ASSERT(rc == 0);
+
+  const auto identity = "load generator for xop: dealer " +
+                        std::to_string(client);
+  rc = zmq_setsockopt(socket, ZMQ_IDENTITY, identity.c_str(),
+                      identity.size());
+  ZEROMQ_ASSERT(rc == 0);
+
+  rc = zmq_connect(socket, opts.remotePoint.c_str());
+  ZEROMQ_ASSERT(rc == 0);
+
+  return socket;
+}
+
+void RunClient(void *context, const Options &opts,
+               const MessageTemplate &messageTemplate, int client,
+               Clock::time_point start, ClientResult &result) {
+  auto socket = CreateSocket(context, opts, client);
+
+  std::mt19937_64 rng(opts.seed + static_cast<unsigned int>(client));
+
+  const auto measureStart =
+      start + std::chrono::duration_cast<Clock::duration>(
+                  std::chrono::duration<double>(opts.warmup));
+  const auto end = measureStart +
+                   std::chrono::duration_cast<Clock::duration>(
+                       std::chrono::duration<double>(opts.duration));
+  const auto timeout = std::chrono::milliseconds(opts.timeout);
+
+  const bool closedLoop = opts.rate == 0;
+  const auto interval =
+      closedLoop ? Clock::duration::zero()
+                 : std::chrono::duration_cast<Clock::duration>(
+                       std::chrono::duration<double>(opts.clients / opts.rate));
+
+  // scheduled send time of all requests without reply
+  std::map<std::string, Clock::time_point> pending;
+
+  auto next = start;
+  uint64_t seq = 0;
+
+  zmq_msg_t msg;
+  int rc = zmq_msg_init(&msg);
+  ZEROMQ_ASSERT(rc == 0);
+
+  for (;;) {
+    auto now = Clock::now();
+    const bool sending = now < end;
+
+    if (!sending && pending.empty()) {
+      break;
+    }
+
+    // send
+    if (sending && (closedLoop ? pending.empty() : now >= next)) {
+      if (closedLoop) {
+        next = now;
+      }
+
+      const auto messageId =
+          std::to_string(client) + "-" + std::to_string(seq);
+      const auto payload = messageTemplate.Render(messageId, client, seq, rng);
+
+      rc = zmq_send(socket, NULL, 0, ZMQ_SNDMORE);
+      ZEROMQ_ASSERT(rc == 0);
+      rc = zmq_send(socket, payload.c_str(), payload.size(), 0);
+      ZEROMQ_ASSERT(rc >= 0);
+
+      pending[messageId] = next;
+      seq++;
+
+      if (next >= measureStart) {
+        result.sent++;
+      }
+
+      next += interval;
+      continue;
+    }
+
+    // receive until the next send is due
+    using std::chrono::milliseconds;
+    auto wait = milliseconds(10);
+
+    if (sending && !closedLoop) {
+      const auto untilNext =
+          std::chrono::duration_cast<milliseconds>(next - now);
+      wait = std::min(wait, untilNext);
+    }
+
+    zmq_pollitem_t item = {socket, 0, ZMQ_POLLIN, 0};
+    rc = zmq_poll(&item, 1, static_cast<long>(wait.count()));
+    ZEROMQ_ASSERT(rc >= 0);
+
+    while (zmq_msg_recv(&msg, socket, ZMQ_DONTWAIT) >= 0) {
+      // empty frame
+      ZEROMQ_ASSERT(zmq_msg_more(&msg));
+
+      rc = zmq_msg_recv(&msg, socket, 0);
+      ZEROMQ_ASSERT(rc >= 0);
+
+      const std::string reply(static_cast<char *>(zmq_msg_data(&msg)),
+                              zmq_msg_size(&msg));
+      const auto received = Clock::now();
+
+      auto it = pending.find(FindStringValue(reply, "messageID"));
+
+      if (it == pending.end()) {
+        // reply to a timed out request
+        continue;
+      }
+
+      if (it->second >= measureStart) {
+        result.latencies.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(received -
+                                                                 it->second)
+                .count());
+
+        if (HasError(reply)) {
+          result.errors++;
+        }
+      }
+
+      pending.erase(it);
+    }
+
+    now = Clock::now();
+
+    for (auto it = pending.begin(); it != pending.end();) {
+      if (now - it->second > timeout) {
+        if (it->second >= measureStart) {
+          result.timeouts++;
+        }
+        it = pending.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  rc = zmq_msg_close(&msg);
+  ZEROMQ_ASSERT(rc == 0);
+
+  rc = zmq_close(socket);
+  ZEROMQ_ASSERT(rc == 0);
+}
+
+double GetPercentile(const std::vector<int64_t> &sorted, double percentile) {
+  if (sorted.empty()) {
+    return 0;
+  }
+
+  const auto index = static_cast<size_t>(
+      std::ceil(percentile / 100.0 * static_cast<double>(sorted.size())));
+
+  return static_cast<double>(sorted[std::max<size_t>(index, 1) - 1]) / 1000.0;
+}
+
+void WriteResults(std::ostream &out, const Options &opts,
+                  const std::vector<ClientResult> &results) {
+  std::vector<int64_t> latencies;
+  uint64_t sent = 0, errors = 0, timeouts = 0;
+
+  for (const auto &result : results) {
+    latencies.insert(latencies.end(), result.latencies.begin(),
+                     result.latencies.end());
+    sent += result.sent;
+    errors += result.errors;
+    timeouts += result.timeouts;
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+
+  double mean = 0;
+
+  for (auto latency : latencies) {
+    mean += static_cast<double>(latency);
+  }
+
+  mean = latencies.empty() ? 0 : mean / latencies.size() / 1000.0;
+
+  const std::vector<std::pair<std::string, std::string>> values = {
+      {"mode", opts.rate == 0 ? "closed" : "fixed"},
+      {"clients", std::to_string(opts.clients)},
+      {"target_rate", std::to_string(opts.rate)},
+      {"duration_s", std::to_string(opts.duration)},
+      {"sent", std::to_string(sent)},
+      {"replies", std::to_string(latencies.size())},
+      {"errors", std::to_string(errors)},
+      {"timeouts", std::to_string(timeouts)},
+      {"throughput_rps",
+       std::to_string(static_cast<double>(latencies.size()) / opts.duration)},
+      {"latency_min_us",
+       std::to_string(latencies.empty() ? 0 : latencies.front() / 1000.0)},
+      {"latency_mean_us", std::to_string(mean)},
+      {"latency_p50_us", std::to_string(GetPercentile(latencies, 50))},
+      {"latency_p90_us", std::to_string(GetPercentile(latencies, 90))},
+      {"latency_p99_us", std::to_string(GetPercentile(latencies, 99))},
+      {"latency_p999_us", std::to_string(GetPercentile(latencies, 99.9))},
+      {"latency_max_us",
+       std::to_string(latencies.empty() ? 0 : latencies.back() / 1000.0)}};
+
+  if (opts.format == "csv") {
+    for (size_t i = 0; i < values.size(); i++) {
+      out << (i ? "," : "") << values[i].first;
+    }
+
+    out << "\n";
+
+    for (size_t i = 0; i < values.size(); i++) {
+      out << (i ? "," : "") << values[i].second;
+    }
+
+    out << "\n";
+    return;
+  }
+
+  out << "{\n";
+
+  for (size_t i = 0; i < values.size(); i++) {
+    const auto quote = i == 0 ? "\"" : "";
+    out << "  \"" << values[i].first << "\": " << quote << values[i].second
+        << quote << (i + 1 < values.size() ? ",\n" : "\n");
+  }
+
+  out << "}\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+
+  if (!ParseOptions(argc, argv, opts)) {
+    ExitWithUsage(USAGE);
+  }
+
+  std::unique_ptr<MessageTemplate> messageTemplate;
+
+  try {
+    messageTemplate.reset(new MessageTemplate(opts.messageTemplate));
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    exit(1);
+  }
+
+  auto zmq_context = zmq_ctx_new();
+  ZEROMQ_ASSERT(zmq_context != nullptr);
+
+  std::vector<ClientResult> results(opts.clients);
+  std::vector<std::thread> threads;
+
+  const auto start = Clock::now();
+
+  for (int i = 0; i < opts.clients; i++) {
+    threads.emplace_back(RunClient, zmq_context, std::cref(opts),
+                         std::cref(*messageTemplate), i, start,
+                         std::ref(results[i]));
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  if (opts.output.empty()) {
+    WriteResults(std::cout, opts, results);
+  } else {
+    std::ofstream file(opts.output);
+    WriteResults(file, opts, results);
+  }
+
+  auto rc = zmq_ctx_term(zmq_context);
+  ZEROMQ_ASSERT(rc == 0);
+
+  return 0;
+}
@@ -0,0 +1,192 @@
+#include "ExampleHelpers.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zmq.h>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// Stand-in for an Igor Pro instance running the ZeroMQ XOP
+//
+// Replies to every request with the server name as string result and
+// publishes `heartbeat` messages like the XOP. Requests are processed one
+// after another, as in Igor Pro, which allows to test the broker locally.
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Options {
+  std::string serverEndpoint;
+  std::string publisherEndpoint;
+  std::string name = "stand-in";
+  int delay = 0;       // ms
+  int heartbeat = 500; // ms
+};
+
+const char USAGE[] =
+    "Usage: zmq_xop_standin [options] <server> [<publisher>]\n"
+    "\n"
+    "Options:\n"
+    "  --name NAME     returned as result of every request\n"
+    "                  (default: stand-in)\n"
+    "  --delay MS      processing time of every request (default: 0)\n"
+    "  --heartbeat MS  heartbeat interval, 0 disables them\n"
+    "                  (default: 500)\n";
+
+bool ParseOptions(int argc, char **argv, Options &opts) {
+  std::vector<std::string> positional;
+
+  const auto handleOption = [&opts](const std::string &arg,
+                                    const std::string &value) {
+    if (arg == "--name") {
+      opts.name = value;
+    } else if (arg == "--delay") {
+      opts.delay = std::stoi(value);
+    } else if (arg == "--heartbeat") {
+      opts.heartbeat = std::stoi(value);
+    } else {
+      return false;
+    }
+
+    return true;
+  };
+
+  if (!ParseArguments(argc, argv, positional, handleOption)) {
+    return false;
+  }
+
+  if (positional.empty() || positional.size() > 2 || opts.delay < 0 ||
+      opts.heartbeat < 0) {
+    return false;
+  }
+
+  opts.serverEndpoint = positional[0];
+
+  if (positional.size() == 2) {
+    opts.publisherEndpoint = positional[1];
+  }
+
+  return true;
+}
+
+void *CreateSocket(void *context, int type, const std::string &endpoint) {
+  auto socket = zmq_socket(context, type);
+  ZEROMQ_ASSERT(socket != nullptr);
+
+  int val = 0;
+  auto rc = zmq_setsockopt(socket, ZMQ_LINGER, &val, sizeof(val));
+  ZEROMQ_ASSERT(rc == 0);
+
+  rc = zmq_bind(socket, endpoint.c_str());
+  ZEROMQ_ASSERT(rc == 0);
+
+  return socket;
+}
+
+void SendHeartbeat(void *publisher, uint64_t sequence) {
+  const std::chrono::duration<double> timestamp =
+      std::chrono::system_clock::now().time_since_epoch();
+
+  SendString(publisher, "heartbeat", ZMQ_SNDMORE);
+  SendString(publisher,
+             "{\"timestamp\":" + std::to_string(timestamp.count()) +
+                 ",\"sequence\":" + std::to_string(sequence) + "}",
+             0);
+}
+
+// Expected frames: identity, empty, payload and optional binary frames
+void HandleRequest(void *server, zmq_msg_t *msg, const Options &opts) {
+  const std::string identity(static_cast<char *>(zmq_msg_data(msg)),
+                             zmq_msg_size(msg));
+  std::vector<std::string> frames;
+
+  while (zmq_msg_more(msg)) {
+    auto rc = zmq_msg_recv(msg, server, 0);
+    ZEROMQ_ASSERT(rc >= 0);
+
+    frames.emplace_back(static_cast<char *>(zmq_msg_data(msg)),
+                        zmq_msg_size(msg));
+  }
+
+  if (frames.size() < 2 || !frames[0].empty()) {
+    std::cerr << "Ignoring request with invalid format" << std::endl;
+    return;
+  }
+
+  if (opts.delay > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(opts.delay));
+  }
+
+  std::string reply = "{\"errorCode\":{\"value\":0},\"result\":{\"type\":"
+                      "\"string\",\"value\":\"" +
+                      opts.name + "\"}";
+
+  const auto messageId = FindStringValue(frames[1], "messageID");
+
+  if (!messageId.empty()) {
+    reply += ",\"messageID\":\"" + messageId + "\"";
+  }
+
+  reply += "}";
+
+  SendString(server, identity, ZMQ_SNDMORE);
+  SendString(server, "", ZMQ_SNDMORE);
+  SendString(server, reply, 0);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+
+  if (!ParseOptions(argc, argv, opts)) {
+    ExitWithUsage(USAGE);
+  }
+
+  auto zmq_context = zmq_ctx_new();
+  ZEROMQ_ASSERT(zmq_context != nullptr);
+
+  auto server = CreateSocket(zmq_context, ZMQ_ROUTER, opts.serverEndpoint);
+
+  void *publisher = nullptr;
+
+  if (!opts.publisherEndpoint.empty()) {
+    publisher = CreateSocket(zmq_context, ZMQ_PUB, opts.publisherEndpoint);
+  }
+
+  zmq_msg_t msg;
+  auto rc = zmq_msg_init(&msg);
+  ZEROMQ_ASSERT(rc == 0);
+
+  const auto interval = std::chrono::milliseconds(opts.heartbeat);
+  auto nextHeartbeat = Clock::now();
+  uint64_t sequence = 0;
+
+  for (;;) {
+    const auto now = Clock::now();
+
+    if (publisher && opts.heartbeat > 0 && now >= nextHeartbeat) {
+      SendHeartbeat(publisher, sequence++);
+
+      // skip missed heartbeats, e.g. due to a long delay
+      while (nextHeartbeat <= now) {
+        nextHeartbeat += interval;
+      }
+    }
+
+    zmq_pollitem_t item = {server, 0, ZMQ_POLLIN, 0};
+    rc = zmq_poll(&item, 1, 10);
+    ZEROMQ_ASSERT(rc >= 0);
+
+    while (zmq_msg_recv(&msg, server, ZMQ_DONTWAIT) >= 0) {
+      HandleRequest(server, &msg, opts);
+    }
+  }
+}
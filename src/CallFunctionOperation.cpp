@@ -7,11 +7,12 @@
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
 
-CallFunctionOperation::CallFunctionOperation(json j)
+CallFunctionOperation::CallFunctionOperation(const json &j,
+                                             CallFunctionParams params)
 {
   DEBUG_OUTPUT("size={}", j.size());
 
-  if(j.size() != 1 && j.size() != 2)
+  if(j.size() < 1 || j.size() > 3)
   {
     throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
   }
@@ -31,43 +32,30 @@ CallFunctionOperation::CallFunctionOperation(json j)
     throw RequestInterfaceException(REQ_NON_EXISTING_FUNCTION);
   }
 
+  // name, optional params and optional decimation
+  const auto numKnownObjects = 1 + j.count("params") + j.count("decimation");
+
+  if(j.size() != numKnownObjects) // unknown other objects
+  {
+    throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+  }
+
+  m_serializationOptions = ParseWaveSerializationOptions(j);
+
   it = j.find("params");
 
   if(it == j.end())
   {
-    if(j.size() != 1) // unknown other objects
-    {
-      throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
-    }
-
     // no params
     return;
   }
 
-  if(!it.value().is_array())
+  if(!it.value().is_array() || !params.valid)
   {
     throw RequestInterfaceException(REQ_INVALID_PARAM_FORMAT);
   }
 
-  for(const auto &elem : it.value())
-  {
-    if(elem.is_string())
-    {
-      m_params.push_back(elem.get<std::string>());
-    }
-    else if(elem.is_number())
-    {
-      m_params.push_back(To_stringHighRes(elem.get<double>()));
-    }
-    else if(elem.is_boolean())
-    {
-      m_params.push_back(std::to_string(elem.get<bool>()));
-    }
-    else
-    {
-      throw RequestInterfaceException(REQ_INVALID_PARAM_FORMAT);
-    }
-  }
+  m_params = std::move(params.values);
 
   DEBUG_OUTPUT("CallFunction object could be created: {}", *this);
 }
@@ -199,7 +187,7 @@ json CallFunctionOperation::Call()
   auto rc = GetFunctionInfo(m_name.c_str(), &fip);
   ASSERT(rc == 0);
 
-  CallFunctionParameterHandler p(m_params, fip);
+  CallFunctionParameterHandler p(m_params, fip, m_serializationOptions);
 
   HistoryGrabber histGrabber;
 
@@ -237,3 +225,8 @@ std::string CallFunctionOperation::GetHistoryDuringCall() const
 {
   return m_historyDuringCall;
 }
+
+std::string CallFunctionOperation::ToString() const
+{
+  return fmt::format("CallFunction: {}", *this);
+}
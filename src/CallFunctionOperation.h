@@ -1,26 +1,43 @@
 #pragma once
 
 #include "ZeroMQ.h"
+#include "Operation.h"
+#include "SerializeWave.h"
 
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
 
-class CallFunctionOperation
+/// @brief Parameters of `CallFunction` as converted by the request parser
+///
+/// The parser converts the elements of the `params` array directly into
+/// strings, so these are neither stored in nor copied from the JSON document.
+struct CallFunctionParams
+{
+  std::vector<std::string> values;
+  bool valid{true}; ///< false if an element is no string, number or boolean
+};
+
+class CallFunctionOperation : public Operation
 {
 public:
-  explicit CallFunctionOperation(json j);
-  void CanBeProcessed() const;
-  json Call();
+  /// @param j      `CallFunction` object, `params` is an empty array if it was
+  ///               an array in the request
+  /// @param params converted elements of the `params` array
+  CallFunctionOperation(const json &j, CallFunctionParams params);
+  void CanBeProcessed() const override;
+  json Call() override;
 
   friend struct fmt::formatter<CallFunctionOperation>;
 
   // Return the Igor history outputted during the function call
-  std::string GetHistoryDuringCall() const;
+  std::string GetHistoryDuringCall() const override;
+  std::string ToString() const override;
 
 private:
   std::string m_name;
   std::vector<std::string> m_params;
   std::string m_historyDuringCall;
+  WaveSerializationOptions m_serializationOptions;
 };
 
 template <>
@@ -2,6 +2,8 @@
 #include "SerializeWave.h"
 #include "ZeroMQ.h"
 
+#include <climits>
+
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
 
@@ -28,7 +30,8 @@ std::string GetTypeStringForIgorType(int igorType)
     ASSERT(0);
   }
 }
-json ExtractFromUnion(IgorTypeUnion *ret, int igorType)
+json ExtractFromUnion(IgorTypeUnion *ret, int igorType,
+                      const WaveSerializationOptions &serializationOptions)
 {
   igorType = ClearBit(igorType, FV_REF_TYPE);
 
@@ -48,7 +51,7 @@ json ExtractFromUnion(IgorTypeUnion *ret, int igorType)
     auto result = GetStringFromHandle(ret->stringHandle);
     WMDisposeHandle(ret->stringHandle);
     ret->stringHandle = nullptr;
-    return std::move(result);
+    return result;
   }
   case DATAFOLDER_TYPE:
   {
@@ -58,12 +61,12 @@ json ExtractFromUnion(IgorTypeUnion *ret, int igorType)
       ReleaseDataFolder(&ret->dataFolderHandle);
       ret->dataFolderHandle = nullptr;
     }
-    return std::move(result);
+    return result;
   }
   default:
     if(IsWaveType(igorType))
     {
-      auto result = SerializeWave(ret->waveHandle);
+      auto result = SerializeWave(ret->waveHandle, serializationOptions);
 
       if(ret->waveHandle != nullptr && IsFreeWave(ret->waveHandle))
       {
@@ -71,7 +74,7 @@ json ExtractFromUnion(IgorTypeUnion *ret, int igorType)
         ret->waveHandle = nullptr;
       }
 
-      return std::move(result);
+      return result;
     }
     ASSERT(0);
   }
@@ -107,8 +110,9 @@ IgorTypeUnion ConvertStringToIgorTypeUnion(const std::string &param,
 } // anonymous namespace
 
 CallFunctionParameterHandler::CallFunctionParameterHandler(
-    StringVector inputParams, FunctionInfo fip)
-    : m_returnType(fip.returnType)
+    StringVector inputParams, FunctionInfo fip,
+    WaveSerializationOptions serializationOptions)
+    : m_returnType(fip.returnType), m_serializationOptions(serializationOptions)
 {
   ASSERT(sizeof(fip.parameterTypes) / sizeof(int) == MAX_NUM_PARAMS);
   ASSERT(fip.totalNumParameters < MAX_NUM_PARAMS);
@@ -196,7 +200,8 @@ json CallFunctionParameterHandler::GetReturnValues()
 
   json doc;
 
-  doc["value"] = ExtractFromUnion(&m_retStorage, m_returnType);
+  doc["value"] =
+      ExtractFromUnion(&m_retStorage, m_returnType, m_serializationOptions);
   doc["type"]  = GetTypeStringForIgorType(m_returnType);
 
   return doc;
@@ -252,7 +257,8 @@ json CallFunctionParameterHandler::ReadPassByRefParameters(int first, int last)
         json doc;
 
         doc["value"] = ExtractFromUnion(reinterpret_cast<IgorTypeUnion *>(src),
-                                        m_paramTypes[i]);
+                                        m_paramTypes[i],
+                                        m_serializationOptions);
         doc["type"]  = GetTypeStringForIgorType(m_paramTypes[i]);
 
         elems.push_back(doc);
@@ -2,6 +2,7 @@
 
 #include "ZeroMQ.h"
 #include "IgorTypeUnion.h"
+#include "SerializeWave.h"
 
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
@@ -9,7 +10,8 @@
 class CallFunctionParameterHandler
 {
 public:
-  CallFunctionParameterHandler(StringVector params, FunctionInfo fip);
+  CallFunctionParameterHandler(StringVector params, FunctionInfo fip,
+                               WaveSerializationOptions serializationOptions);
   ~CallFunctionParameterHandler();
 
   // Return a jsons style array for the pass-by-reference parameters
@@ -28,4 +30,5 @@ private:
   int m_numInputParams;
   int m_returnType;
   IgorTypeUnion m_retStorage = {};
+  WaveSerializationOptions m_serializationOptions;
 };
@@ -0,0 +1,521 @@
+#include "ZeroMQ.h"
+#include "Compression.h"
+#include "MessageEncoding.h"
+
+#include <algorithm>
+#include <array>
+
+#if HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#if HAVE_LZ4
+#include <lz4frame.h>
+#endif
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+// little endian magic numbers of the frame formats
+const std::array<unsigned char, 4> ZSTD_FRAME_MAGIC = {0x28, 0xB5, 0x2F, 0xFD};
+const std::array<unsigned char, 4> LZ4_FRAME_MAGIC  = {0x04, 0x22, 0x4D, 0x18};
+
+bool HasMagic(const void *data, size_t length,
+              const std::array<unsigned char, 4> &magic)
+{
+  return length >= magic.size() &&
+         std::memcmp(data, magic.data(), magic.size()) == 0;
+}
+
+#if HAVE_ZSTD || HAVE_LZ4
+
+void AppendDecompressed(std::string &result, const char *data, size_t length)
+{
+  if(length > MAX_DECOMPRESSED_SIZE - result.size())
+  {
+    throw IgorException(INVALID_MESSAGE_FORMAT,
+                        fmt::format("decompressed frame exceeds {} bytes\r",
+                                    MAX_DECOMPRESSED_SIZE));
+  }
+
+  result.append(data, length);
+}
+
+#endif
+
+#if HAVE_ZSTD
+
+// fast level, we are bandwidth-bound and don't want to stall the main thread
+const int ZSTD_COMPRESSION_LEVEL = 1;
+
+struct ZstdContextDeleter
+{
+  void operator()(ZSTD_CCtx *ctx) const
+  {
+    ZSTD_freeCCtx(ctx);
+  }
+
+  void operator()(ZSTD_DCtx *ctx) const
+  {
+    ZSTD_freeDCtx(ctx);
+  }
+};
+
+ZSTD_CCtx *GetZstdCompressionContext()
+{
+  thread_local std::unique_ptr<ZSTD_CCtx, ZstdContextDeleter> ctx(
+      ZSTD_createCCtx());
+  ASSERT(ctx);
+
+  return ctx.get();
+}
+
+ZSTD_DCtx *GetZstdDecompressionContext()
+{
+  thread_local std::unique_ptr<ZSTD_DCtx, ZstdContextDeleter> ctx(
+      ZSTD_createDCtx());
+  ASSERT(ctx);
+
+  return ctx.get();
+}
+
+void CompressZstd(const void *data, size_t length, std::string &result)
+{
+  result.resize(ZSTD_compressBound(length));
+
+  const auto size =
+      ZSTD_compressCCtx(GetZstdCompressionContext(), result.data(),
+                        result.size(), data, length, ZSTD_COMPRESSION_LEVEL);
+
+  if(ZSTD_isError(size))
+  {
+    throw IgorException(INTERNAL_ERROR,
+                        fmt::format("zstd compression failed: {}\r",
+                                    ZSTD_getErrorName(size)));
+  }
+
+  result.resize(size);
+}
+
+void DecompressZstd(const void *data, size_t length, std::string &result)
+{
+  auto ctx = GetZstdDecompressionContext();
+  ZSTD_DCtx_reset(ctx, ZSTD_reset_session_only);
+
+  const auto contentSize = ZSTD_getFrameContentSize(data, length);
+
+  result.clear();
+
+  if(contentSize != ZSTD_CONTENTSIZE_UNKNOWN &&
+     contentSize != ZSTD_CONTENTSIZE_ERROR)
+  {
+    // only a hint, the decompressed size is checked while appending
+    result.reserve(static_cast<size_t>(
+        std::min(contentSize,
+                 static_cast<unsigned long long>(MAX_DECOMPRESSED_SIZE))));
+  }
+
+  std::vector<char> chunk(ZSTD_DStreamOutSize());
+  ZSTD_inBuffer input = {data, length, 0};
+
+  for(;;)
+  {
+    ZSTD_outBuffer output = {chunk.data(), chunk.size(), 0};
+
+    const auto ret = ZSTD_decompressStream(ctx, &output, &input);
+
+    if(ZSTD_isError(ret))
+    {
+      throw IgorException(INVALID_MESSAGE_FORMAT,
+                          fmt::format("zstd decompression failed: {}\r",
+                                      ZSTD_getErrorName(ret)));
+    }
+
+    AppendDecompressed(result, chunk.data(), output.pos);
+
+    if(ret == 0)
+    {
+      return;
+    }
+
+    if(input.pos == input.size && output.pos < output.size)
+    {
+      throw IgorException(INVALID_MESSAGE_FORMAT,
+                          "zstd decompression failed: truncated frame\r");
+    }
+  }
+}
+
+#endif // HAVE_ZSTD
+
+#if HAVE_LZ4
+
+struct LZ4ContextDeleter
+{
+  void operator()(LZ4F_cctx *ctx) const
+  {
+    LZ4F_freeCompressionContext(ctx);
+  }
+
+  void operator()(LZ4F_dctx *ctx) const
+  {
+    LZ4F_freeDecompressionContext(ctx);
+  }
+};
+
+LZ4F_cctx *GetLZ4CompressionContext()
+{
+  thread_local std::unique_ptr<LZ4F_cctx, LZ4ContextDeleter> ctx(
+      []()
+      {
+        LZ4F_cctx *ptr = nullptr;
+        const auto ret = LZ4F_createCompressionContext(&ptr, LZ4F_VERSION);
+        return LZ4F_isError(ret) ? nullptr : ptr;
+      }());
+  ASSERT(ctx);
+
+  return ctx.get();
+}
+
+LZ4F_dctx *GetLZ4DecompressionContext()
+{
+  thread_local std::unique_ptr<LZ4F_dctx, LZ4ContextDeleter> ctx(
+      []()
+      {
+        LZ4F_dctx *ptr = nullptr;
+        const auto ret = LZ4F_createDecompressionContext(&ptr, LZ4F_VERSION);
+        return LZ4F_isError(ret) ? nullptr : ptr;
+      }());
+  ASSERT(ctx);
+
+  return ctx.get();
+}
+
+void ThrowOnLZ4Error(size_t ret, int errorCode)
+{
+  if(LZ4F_isError(ret))
+  {
+    throw IgorException(errorCode, fmt::format("lz4 failed: {}\r",
+                                               LZ4F_getErrorName(ret)));
+  }
+}
+
+void CompressLZ4(const void *data, size_t length, std::string &result)
+{
+  LZ4F_preferences_t prefs = {};
+  prefs.frameInfo.contentSize = length;
+
+  result.resize(LZ4F_HEADER_SIZE_MAX + LZ4F_compressBound(length, &prefs));
+
+  auto ctx   = GetLZ4CompressionContext();
+  auto dst   = result.data();
+  size_t pos = 0;
+
+  auto ret = LZ4F_compressBegin(ctx, dst, result.size(), &prefs);
+  ThrowOnLZ4Error(ret, INTERNAL_ERROR);
+  pos += ret;
+
+  ret = LZ4F_compressUpdate(ctx, dst + pos, result.size() - pos, data, length,
+                            nullptr);
+  ThrowOnLZ4Error(ret, INTERNAL_ERROR);
+  pos += ret;
+
+  ret = LZ4F_compressEnd(ctx, dst + pos, result.size() - pos, nullptr);
+  ThrowOnLZ4Error(ret, INTERNAL_ERROR);
+  pos += ret;
+
+  result.resize(pos);
+}
+
+void DecompressLZ4(const void *data, size_t length, std::string &result)
+{
+  auto ctx = GetLZ4DecompressionContext();
+  LZ4F_resetDecompressionContext(ctx);
+
+  result.clear();
+
+  std::vector<char> chunk(64 * 1024);
+  auto src       = reinterpret_cast<const char *>(data);
+  size_t srcLeft = length;
+
+  for(;;)
+  {
+    size_t dstSize = chunk.size();
+    size_t srcSize = srcLeft;
+
+    const auto ret =
+        LZ4F_decompress(ctx, chunk.data(), &dstSize, src, &srcSize, nullptr);
+    ThrowOnLZ4Error(ret, INVALID_MESSAGE_FORMAT);
+
+    AppendDecompressed(result, chunk.data(), dstSize);
+    src += srcSize;
+    srcLeft -= srcSize;
+
+    if(ret == 0) // frame fully decoded
+    {
+      return;
+    }
+
+    if(srcLeft == 0 && dstSize == 0)
+    {
+      throw IgorException(INVALID_MESSAGE_FORMAT,
+                          "lz4 decompression failed: truncated frame\r");
+    }
+  }
+}
+
+#endif // HAVE_LZ4
+
+} // anonymous namespace
+
+bool ParseCompressionMethod(const std::string &name, CompressionMethod &method)
+{
+  if(name == "none")
+  {
+    method = CompressionMethod::None;
+    return true;
+  }
+  if(name == "lz4")
+  {
+    method = CompressionMethod::LZ4;
+    return true;
+  }
+  if(name == "zstd")
+  {
+    method = CompressionMethod::Zstd;
+    return true;
+  }
+
+  return false;
+}
+
+std::string GetCompressionMethodString(CompressionMethod method)
+{
+  switch(method)
+  {
+  case CompressionMethod::None:
+    return "none";
+  case CompressionMethod::LZ4:
+    return "lz4";
+  case CompressionMethod::Zstd:
+    return "zstd";
+  }
+
+  ASSERT(0);
+}
+
+bool IsCompressionMethodAvailable(CompressionMethod method)
+{
+  switch(method)
+  {
+  case CompressionMethod::None:
+    return true;
+  case CompressionMethod::LZ4:
+    return HAVE_LZ4;
+  case CompressionMethod::Zstd:
+    return HAVE_ZSTD;
+  }
+
+  ASSERT(0);
+}
+
+CompressionSettings ParseCompressionRequest(const json &doc)
+{
+  CompressionSettings settings;
+
+  auto it = doc.find("compression");
+
+  if(it == doc.end())
+  {
+    return settings;
+  }
+
+  const auto &compression = it.value();
+
+  if(!compression.is_object())
+  {
+    throw RequestInterfaceException(REQ_INVALID_COMPRESSION);
+  }
+
+  it = compression.find("accept");
+
+  if(it == compression.end() || !it.value().is_array())
+  {
+    throw RequestInterfaceException(REQ_INVALID_COMPRESSION);
+  }
+
+  for(const auto &elem : it.value())
+  {
+    if(!elem.is_string())
+    {
+      throw RequestInterfaceException(REQ_INVALID_COMPRESSION);
+    }
+
+    CompressionMethod method;
+
+    if(settings.method == CompressionMethod::None &&
+       ParseCompressionMethod(elem.get<std::string>(), method) &&
+       IsCompressionMethodAvailable(method))
+    {
+      settings.method = method;
+    }
+  }
+
+  it = compression.find("threshold");
+
+  if(it != compression.end())
+  {
+    if(!it.value().is_number_unsigned())
+    {
+      throw RequestInterfaceException(REQ_INVALID_COMPRESSION);
+    }
+
+    settings.threshold = it.value().get<size_t>();
+  }
+
+  const auto numKnownObjects = 1 + compression.count("threshold");
+
+  if(compression.size() != numKnownObjects)
+  {
+    throw RequestInterfaceException(REQ_INVALID_COMPRESSION);
+  }
+
+  return settings;
+}
+
+bool CompressFrame(const CompressionSettings &settings, const void *data,
+                   size_t length, std::string &result)
+{
+#if !HAVE_ZSTD && !HAVE_LZ4
+  // without compression libraries
+  (void) data;
+  (void) result;
+#endif
+
+  if(settings.method == CompressionMethod::None ||
+     length < settings.threshold || length == 0)
+  {
+    return false;
+  }
+
+  switch(settings.method)
+  {
+  case CompressionMethod::None:
+    return false;
+  case CompressionMethod::LZ4:
+#if HAVE_LZ4
+    CompressLZ4(data, length, result);
+    break;
+#else
+    return false;
+#endif
+  case CompressionMethod::Zstd:
+#if HAVE_ZSTD
+    CompressZstd(data, length, result);
+    break;
+#else
+    return false;
+#endif
+  }
+
+  DEBUG_OUTPUT("method={}, uncompressed={}, compressed={}",
+               GetCompressionMethodString(settings.method), length,
+               result.size());
+
+  return result.size() < length;
+}
+
+CompressionMethod GetFrameCompressionMethod(const void *data, size_t length)
+{
+  if(HasMagic(data, length, ZSTD_FRAME_MAGIC))
+  {
+    return CompressionMethod::Zstd;
+  }
+
+  if(HasMagic(data, length, LZ4_FRAME_MAGIC))
+  {
+    return CompressionMethod::LZ4;
+  }
+
+  return CompressionMethod::None;
+}
+
+bool RequestsCompression(const std::string &request)
+{
+  // keys are stored verbatim in all encodings, this avoids decoding most
+  // requests
+  if(request.find("compression") == std::string::npos)
+  {
+    return false;
+  }
+
+  try
+  {
+    const auto doc = DecodeMessage(request, DetectMessageEncoding(request));
+
+    return doc.is_object() && doc.contains("compression");
+  }
+  catch(const IgorException &)
+  {
+    return false;
+  }
+}
+
+bool DecompressFrame(const void *data, size_t length, std::string &result)
+{
+#if !HAVE_ZSTD && !HAVE_LZ4
+  // without compression libraries
+  (void) result;
+#endif
+
+  const auto method = GetFrameCompressionMethod(data, length);
+
+  switch(method)
+  {
+  case CompressionMethod::None:
+    return false;
+  case CompressionMethod::LZ4:
+#if HAVE_LZ4
+    DecompressLZ4(data, length, result);
+    return true;
+#else
+    return false;
+#endif
+  case CompressionMethod::Zstd:
+#if HAVE_ZSTD
+    DecompressZstd(data, length, result);
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  ASSERT(0);
+}
+
+void DecompressMessageIfRequired(zmq_msg_t *msg)
+{
+  std::string payload;
+
+  if(!DecompressFrame(zmq_msg_data(msg), zmq_msg_size(msg), payload))
+  {
+    return;
+  }
+
+  DEBUG_OUTPUT("compressed={}, uncompressed={}", zmq_msg_size(msg),
+               payload.size());
+
+  int rc = zmq_msg_close(msg);
+  ZEROMQ_ASSERT(rc == 0);
+
+  rc = zmq_msg_init_size(msg, payload.size());
+  ZEROMQ_ASSERT(rc == 0);
+
+  if(!payload.empty())
+  {
+    memcpy(zmq_msg_data(msg), payload.data(), payload.size());
+  }
+}
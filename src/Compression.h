@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// @brief Optional compression of outgoing payload frames
+///
+/// Compressed frames use the standard frame formats of the libraries, which
+/// start with a magic number. Replies are encoded messages, which never start
+/// with these bytes, so clients check every reply frame for them. Binary
+/// payloads, e.g. wave data, can start with the same bytes, so subscribers
+/// only look for compressed frames for the subscriptions enabled with
+/// zeromq_sub_set_compression().
+
+enum class CompressionMethod
+{
+  None,
+  LZ4,
+  Zstd
+};
+
+/// Payloads smaller than this number of bytes are sent uncompressed by default
+const size_t DEFAULT_COMPRESSION_THRESHOLD = 1024;
+
+/// Frames decompressing to more bytes are rejected, as the size in the frame
+/// header comes from the peer
+const size_t MAX_DECOMPRESSED_SIZE = 1024 * 1024 * 1024;
+
+struct CompressionSettings
+{
+  CompressionMethod method{CompressionMethod::None};
+  size_t threshold{DEFAULT_COMPRESSION_THRESHOLD};
+};
+
+/// @brief Convert a method name (`none`, `lz4` or `zstd`) to its enumeration
+///
+/// @return true on success, false for unknown names
+bool ParseCompressionMethod(const std::string &name, CompressionMethod &method);
+
+std::string GetCompressionMethodString(CompressionMethod method);
+
+/// @brief Return true if the XOP was built with support for the given method
+bool IsCompressionMethodAvailable(CompressionMethod method);
+
+/// @brief Parse the optional `compression` object of a request
+///
+/// Expected format: `{"accept" : ["zstd", "lz4"], "threshold" : 1024}`, with
+/// `threshold` being optional. The first accepted and available method is
+/// chosen, unknown method names are ignored.
+CompressionSettings ParseCompressionRequest(const json &doc);
+
+/// @brief Compress the given data according to `settings`
+///
+/// Compression is skipped for data smaller than the threshold and if the
+/// compressed data would not be smaller.
+///
+/// The compression contexts are kept per thread and reused across calls.
+///
+/// @return true if `result` holds the compressed data, false if the data
+///         should be sent as is
+bool CompressFrame(const CompressionSettings &settings, const void *data,
+                   size_t length, std::string &result);
+
+/// @brief Return the compression method of a frame from its magic number
+CompressionMethod GetFrameCompressionMethod(const void *data, size_t length);
+
+/// @brief Return true if the request asks for compressed replies
+///
+/// Malformed requests never do.
+bool RequestsCompression(const std::string &request);
+
+/// @brief Decompress the frame into `result`
+///
+/// Throws with INVALID_MESSAGE_FORMAT for malformed frames and frames
+/// decompressing to more than MAX_DECOMPRESSED_SIZE bytes.
+///
+/// @return true if `result` holds the decompressed data, false for
+///         uncompressed frames or frames compressed with an unavailable method
+bool DecompressFrame(const void *data, size_t length, std::string &result);
+
+/// @brief Decompress the message in place if it holds a compressed frame
+void DecompressMessageIfRequired(zmq_msg_t *msg);
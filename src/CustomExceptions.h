@@ -53,6 +53,7 @@ void to_json(json &j, const IgorException &e);
 int HandleException(const std::exception &e);
 
 #define BEGIN_OUTER_CATCH                                                      \
+  MEASURE_LATENCY(outerCatchLatency, __func__);                                \
   p->result = decltype(p->result)();                                           \
   try                                                                          \
   {
@@ -62,14 +63,17 @@ int HandleException(const std::exception &e);
   }                                                                            \
   catch(const IgorException &e)                                                \
   {                                                                            \
+    outerCatchLatency.SetFailed();                                             \
     return e.HandleException();                                                \
   }                                                                            \
   catch(const std::exception &e)                                               \
   {                                                                            \
+    outerCatchLatency.SetFailed();                                             \
     return HandleException(e);                                                 \
   }                                                                            \
   catch(...)                                                                   \
   {                                                                            \
     /* Unhandled exception */                                                  \
+    outerCatchLatency.SetFailed();                                             \
     return UNHANDLED_CPP_EXCEPTION;                                            \
   }
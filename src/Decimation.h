@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// @brief Point selection algorithms for plot-ready transfer of large waves
+///
+/// All functions return the sorted indices of the selected points, the caller
+/// has to gather the values and x-coordinates itself. This keeps the
+/// algorithms independent of the wave scaling as both methods are invariant
+/// under a linear transformation of the x-axis.
+
+enum class DecimationMethod
+{
+  None,
+  MinMax,
+  LTTB
+};
+
+namespace DecimationDetail
+{
+
+/// Return the first index of the bucket `bucket` when splitting `length`
+/// points into `numBuckets` equally sized buckets
+///
+/// Uses 64bit arithmetic as `bucket * length` overflows size_t on 32bit
+inline size_t GetBucketStart(size_t bucket, size_t length, size_t numBuckets)
+{
+  return static_cast<size_t>(static_cast<uint64_t>(bucket) *
+                             static_cast<uint64_t>(length) /
+                             static_cast<uint64_t>(numBuckets));
+}
+
+template <typename T>
+T GetMinStartValue()
+{
+  if(std::numeric_limits<T>::has_infinity)
+  {
+    return std::numeric_limits<T>::infinity();
+  }
+
+  return std::numeric_limits<T>::max();
+}
+
+template <typename T>
+T GetMaxStartValue()
+{
+  if(std::numeric_limits<T>::has_infinity)
+  {
+    return -std::numeric_limits<T>::infinity();
+  }
+
+  return std::numeric_limits<T>::lowest();
+}
+
+/// Return the indices of the minimum and maximum value of the given range
+///
+/// The first pass only tracks the values and is written branch-free so that
+/// the compiler can vectorize it, the second pass locates the values. NaN
+/// entries are ignored, a range consisting only of NaN returns the first
+/// index.
+template <typename T>
+std::pair<size_t, size_t> FindMinMaxIndex(const T *data, size_t length)
+{
+  T minValue = GetMinStartValue<T>();
+  T maxValue = GetMaxStartValue<T>();
+
+  for(size_t i = 0; i < length; i++)
+  {
+    const T val = data[i];
+    minValue    = val < minValue ? val : minValue;
+    maxValue    = val > maxValue ? val : maxValue;
+  }
+
+  const T *end   = data + length;
+  const T *minIt = std::find(data, end, minValue);
+  const T *maxIt = std::find(data, end, maxValue);
+
+  const auto minIndex = minIt == end ? 0 : static_cast<size_t>(minIt - data);
+  const auto maxIndex = maxIt == end ? 0 : static_cast<size_t>(maxIt - data);
+
+  return {minIndex, maxIndex};
+}
+
+inline std::vector<size_t> GetAllIndices(size_t length)
+{
+  std::vector<size_t> indices(length);
+  std::iota(indices.begin(), indices.end(), static_cast<size_t>(0));
+
+  return indices;
+}
+
+} // namespace DecimationDetail
+
+/// @brief Min/max decimation
+///
+/// Splits the data into `targetPoints / 2` buckets and returns for each bucket
+/// the index of the minimum and the maximum in the order of their occurrence.
+/// This preserves the visual envelope of the data including all peaks.
+///
+/// Returns all indices if no decimation is necessary.
+template <typename T>
+std::vector<size_t> DecimateMinMax(const T *data, size_t length,
+                                   size_t targetPoints)
+{
+  const size_t numBuckets = targetPoints / 2;
+
+  if(numBuckets == 0 || length <= targetPoints)
+  {
+    return DecimationDetail::GetAllIndices(length);
+  }
+
+  std::vector<size_t> indices;
+  indices.reserve(2 * numBuckets);
+
+  for(size_t i = 0; i < numBuckets; i++)
+  {
+    const auto first = DecimationDetail::GetBucketStart(i, length, numBuckets);
+    const auto last =
+        DecimationDetail::GetBucketStart(i + 1, length, numBuckets);
+
+    auto [minIndex, maxIndex] =
+        DecimationDetail::FindMinMaxIndex(data + first, last - first);
+
+    minIndex += first;
+    maxIndex += first;
+
+    if(minIndex == maxIndex)
+    {
+      indices.push_back(minIndex);
+    }
+    else
+    {
+      indices.push_back(std::min(minIndex, maxIndex));
+      indices.push_back(std::max(minIndex, maxIndex));
+    }
+  }
+
+  return indices;
+}
+
+/// @brief Largest-Triangle-Three-Buckets decimation
+///
+/// Implements the algorithm from S. Steinarsson, "Downsampling Time Series
+/// for Visual Representation", 2013. The first and last point are always
+/// included, from each of the `targetPoints - 2` buckets in between the point
+/// forming the largest triangle with the previously selected point and the
+/// average of the next bucket is chosen.
+///
+/// Returns all indices if no decimation is necessary.
+template <typename T>
+std::vector<size_t> DecimateLTTB(const T *data, size_t length,
+                                 size_t targetPoints)
+{
+  if(targetPoints < 3 || length <= targetPoints)
+  {
+    return DecimationDetail::GetAllIndices(length);
+  }
+
+  std::vector<size_t> indices;
+  indices.reserve(targetPoints);
+
+  const size_t numBuckets = targetPoints - 2;
+  const size_t numInner   = length - 2;
+
+  // all inner buckets are shifted by one as the first point is fixed
+  auto bucketStart = [numInner, numBuckets](size_t bucket)
+  {
+    return DecimationDetail::GetBucketStart(bucket, numInner, numBuckets) + 1;
+  };
+
+  size_t selected = 0;
+  indices.push_back(selected);
+
+  for(size_t i = 0; i < numBuckets; i++)
+  {
+    const auto first = bucketStart(i);
+    const auto last  = bucketStart(i + 1);
+
+    // average of the next bucket, the last point for the last bucket
+    double avgX = 0.0;
+    double avgY = 0.0;
+
+    const auto nextFirst = last;
+    const auto nextLast  = (i + 1 < numBuckets) ? bucketStart(i + 2) : length;
+
+    for(size_t j = nextFirst; j < nextLast; j++)
+    {
+      avgX += static_cast<double>(j);
+      avgY += static_cast<double>(data[j]);
+    }
+
+    const auto count = static_cast<double>(nextLast - nextFirst);
+    avgX /= count;
+    avgY /= count;
+
+    const auto ax = static_cast<double>(selected);
+    const auto ay = static_cast<double>(data[selected]);
+
+    double maxArea = -1.0;
+    size_t next    = first;
+
+    for(size_t j = first; j < last; j++)
+    {
+      const auto bx = static_cast<double>(j);
+      const auto by = static_cast<double>(data[j]);
+
+      const auto area =
+          std::abs((ax - avgX) * (by - ay) - (ax - bx) * (avgY - ay));
+
+      // NaN areas are never larger
+      if(area > maxArea)
+      {
+        maxArea = area;
+        next    = j;
+      }
+    }
+
+    selected = next;
+    indices.push_back(selected);
+  }
+
+  indices.push_back(length - 1);
+
+  return indices;
+}
+
+template <typename T>
+std::vector<size_t> Decimate(DecimationMethod method, const T *data,
+                             size_t length, size_t targetPoints)
+{
+  switch(method)
+  {
+  case DecimationMethod::MinMax:
+    return DecimateMinMax(data, length, targetPoints);
+  case DecimationMethod::LTTB:
+    return DecimateLTTB(data, length, targetPoints);
+  case DecimationMethod::None:
+    break;
+  }
+
+  return DecimationDetail::GetAllIndices(length);
+}
@@ -18,6 +18,13 @@
 #define MESSAGE_FILTER_DUPLICATED  11 + FIRST_XOP_ERR
 #define MESSAGE_FILTER_MISSING     12 + FIRST_XOP_ERR
 #define ERR_INVALID_TYPE           13 + FIRST_XOP_ERR
+#define COMPRESSION_UNAVAILABLE    14 + FIRST_XOP_ERR
+#define UNKNOWN_SERVER             15 + FIRST_XOP_ERR
+#define SERVER_ALREADY_EXISTS      16 + FIRST_XOP_ERR
+#define UNKNOWN_PUB_CHANNEL        17 + FIRST_XOP_ERR
+#define PUB_CHANNEL_ALREADY_EXISTS 18 + FIRST_XOP_ERR
+#define SOCKET_ALREADY_IN_USE      19 + FIRST_XOP_ERR
+#define INVALID_CALLBACK           20 + FIRST_XOP_ERR
 
 // non-XOP error codes
 
@@ -31,6 +38,9 @@
 #define REQ_INVALID_OPERATION_FORMAT   6
 #define REQ_INVALID_MESSAGEID          7
 #define REQ_OUT_OF_MEMORY              8
+#define REQ_INVALID_COMPRESSION        9
+#define REQ_INVALID_STREAM             10
+#define REQ_NO_BACKEND                 11
 /// @name Error codes for the CallFunction class
 /// @{
 #define REQ_PROC_NOT_COMPILED        100
@@ -41,6 +51,13 @@
 #define REQ_UNSUPPORTED_FUNC_RET     105
 #define REQ_INVALID_PARAM_FORMAT     106
 #define REQ_FUNCTION_ABORTED         107
+#define REQ_INVALID_DECIMATION       108
+/// @}
+/// @name Error codes for the NativeOperation class
+/// @{
+#define REQ_NON_EXISTING_WAVE        200
+#define REQ_NON_EXISTING_DATAFOLDER  201
+#define REQ_INVALID_WAVE_DATA        202
 /// @}
 /// @}
 // clang-format on
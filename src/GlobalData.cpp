@@ -8,6 +8,19 @@ namespace
 
 constexpr char PACKAGE_NAME[] = "ZeroMQ";
 
+void SetMaxMessageSize(void *s, int64_t bytes)
+{
+  auto rc = zmq_setsockopt(s, ZMQ_MAXMSGSIZE, &bytes, sizeof(bytes));
+  ZEROMQ_ASSERT(rc == 0);
+}
+
+void SetIPV6(void *s, bool enable)
+{
+  const int val = enable;
+  auto rc       = zmq_setsockopt(s, ZMQ_IPV6, &val, sizeof(val));
+  ZEROMQ_ASSERT(rc == 0);
+}
+
 void ApplySocketDefaults(void *s, SocketTypes st)
 {
   int valZero = 0;
@@ -25,6 +38,14 @@ void ApplySocketDefaults(void *s, SocketTypes st)
 
   switch(st)
   {
+#if HAVE_THREADSAFE_SOCKETS
+  // identities are replaced by routing ids
+  case SocketTypes::Client:
+    return;
+  case SocketTypes::Server:
+    SetMaxMessageSize(s, DEFAULT_MAX_MESSAGE_SIZE);
+    return;
+#else
   case SocketTypes::Client:
   {
     const char identity[] = "zeromq xop: dealer";
@@ -32,9 +53,6 @@ void ApplySocketDefaults(void *s, SocketTypes st)
     ZEROMQ_ASSERT(rc == 0);
     return;
   }
-  case SocketTypes::Publisher:
-    // do nothing
-    return;
   case SocketTypes::Server:
   {
     const char identity[] = "zeromq xop: router";
@@ -44,12 +62,13 @@ void ApplySocketDefaults(void *s, SocketTypes st)
     rc = zmq_setsockopt(s, ZMQ_ROUTER_MANDATORY, &valOne, sizeof(valOne));
     ZEROMQ_ASSERT(rc == 0);
 
-    int64_t bytes = 1024;
-
-    rc = zmq_setsockopt(s, ZMQ_MAXMSGSIZE, &bytes, sizeof(bytes));
-    ZEROMQ_ASSERT(rc == 0);
+    SetMaxMessageSize(s, DEFAULT_MAX_MESSAGE_SIZE);
     return;
   }
+#endif
+  case SocketTypes::Publisher:
+    // do nothing
+    return;
   case SocketTypes::Subscriber:
     // do nothing
     return;
@@ -58,16 +77,55 @@ void ApplySocketDefaults(void *s, SocketTypes st)
   ASSERT(0);
 }
 
+int GetUnknownNameError(SocketTypes st)
+{
+  switch(st)
+  {
+  case SocketTypes::Server:
+    return UNKNOWN_SERVER;
+  case SocketTypes::Publisher:
+    return UNKNOWN_PUB_CHANNEL;
+  case SocketTypes::Client:
+  case SocketTypes::Subscriber:
+    break;
+  }
+
+  return INTERNAL_ERROR;
+}
+
+int GetDuplicatedNameError(SocketTypes st)
+{
+  switch(st)
+  {
+  case SocketTypes::Server:
+    return SERVER_ALREADY_EXISTS;
+  case SocketTypes::Publisher:
+    return PUB_CHANNEL_ALREADY_EXISTS;
+  case SocketTypes::Client:
+  case SocketTypes::Subscriber:
+    break;
+  }
+
+  return INTERNAL_ERROR;
+}
+
 int GetZeroMQSocketConstant(SocketTypes st)
 {
   switch(st)
   {
+#if HAVE_THREADSAFE_SOCKETS
+  case SocketTypes::Client:
+    return ZMQ_CLIENT;
+  case SocketTypes::Server:
+    return ZMQ_SERVER;
+#else
   case SocketTypes::Client:
     return ZMQ_DEALER;
-  case SocketTypes::Publisher:
-    return ZMQ_PUB;
   case SocketTypes::Server:
     return ZMQ_ROUTER;
+#endif
+  case SocketTypes::Publisher:
+    return ZMQ_PUB;
   case SocketTypes::Subscriber:
     return ZMQ_SUB;
   }
@@ -82,6 +140,32 @@ AllSocketTypesArray GetAllSocketTypes()
                              SocketTypes::Publisher, SocketTypes::Server};
 }
 
+bool ParseSocketType(const std::string &name, SocketTypes &st)
+{
+  if(name == "client")
+  {
+    st = SocketTypes::Client;
+    return true;
+  }
+  if(name == "server")
+  {
+    st = SocketTypes::Server;
+    return true;
+  }
+  if(name == "publisher")
+  {
+    st = SocketTypes::Publisher;
+    return true;
+  }
+  if(name == "subscriber")
+  {
+    st = SocketTypes::Subscriber;
+    return true;
+  }
+
+  return false;
+}
+
 GlobalData::GlobalData()
     : m_debugging(false), m_busyWaiting(true), m_logging(false)
 {
@@ -106,7 +190,7 @@ void *GlobalData::ZMQSocket(SocketTypes st)
 
   DEBUG_OUTPUT("Creating {} socket {}", st, socket);
 
-  ApplySocketDefaults(socket, st);
+  ApplySocketOptions(socket, st);
 
   return socket;
 }
@@ -128,6 +212,204 @@ bool GlobalData::HasSocket(SocketTypes st)
   return socketData.m_zmq_socket != nullptr;
 }
 
+void GlobalData::ApplySocketOptions(void *socket, SocketTypes st)
+{
+  ApplySocketDefaults(socket, st);
+
+  LockGuard lock(m_settingsMutex);
+
+  if(m_ipv6)
+  {
+    SetIPV6(socket, true);
+  }
+
+  for(const auto &option : m_socketOptions[st])
+  {
+    ::SetSocketOption(socket, option);
+  }
+}
+
+void GlobalData::SetSocketOption(SocketTypes st, const ZeroMQOption &option)
+{
+  LockGuard namedLock(m_namedSocketsMutex);
+  LockGuard lock(GetMutex(st));
+
+  // most options only apply to later binds and connects
+  if(HasBindsOrConnections(st))
+  {
+    throw IgorException(SOCKET_ALREADY_IN_USE);
+  }
+
+  for(const auto &[key, data] : m_namedSockets)
+  {
+    LockGuard socketLock(data->m_socketData.m_mutex);
+
+    if(key.first == st && !data->m_socketData.m_list.empty())
+    {
+      throw IgorException(SOCKET_ALREADY_IN_USE);
+    }
+  }
+
+  if(HasSocket(st))
+  {
+    ::SetSocketOption(GetSocketTypeData(st).m_zmq_socket, option);
+  }
+
+  for(const auto &[key, data] : m_namedSockets)
+  {
+    LockGuard socketLock(data->m_socketData.m_mutex);
+
+    if(key.first == st)
+    {
+      ::SetSocketOption(data->m_socketData.m_zmq_socket, option);
+    }
+  }
+
+  LockGuard settingsLock(m_settingsMutex);
+
+  auto &options = m_socketOptions[st];
+
+  auto it = std::find_if(options.begin(), options.end(),
+                         [&option](const ZeroMQOption &entry)
+                         { return entry.option == option.option; });
+
+  if(it == options.end())
+  {
+    options.push_back(option);
+  }
+  else
+  {
+    *it = option;
+  }
+}
+
+void GlobalData::SetContextOption(const ZeroMQOption &option)
+{
+  LockGuard lock(m_namedSocketsMutex);
+
+  for(auto st : GetAllSocketTypes())
+  {
+    if(HasBindsOrConnections(st))
+    {
+      throw IgorException(SOCKET_ALREADY_IN_USE);
+    }
+  }
+
+  if(!m_namedSockets.empty() || m_numInternalSockets > 0)
+  {
+    throw IgorException(SOCKET_ALREADY_IN_USE);
+  }
+
+  {
+    // subscriptions would be lost with the socket
+    LockGuard subLock(GetMutex(SocketTypes::Subscriber));
+
+    if(!m_subMessageFilters.empty())
+    {
+      throw IgorException(SOCKET_ALREADY_IN_USE);
+    }
+  }
+
+  // unused sockets, e.g. from zeromq_set, belong to the old context, they
+  // are recreated on demand with the stored options
+  for(auto st : GetAllSocketTypes())
+  {
+    LockGuard socketLock(GetMutex(st));
+
+    if(HasSocket(st))
+    {
+      CloseSocket(GetSocketTypeData(st), st);
+    }
+  }
+
+  auto options = m_contextOptions;
+  options.push_back(option);
+
+  // the IO threads are started with the first socket and keep their
+  // settings, so start over with a fresh context
+  auto context = CreateContext(options);
+
+  auto rc = zmq_ctx_term(zmq_context);
+  ZEROMQ_ASSERT(rc == 0);
+
+  zmq_context      = context;
+  m_contextOptions = options;
+}
+
+void *GlobalData::CreateInternalSocket(int type)
+{
+  LockGuard lock(m_namedSocketsMutex);
+
+  auto socket = zmq_socket(zmq_context, type);
+  ZEROMQ_ASSERT(socket != nullptr);
+
+  int valZero     = 0;
+  int valOne      = 1;
+  int valInfinite = -1;
+
+  auto rc = zmq_setsockopt(socket, ZMQ_LINGER, &valInfinite,
+                           sizeof(valInfinite));
+  ZEROMQ_ASSERT(rc == 0);
+
+  rc = zmq_setsockopt(socket, ZMQ_SNDTIMEO, &valZero, sizeof(valZero));
+  ZEROMQ_ASSERT(rc == 0);
+
+  rc = zmq_setsockopt(socket, ZMQ_RCVTIMEO, &valOne, sizeof(valOne));
+  ZEROMQ_ASSERT(rc == 0);
+
+  m_numInternalSockets++;
+
+  DEBUG_OUTPUT("Creating internal socket {} of type {}", socket, type);
+
+  return socket;
+}
+
+void *GlobalData::CreateInternalSocket(SocketTypes st)
+{
+  LockGuard lock(m_namedSocketsMutex);
+
+  auto socket = zmq_socket(zmq_context, GetZeroMQSocketConstant(st));
+  ZEROMQ_ASSERT(socket != nullptr);
+
+  ApplySocketOptions(socket, st);
+
+#if !HAVE_THREADSAFE_SOCKETS
+  if(st == SocketTypes::Client)
+  {
+    // a router drops peers with an identity already in use, e.g. the one of
+    // the client socket connected to the same server
+    const auto identity =
+        fmt::format("zeromq xop: dealer {}", ++m_lastInternalSocketId);
+    auto rc = zmq_setsockopt(socket, ZMQ_IDENTITY, identity.c_str(),
+                             identity.length());
+    ZEROMQ_ASSERT(rc == 0);
+  }
+#endif
+
+  m_numInternalSockets++;
+
+  DEBUG_OUTPUT("Creating internal {} socket {}", st, socket);
+
+  return socket;
+}
+
+void GlobalData::CloseInternalSocket(void *socket)
+{
+  LockGuard lock(m_namedSocketsMutex);
+
+  ASSERT(m_numInternalSockets > 0);
+
+  auto rc = zmq_close(socket);
+  ZEROMQ_ASSERT(rc == 0);
+
+  m_numInternalSockets--;
+}
+
+void InternalSocketDeleter::operator()(void *socket) const
+{
+  GlobalData::Instance().CloseInternalSocket(socket);
+}
+
 void GlobalData::SetDebugFlag(bool val)
 {
   LockGuard lock(m_settingsMutex);
@@ -154,8 +436,37 @@ bool GlobalData::GetRecvBusyWaitingFlag() const
   return m_busyWaiting;
 }
 
+void GlobalData::SetIPV6Flag(bool val)
+{
+  {
+    LockGuard lock(m_settingsMutex);
+
+    DEBUG_OUTPUT("new value={}", val);
+    m_ipv6 = val;
+  }
+
+  // new sockets get it in ApplySocketOptions()
+  for(auto st : GetAllSocketTypes())
+  {
+    LockGuard socketLock(GetMutex(st));
+
+    if(HasSocket(st))
+    {
+      SetIPV6(GetSocketTypeData(st).m_zmq_socket, val);
+    }
+  }
+}
+
 void GlobalData::CloseConnections()
 {
+  {
+    LockGuard lock(m_settingsMutex);
+    m_pubCompression.clear();
+    m_subCompression.clear();
+    m_socketOptions.clear();
+    m_ipv6 = false;
+  }
+
   if(HasSocket(SocketTypes::Subscriber))
   {
     RemoveSubscriberMessageFilter("");
@@ -170,44 +481,58 @@ void GlobalData::CloseConnections()
       continue;
     }
 
-    auto &socketData = GetSocketTypeData(st);
-    auto &list       = socketData.m_list;
+    CloseSocket(GetSocketTypeData(st), st);
+  }
 
-    DEBUG_OUTPUT("SocketType {}, Connections={}", st, list.size());
+  LockGuard lock(m_namedSocketsMutex);
 
-    try
-    {
-      GET_SOCKET(socket, st);
+  for(auto &[key, data] : m_namedSockets)
+  {
+    LockGuard socketLock(data->m_socketData.m_mutex);
 
-      for(const auto &conn : list)
-      {
-        int rc = 0;
-        switch(st)
-        {
-        case SocketTypes::Server:
-        case SocketTypes::Publisher:
-          rc = zmq_unbind(socket.get(), conn.c_str());
-          DEBUG_OUTPUT("zmq_disconnect({}) returned={}", conn, rc);
-
-          break;
-        case SocketTypes::Client:
-        case SocketTypes::Subscriber:
-          rc = zmq_disconnect(socket.get(), conn.c_str());
-          DEBUG_OUTPUT("zmq_unbind({}) returned={}", conn, rc);
-          break;
-        }
-        // ignore errors
-      }
-      list.clear();
+    DEBUG_OUTPUT("Name {}", key.second);
+    CloseSocket(data->m_socketData, key.first);
+  }
 
-      auto rc = zmq_close(socket.get());
-      ZEROMQ_ASSERT(rc == 0);
-      socketData.m_zmq_socket = nullptr;
-    }
-    catch(...)
+  m_namedSockets.clear();
+}
+
+void GlobalData::CloseSocket(SocketTypeData &socketData, SocketTypes st)
+{
+  auto &list   = socketData.m_list;
+  void *socket = socketData.m_zmq_socket;
+
+  DEBUG_OUTPUT("SocketType {}, Connections={}", st, list.size());
+
+  try
+  {
+    for(const auto &conn : list)
     {
+      int rc = 0;
+      switch(st)
+      {
+      case SocketTypes::Server:
+      case SocketTypes::Publisher:
+        rc = zmq_unbind(socket, conn.c_str());
+        DEBUG_OUTPUT("zmq_unbind({}) returned={}", conn, rc);
+        break;
+      case SocketTypes::Client:
+      case SocketTypes::Subscriber:
+        rc = zmq_disconnect(socket, conn.c_str());
+        DEBUG_OUTPUT("zmq_disconnect({}) returned={}", conn, rc);
+        break;
+      }
       // ignore errors
     }
+    list.clear();
+
+    auto rc = zmq_close(socket);
+    ZEROMQ_ASSERT(rc == 0);
+    socketData.m_zmq_socket = nullptr;
+  }
+  catch(...)
+  {
+    // ignore errors
   }
 }
 
@@ -360,6 +685,9 @@ void GlobalData::RemoveSubscriberMessageFilter(const std::string &filter)
       unsubscribe(entry);
     }
     m_subMessageFilters.clear();
+
+    LockGuard settingsLock(m_settingsMutex);
+    m_subCompression.clear();
   }
   else
   {
@@ -373,9 +701,91 @@ void GlobalData::RemoveSubscriberMessageFilter(const std::string &filter)
 
     unsubscribe(filter);
     m_subMessageFilters.erase(it);
+
+    LockGuard settingsLock(m_settingsMutex);
+    m_subCompression.erase(filter);
   }
 }
 
+bool GlobalData::HasSubscriberMessageFilter(const std::string &filter)
+{
+  LockGuard lock(GetMutex(SocketTypes::Subscriber));
+
+  return std::find(std::begin(m_subMessageFilters),
+                   std::end(m_subMessageFilters),
+                   filter) != std::end(m_subMessageFilters);
+}
+
+void GlobalData::SetPublisherCompression(const std::string &filter,
+                                         const CompressionSettings &settings)
+{
+  LockGuard lock(m_settingsMutex);
+
+  DEBUG_OUTPUT("filter={}, method={}, threshold={}", filter,
+               GetCompressionMethodString(settings.method), settings.threshold);
+
+  if(settings.method == CompressionMethod::None)
+  {
+    m_pubCompression.erase(filter);
+    return;
+  }
+
+  m_pubCompression[filter] = settings;
+}
+
+void GlobalData::SetSubscriberCompression(const std::string &filter,
+                                          bool enable)
+{
+  LockGuard lock(m_settingsMutex);
+
+  DEBUG_OUTPUT("filter={}, enable={}", filter, enable);
+
+  if(enable)
+  {
+    m_subCompression.insert(filter);
+  }
+  else
+  {
+    m_subCompression.erase(filter);
+  }
+}
+
+bool GlobalData::HasSubscriberCompression(const std::string &topic)
+{
+  LockGuard lock(m_settingsMutex);
+
+  return std::any_of(m_subCompression.begin(), m_subCompression.end(),
+                     [&topic](const std::string &prefix)
+                     { return topic.compare(0, prefix.size(), prefix) == 0; });
+}
+
+CompressionSettings
+GlobalData::GetPublisherCompression(const std::string &filter)
+{
+  LockGuard lock(m_settingsMutex);
+
+  CompressionSettings result;
+  size_t longestMatch = 0;
+  bool found          = false;
+
+  for(const auto &[prefix, settings] : m_pubCompression)
+  {
+    if(filter.compare(0, prefix.size(), prefix) != 0)
+    {
+      continue;
+    }
+
+    if(!found || prefix.size() > longestMatch)
+    {
+      result       = settings;
+      longestMatch = prefix.size();
+      found        = true;
+    }
+  }
+
+  return result;
+}
+
 std::recursive_mutex &GlobalData::GetMutex(SocketTypes st)
 {
   switch(st)
@@ -409,3 +819,209 @@ GlobalData::SocketTypeData &GlobalData::GetSocketTypeData(SocketTypes st)
 
   ASSERT(0);
 }
+
+void *GlobalData::ZMQSocket(SocketTypes st, const std::string &name)
+{
+  if(name.empty())
+  {
+    return ZMQSocket(st);
+  }
+
+  return GetNamedSocketData(st, name)->m_socketData.m_zmq_socket;
+}
+
+bool GlobalData::HasBindsOrConnections(SocketTypes st, const std::string &name)
+{
+  if(name.empty())
+  {
+    return HasBindsOrConnections(st);
+  }
+
+  const auto data  = GetNamedSocketData(st, name);
+  auto &socketData = data->m_socketData;
+  LockGuard lock(socketData.m_mutex);
+
+  return !socketData.m_list.empty();
+}
+
+void GlobalData::AddToListOfBindsOrConnections(const std::string &point,
+                                               SocketTypes st,
+                                               const std::string &name)
+{
+  if(name.empty())
+  {
+    AddToListOfBindsOrConnections(point, st);
+    return;
+  }
+
+  const auto data  = GetNamedSocketData(st, name);
+  auto &socketData = data->m_socketData;
+  LockGuard lock(socketData.m_mutex);
+
+  socketData.m_list.push_back(point);
+}
+
+void *GlobalData::LockSocket(SocketTypes st, const std::string &name,
+                             std::shared_ptr<std::recursive_mutex> &mutex,
+                             std::unique_lock<std::recursive_mutex> &lock)
+{
+  if(name.empty())
+  {
+    // not owning, the mutexes of the default sockets live as long as we do
+    mutex = std::shared_ptr<std::recursive_mutex>(std::shared_ptr<void>(),
+                                                  &GetMutex(st));
+    lock  = std::unique_lock<std::recursive_mutex>(*mutex);
+
+    return ZMQSocket(st);
+  }
+
+  const auto data  = GetNamedSocketData(st, name);
+  auto &socketData = data->m_socketData;
+
+  mutex = std::shared_ptr<std::recursive_mutex>(data, &socketData.m_mutex);
+  lock  = std::unique_lock<std::recursive_mutex>(*mutex);
+
+  // closed after the lookup
+  if(socketData.m_zmq_socket == nullptr)
+  {
+    throw IgorException(GetUnknownNameError(st));
+  }
+
+  return socketData.m_zmq_socket;
+}
+
+void GlobalData::CreateServer(const std::string &name,
+                              const ServerSettings &settings)
+{
+  auto data              = std::make_shared<NamedSocketData>();
+  data->m_serverSettings = settings;
+
+  LockGuard lock(m_namedSocketsMutex);
+
+  auto socket = AddNamedSocket(SocketTypes::Server, name, std::move(data));
+
+  DEBUG_OUTPUT("Creating server {} with socket {}, maxMessageSize={}, "
+               "priority={}, requestsPerIdle={}",
+               name, socket, settings.maxMessageSize, settings.priority,
+               settings.requestsPerIdle);
+
+  SetMaxMessageSize(socket, settings.maxMessageSize);
+}
+
+ServerSettings GlobalData::GetServerSettings(const std::string &name)
+{
+  if(name.empty())
+  {
+    return {};
+  }
+
+  LockGuard lock(m_namedSocketsMutex);
+
+  return GetNamedSocketData(SocketTypes::Server, name)->m_serverSettings;
+}
+
+void GlobalData::CreatePublisherChannel(const std::string &name,
+                                        const PublisherSettings &settings)
+{
+  auto data                 = std::make_shared<NamedSocketData>();
+  data->m_publisherSettings = settings;
+
+  LockGuard lock(m_namedSocketsMutex);
+
+  auto socket = AddNamedSocket(SocketTypes::Publisher, name, std::move(data));
+
+  DEBUG_OUTPUT("Creating publisher channel {} with socket {}, "
+               "highWaterMark={}",
+               name, socket, settings.highWaterMark);
+
+  auto rc = zmq_setsockopt(socket, ZMQ_SNDHWM, &settings.highWaterMark,
+                           sizeof(settings.highWaterMark));
+  ZEROMQ_ASSERT(rc == 0);
+}
+
+PublisherSettings GlobalData::GetPublisherSettings(const std::string &name)
+{
+  if(name.empty())
+  {
+    return {};
+  }
+
+  LockGuard lock(m_namedSocketsMutex);
+
+  return GetNamedSocketData(SocketTypes::Publisher, name)->m_publisherSettings;
+}
+
+void GlobalData::CloseNamedSocket(SocketTypes st, const std::string &name)
+{
+  LockGuard lock(m_namedSocketsMutex);
+
+  auto it = m_namedSockets.find({st, name});
+
+  if(it == m_namedSockets.end())
+  {
+    throw IgorException(GetUnknownNameError(st));
+  }
+
+  {
+    auto &socketData = it->second->m_socketData;
+    LockGuard socketLock(socketData.m_mutex);
+
+    CloseSocket(socketData, st);
+  }
+
+  m_namedSockets.erase(it);
+}
+
+bool GlobalData::HasNamedSocket(SocketTypes st, const std::string &name)
+{
+  if(name.empty())
+  {
+    return true;
+  }
+
+  LockGuard lock(m_namedSocketsMutex);
+
+  return m_namedSockets.find({st, name}) != m_namedSockets.end();
+}
+
+void *GlobalData::AddNamedSocket(SocketTypes st, const std::string &name,
+                                 std::shared_ptr<NamedSocketData> data)
+{
+  if(name.empty())
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  LockGuard lock(m_namedSocketsMutex);
+
+  if(m_namedSockets.find({st, name}) != m_namedSockets.end())
+  {
+    throw IgorException(GetDuplicatedNameError(st));
+  }
+
+  void *&socket = data->m_socketData.m_zmq_socket;
+
+  socket = zmq_socket(zmq_context, GetZeroMQSocketConstant(st));
+  ZEROMQ_ASSERT(socket != nullptr);
+
+  ApplySocketOptions(socket, st);
+
+  m_namedSockets.emplace(NamedSocketKey{st, name}, std::move(data));
+
+  return socket;
+}
+
+std::shared_ptr<GlobalData::NamedSocketData>
+GlobalData::GetNamedSocketData(SocketTypes st, const std::string &name)
+{
+  LockGuard lock(m_namedSocketsMutex);
+
+  auto it = m_namedSockets.find({st, name});
+
+  if(it == m_namedSockets.end())
+  {
+    throw IgorException(GetUnknownNameError(st));
+  }
+
+  return it->second;
+}
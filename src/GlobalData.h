@@ -2,9 +2,13 @@
 
 #include <mutex>
 #include <memory>
+#include <map>
+#include <set>
 #include "Logging.h"
 #include "ConcurrentQueue.h"
 #include "ConcurrentXOPNotice.h"
+#include "Compression.h"
+#include "SocketOptions.h"
 
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
@@ -21,6 +25,46 @@ using AllSocketTypesArray = std::array<SocketTypes, 4>;
 
 AllSocketTypesArray GetAllSocketTypes();
 
+/// @brief Convert a socket type name (`client`, `server`, `publisher` or
+/// `subscriber`) to its enumeration
+///
+/// @return true on success, false for unknown names
+bool ParseSocketType(const std::string &name, SocketTypes &st);
+
+/// Name of the server used by the `zeromq_server_*` and `zeromq_handler_*`
+/// functions
+const std::string DEFAULT_SERVER_NAME;
+
+/// Name of the publisher channel used by the `zeromq_pub_*` functions and the
+/// heartbeat
+const std::string DEFAULT_PUB_CHANNEL_NAME;
+
+const int64_t DEFAULT_MAX_MESSAGE_SIZE = 1024;
+
+/// @brief Settings of a server instance
+///
+/// The queued requests of all servers are processed in the order of
+/// decreasing priority during IDLE events. A server with a positive
+/// `requestsPerIdle` only gets that many requests processed per IDLE event so
+/// that bulk requests can not starve the other servers.
+struct ServerSettings
+{
+  int64_t maxMessageSize{DEFAULT_MAX_MESSAGE_SIZE}; // -1 means unlimited
+  int priority{};
+  size_t requestsPerIdle{}; // 0 means unlimited
+};
+
+/// Default of ZMQ_SNDHWM in libzmq
+const int DEFAULT_PUB_HIGH_WATER_MARK = 1000;
+
+/// @brief Settings of a publisher channel
+///
+/// The optional send queue of a channel is managed by PublisherSender.
+struct PublisherSettings
+{
+  int highWaterMark{DEFAULT_PUB_HIGH_WATER_MARK}; // 0 means unlimited
+};
+
 class GlobalData
 {
 public:
@@ -32,7 +76,9 @@ public:
   }
 
   void *ZMQSocket(SocketTypes st);
+  void *ZMQSocket(SocketTypes st, const std::string &name);
   bool HasBindsOrConnections(SocketTypes st);
+  bool HasBindsOrConnections(SocketTypes st, const std::string &name);
 
   void SetDebugFlag(bool val);
   bool GetDebugFlag() const;
@@ -40,13 +86,52 @@ public:
   void SetRecvBusyWaitingFlag(bool val);
   bool GetRecvBusyWaitingFlag() const;
 
+  /// @brief Enable IPv6 for all sockets
+  ///
+  /// Applies to the existing sockets and to all sockets created later. Reset
+  /// by CloseConnections().
+  void SetIPV6Flag(bool val);
+
   void CloseConnections();
   void AddToListOfBindsOrConnections(const std::string &localPoint,
                                      SocketTypes st);
+  void AddToListOfBindsOrConnections(const std::string &localPoint,
+                                     SocketTypes st, const std::string &name);
   ConcurrentQueue<OutputMessagePtr> &GetXOPNoticeQueue();
 
   std::recursive_mutex &GetMutex(SocketTypes st);
 
+  /// @brief Lock the mutex of the socket and return the socket
+  ///
+  /// The socket is only read with its mutex locked, so that it can not be
+  /// closed in between. `mutex` keeps the mutex of a named socket valid even if
+  /// the socket is closed meanwhile. The default socket of the type is created
+  /// on first use, closed named sockets throw as unknown ones.
+  void *LockSocket(SocketTypes st, const std::string &name,
+                   std::shared_ptr<std::recursive_mutex> &mutex,
+                   std::unique_lock<std::recursive_mutex> &lock);
+
+  /// @name Named sockets
+  ///
+  /// Named servers and publisher channels have their own socket, the empty
+  /// name refers to the socket of the socket type.
+  /// @{
+  void CreateServer(const std::string &name, const ServerSettings &settings);
+  ServerSettings GetServerSettings(const std::string &name);
+
+  void CreatePublisherChannel(const std::string &name,
+                              const PublisherSettings &settings);
+  PublisherSettings GetPublisherSettings(const std::string &name);
+
+  /// @brief Unbind and close a named socket
+  ///
+  /// Threads using the socket must have been stopped before.
+  void CloseNamedSocket(SocketTypes st, const std::string &name);
+
+  /// Return true for the empty name and existing named sockets
+  bool HasNamedSocket(SocketTypes st, const std::string &name);
+  /// @}
+
   void SetLoggingFlag(bool val);
   bool GetLoggingFlag() const;
 
@@ -64,6 +149,56 @@ public:
 
   void RemoveSubscriberMessageFilter(const std::string &filter);
 
+  bool HasSubscriberMessageFilter(const std::string &filter);
+
+  /// @brief Set the compression settings for published messages whose filter
+  /// starts with `filter`, CompressionMethod::None removes the entry
+  void SetPublisherCompression(const std::string &filter,
+                               const CompressionSettings &settings);
+
+  /// @brief Return the compression settings for the given message filter
+  ///
+  /// The longest matching prefix wins.
+  CompressionSettings GetPublisherCompression(const std::string &filter);
+
+  /// @brief Enable or disable decompression for the subscription filter
+  void SetSubscriberCompression(const std::string &filter, bool enable);
+
+  /// @brief Return true if the frames of messages with the given topic can
+  /// be compressed, i.e. one of the enabled filters is a prefix of it
+  bool HasSubscriberCompression(const std::string &topic);
+
+  /// @brief Set the option for all sockets of the given type
+  ///
+  /// Applies to the existing sockets, including named ones, and to all
+  /// sockets created later. The options are reset by CloseConnections().
+  /// Throws if a socket of the type is already bound or connected.
+  void SetSocketOption(SocketTypes st, const ZeroMQOption &option);
+
+  /// @brief Set the context option
+  ///
+  /// The context is recreated for the options to take effect, which requires
+  /// that no socket is bound or connected and that there are neither named
+  /// nor internal sockets. Unused sockets are closed and recreated on demand.
+  /// The options are kept until the XOP is unloaded.
+  void SetContextOption(const ZeroMQOption &option);
+
+  /// @brief Create a socket for internal use, e.g. inproc forwarding
+  ///
+  /// The socket does not block on sending, waits one millisecond on receiving
+  /// and lingers until all messages are delivered. It must be closed with
+  /// CloseInternalSocket().
+  void *CreateInternalSocket(int type);
+
+  /// @brief Create an unnamed socket of the given type for internal use
+  ///
+  /// Unlike ZMQSocket() every call returns a new socket with its own
+  /// connections, but with the same default and user set options. Client
+  /// sockets get a unique identity. It must be closed with
+  /// CloseInternalSocket().
+  void *CreateInternalSocket(SocketTypes st);
+  void CloseInternalSocket(void *socket);
+
 private:
   GlobalData();
   ~GlobalData()                             = default;
@@ -77,24 +212,64 @@ private:
     std::recursive_mutex m_mutex;
   };
 
+  struct NamedSocketData
+  {
+    SocketTypeData m_socketData;
+    ServerSettings m_serverSettings;       // SocketTypes::Server only
+    PublisherSettings m_publisherSettings; // SocketTypes::Publisher only
+  };
+
+  using NamedSocketKey = std::pair<SocketTypes, std::string>;
+
   bool HasSocket(SocketTypes st);
 
+  /// Apply the default and user set options to a new socket
+  void ApplySocketOptions(void *socket, SocketTypes st);
+
   SocketTypeData &GetSocketTypeData(SocketTypes st);
 
+  /// Return the entry of the named socket, the caller shares its ownership
+  /// as the socket can be closed concurrently
+  std::shared_ptr<NamedSocketData> GetNamedSocketData(SocketTypes st,
+                                                      const std::string &name);
+
+  /// Create the socket of data and take ownership
+  void *AddNamedSocket(SocketTypes st, const std::string &name,
+                       std::shared_ptr<NamedSocketData> data);
+
+  static void CloseSocket(SocketTypeData &socketData, SocketTypes st);
+
   SocketTypeData m_client, m_server, m_pub, m_sub;
+  std::map<NamedSocketKey, std::shared_ptr<NamedSocketData>> m_namedSockets;
+  std::recursive_mutex m_namedSocketsMutex;
   std::recursive_mutex m_settingsMutex;
 
   bool m_debugging;
   bool m_busyWaiting;
   bool m_logging;
+  bool m_ipv6{}; // protected by m_settingsMutex
 
   ConcurrentQueue<OutputMessagePtr> m_queue;
   std::unique_ptr<Logging> m_loggingSink;
   std::recursive_mutex m_loggingLock;
   void *zmq_context;
   std::vector<std::string> m_subMessageFilters;
+  std::map<std::string, CompressionSettings> m_pubCompression;
+  std::set<std::string> m_subCompression;
+  std::map<SocketTypes, ZeroMQOptionVec> m_socketOptions;
+  ZeroMQOptionVec m_contextOptions;
+  size_t m_numInternalSockets{};     // protected by m_namedSocketsMutex
+  uint64_t m_lastInternalSocketId{}; // protected by m_namedSocketsMutex
 };
 
+/// Closes the socket with GlobalData::CloseInternalSocket()
+struct InternalSocketDeleter
+{
+  void operator()(void *socket) const;
+};
+
+using InternalSocketPtr = std::unique_ptr<void, InternalSocketDeleter>;
+
 template <>
 struct fmt::formatter<SocketTypes> : fmt::formatter<std::string>
 {
@@ -1,8 +1,10 @@
 #include "ZeroMQ.h"
 #include "HeartbeatPublisher.h"
+#include "MessageHandler.h"
 #include "RequestInterface.h"
 
 #include <chrono>
+#include <condition_variable>
 #include <thread>
 
 // This file is part of the `ZeroMQ-XOP` project and licensed under
@@ -11,42 +13,79 @@
 namespace
 {
 
-using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
 std::recursive_mutex threadMutex;
 bool threadShouldFinish;
-std::recursive_mutex threadShouldFinishMutex;
+std::mutex threadShouldFinishMutex;
+std::condition_variable threadShouldFinishCondition;
 
-void WorkerThread()
-{
-  DEBUG_OUTPUT("Begin");
+// protected by threadShouldFinishMutex
+std::chrono::milliseconds interval = DEFAULT_HEARTBEAT_INTERVAL;
+Clock::time_point nextHeartbeat;
 
-  {
-    // initialize to false
-    LockGuard lock(threadShouldFinishMutex);
-    threadShouldFinish = false;
-  }
+/// Wait until the next heartbeat is due
+///
+/// @return false if the thread should finish
+bool WaitForNextHeartbeat()
+{
+  std::unique_lock<std::mutex> lock(threadShouldFinishMutex);
 
   for(;;)
   {
-    try
+    if(threadShouldFinish)
     {
-      // check if stop is requested
+      return false;
+    }
+
+    const auto now = Clock::now();
+
+    if(now >= nextHeartbeat)
+    {
+      nextHeartbeat += interval;
+
+      // skip missed heartbeats instead of sending them in a burst
+      if(nextHeartbeat <= now)
       {
-        LockGuard lock(threadShouldFinishMutex);
-        if(threadShouldFinish)
-        {
-          DEBUG_OUTPUT("Exiting");
-          break;
-        }
+        nextHeartbeat = now + interval;
       }
 
+      return true;
+    }
+
+    // woken up early on stop and interval changes
+    threadShouldFinishCondition.wait_until(lock, nextHeartbeat);
+  }
+}
+
+std::string GetHeartbeatPayload(uint64_t sequence)
+{
+  const std::chrono::duration<double> timestamp =
+      Clock::now().time_since_epoch();
+
+  auto doc         = MessageHandler::Instance().GetHealthInformation();
+  doc["timestamp"] = timestamp.count();
+  doc["sequence"]  = sequence;
+
+  return doc.dump();
+}
+
+void WorkerThread()
+{
+  DEBUG_OUTPUT("Begin");
+
+  for(uint64_t sequence = 0; WaitForNextHeartbeat();)
+  {
+    try
+    {
       if(GlobalData::Instance().HasBindsOrConnections(SocketTypes::Publisher))
       {
         SendStorageVec sendStorage;
         sendStorage.emplace_back(SendStorage{"heartbeat"});
-        sendStorage.emplace_back(SendStorage{""});
+        sendStorage.emplace_back(SendStorage{GetHeartbeatPayload(sequence++)});
 
-        auto rc = ZeroMQPublisherSend(sendStorage);
+        auto rc = ZeroMQPublisherSend(DEFAULT_PUB_CHANNEL_NAME,
+                                      std::move(sendStorage));
 
         if(rc)
         {
@@ -54,9 +93,24 @@ void WorkerThread()
               "Error sending heartbeat publisher message with rc = {}", rc);
           continue;
         }
-      }
 
-      std::this_thread::sleep_for(5s);
+        if(MetricsRegistry::Instance().IsEnabled())
+        {
+          sendStorage.clear();
+          sendStorage.emplace_back(SendStorage{"stats"});
+          sendStorage.emplace_back(
+              SendStorage{MetricsRegistry::Instance().ToJSON().dump()});
+
+          rc = ZeroMQPublisherSend(DEFAULT_PUB_CHANNEL_NAME,
+                                   std::move(sendStorage));
+
+          if(rc)
+          {
+            EMERGENCY_OUTPUT(
+                "Error sending stats publisher message with rc = {}", rc);
+          }
+        }
+      }
     }
     catch(const IgorException &e)
     {
@@ -75,6 +129,8 @@ void WorkerThread()
       EMERGENCY_OUTPUT("Caught exception. This must NOT happen!");
     }
   }
+
+  DEBUG_OUTPUT("Exiting");
 }
 
 } // anonymous namespace
@@ -91,6 +147,12 @@ void HeartbeatPublisher::Start()
 
   DEBUG_OUTPUT("Trying to start.");
 
+  {
+    std::lock_guard<std::mutex> innerLock(threadShouldFinishMutex);
+    threadShouldFinish = false;
+    nextHeartbeat      = Clock::now();
+  }
+
   auto t = std::thread(WorkerThread);
   m_thread.swap(t);
 }
@@ -107,13 +169,41 @@ void HeartbeatPublisher::Stop()
   DEBUG_OUTPUT("Shutting down.");
 
   {
-    LockGuard innerLock(threadShouldFinishMutex);
+    std::lock_guard<std::mutex> innerLock(threadShouldFinishMutex);
     threadShouldFinish = true;
   }
 
+  threadShouldFinishCondition.notify_all();
+
   m_thread.join();
 }
 
+void HeartbeatPublisher::SetInterval(std::chrono::milliseconds newInterval)
+{
+  ASSERT(newInterval >= MINIMUM_HEARTBEAT_INTERVAL);
+
+  {
+    std::lock_guard<std::mutex> lock(threadShouldFinishMutex);
+
+    if(newInterval == interval)
+    {
+      return;
+    }
+
+    interval      = newInterval;
+    nextHeartbeat = Clock::now();
+  }
+
+  threadShouldFinishCondition.notify_all();
+}
+
+std::chrono::milliseconds HeartbeatPublisher::GetInterval()
+{
+  std::lock_guard<std::mutex> lock(threadShouldFinishMutex);
+
+  return interval;
+}
+
 HeartbeatPublisher::~HeartbeatPublisher()
 {
   Stop();
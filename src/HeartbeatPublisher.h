@@ -2,9 +2,19 @@
 
 #include "ZeroMQ.h"
 
+#include <chrono>
+
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
 
+const std::chrono::milliseconds DEFAULT_HEARTBEAT_INTERVAL{5000};
+const std::chrono::milliseconds MINIMUM_HEARTBEAT_INTERVAL{10};
+
+/// @brief Publishes `heartbeat` messages with health information
+///
+/// The heartbeats are scheduled on a fixed grid of `interval` so that the
+/// time for sending does not accumulate. Stopping and interval changes wake up
+/// the thread immediately.
 class HeartbeatPublisher
 {
 public:
@@ -18,6 +28,11 @@ public:
   void Start();
   void Stop();
 
+  /// @brief Set the interval, a changed interval triggers an immediate
+  /// heartbeat
+  void SetInterval(std::chrono::milliseconds interval);
+  std::chrono::milliseconds GetInterval();
+
 private:
   HeartbeatPublisher() = default;
   ~HeartbeatPublisher();
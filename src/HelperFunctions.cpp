@@ -1,6 +1,9 @@
 #include "ZeroMQ.h"
 #include "HelperFunctions.h"
 #include "RequestInterface.h"
+#include "PublisherFanIn.h"
+#include "PublisherSender.h"
+#include "SubscriberReceiver.h"
 
 namespace
 {
@@ -19,6 +22,133 @@ ExperimentModification MapOutputModeToExperimentModification(OutputMode mode)
   ASSERT(0);
 }
 
+/// Smaller payloads are copied, as handing over the buffer costs two
+/// allocations and the free callback
+const size_t ZERO_COPY_THRESHOLD = 1024;
+
+void FreeString(void * /* data */, void *hint)
+{
+  delete static_cast<std::string *>(hint);
+}
+
+/// Initialize the message with the payload
+///
+/// Larger payloads are moved into the message, libzmq frees them after
+/// sending, so that they are not copied again.
+void InitMessage(zmq_msg_t *msg, std::string payload)
+{
+  if(payload.size() < ZERO_COPY_THRESHOLD)
+  {
+    auto rc = zmq_msg_init_size(msg, payload.size());
+    ZEROMQ_ASSERT(rc == 0);
+
+    if(!payload.empty())
+    {
+      memcpy(zmq_msg_data(msg), payload.data(), payload.size());
+    }
+
+    return;
+  }
+
+  auto buffer = std::make_unique<std::string>(std::move(payload));
+
+  auto rc = zmq_msg_init_data(msg, buffer->data(), buffer->size(), FreeString,
+                              buffer.get());
+  ZEROMQ_ASSERT(rc == 0);
+
+  // owned by the message now
+  buffer.release();
+}
+
+/// Initialize the message with a copy of the data
+void InitMessage(zmq_msg_t *msg, const void *data, size_t length)
+{
+  auto rc = zmq_msg_init_size(msg, length);
+  ZEROMQ_ASSERT(rc == 0);
+
+  if(length > 0)
+  {
+    memcpy(zmq_msg_data(msg), data, length);
+  }
+}
+
+/// Send the message, it is closed on errors
+int SendFrame(void *socket, zmq_msg_t *msg, int flags)
+{
+  auto rc = zmq_msg_send(msg, socket, flags);
+
+  if(rc < 0)
+  {
+    zmq_msg_close(msg);
+  }
+
+  return rc;
+}
+
+int SendFrame(void *socket, std::string payload, int flags)
+{
+  zmq_msg_t msg;
+  InitMessage(&msg, std::move(payload));
+
+  return SendFrame(socket, &msg, flags);
+}
+
+#if HAVE_THREADSAFE_SOCKETS
+
+/// Routing ids of server sockets are passed around as decimal identity
+/// strings
+void SetIdentityFromRoutingId(zmq_msg_t *identityMsg, uint32_t routingId)
+{
+  const auto identity = std::to_string(routingId);
+
+  auto rc = zmq_msg_close(identityMsg);
+  ZEROMQ_ASSERT(rc == 0);
+
+  rc = zmq_msg_init_size(identityMsg, identity.size());
+  ZEROMQ_ASSERT(rc == 0);
+
+  memcpy(zmq_msg_data(identityMsg), identity.data(), identity.size());
+}
+
+uint32_t GetRoutingIdFromIdentity(const std::string &identity)
+{
+  if(identity.empty() || identity.size() > 10 ||
+     !std::all_of(identity.begin(), identity.end(),
+                  [](char c) { return c >= '0' && c <= '9'; }))
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  const auto routingId = std::stoull(identity);
+
+  if(routingId == 0 || routingId > std::numeric_limits<uint32_t>::max())
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  return static_cast<uint32_t>(routingId);
+}
+
+/// Send a single frame to the peer with the given routing id
+int SendToRoutingId(void *socket, const std::string &identity,
+                    std::string payload)
+{
+  const auto routingId = GetRoutingIdFromIdentity(identity);
+
+  zmq_msg_t msg;
+  InitMessage(&msg, std::move(payload));
+
+  auto rc = zmq_msg_set_routing_id(&msg, routingId);
+  ZEROMQ_ASSERT(rc == 0);
+
+  rc = SendFrame(socket, &msg, 0);
+  ZEROMQ_ASSERT(rc >= 0);
+
+  return rc;
+}
+
+#endif
+
 } // anonymous namespace
 
 // This file is part of the `ZeroMQ-XOP` project and licensed under
@@ -188,7 +318,9 @@ void ApplyFlags(double flags)
     GlobalData::Instance().SetDebugFlag(false);
     GlobalData::Instance().SetRecvBusyWaitingFlag(true);
     GlobalData::Instance().SetLoggingFlag(false);
-    ToggleIPV6Support(false);
+    MetricsRegistry::Instance().SetEnabled(false);
+    Tracer::Instance().SetEnabled(false);
+    GlobalData::Instance().SetIPV6Flag(false);
     numMatches++;
   }
 
@@ -200,7 +332,7 @@ void ApplyFlags(double flags)
 
   if((val & ZeroMQ_SET_FLAGS::IPV6) == ZeroMQ_SET_FLAGS::IPV6)
   {
-    ToggleIPV6Support(true);
+    GlobalData::Instance().SetIPV6Flag(true);
     numMatches++;
   }
 
@@ -217,6 +349,18 @@ void ApplyFlags(double flags)
     numMatches++;
   }
 
+  if((val & ZeroMQ_SET_FLAGS::METRICS) == ZeroMQ_SET_FLAGS::METRICS)
+  {
+    MetricsRegistry::Instance().SetEnabled(true);
+    numMatches++;
+  }
+
+  if((val & ZeroMQ_SET_FLAGS::TRACING) == ZeroMQ_SET_FLAGS::TRACING)
+  {
+    Tracer::Instance().SetEnabled(true);
+    numMatches++;
+  }
+
   if(!numMatches)
   {
     throw IgorException(
@@ -237,20 +381,6 @@ std::string GetLastEndPoint(void *s)
   return std::string(buf);
 }
 
-void ToggleIPV6Support(bool enable)
-{
-  for(auto st : GetAllSocketTypes())
-  {
-    GET_SOCKET(clientSocket, st);
-
-    DEBUG_OUTPUT("enable={}", enable);
-
-    const int val = enable;
-    auto rc = zmq_setsockopt(clientSocket.get(), ZMQ_IPV6, &val, sizeof(val));
-    ZEROMQ_ASSERT(rc == 0);
-  }
-}
-
 double ConvertStringToDouble(const std::string &str)
 {
   char *lastChar = nullptr;
@@ -259,14 +389,15 @@ double ConvertStringToDouble(const std::string &str)
   return val;
 }
 
-json CallIgorFunctionFromMessage(const std::string &msg)
+json CallIgorFunctionFromMessage(const std::string &msg, std::string binary)
 {
   std::shared_ptr<RequestInterface> req;
   try
   {
     try
     {
-      req = std::make_shared<RequestInterface>(msg);
+      req = std::make_shared<RequestInterface>(DEFAULT_SERVER_NAME, "", msg,
+                                               std::move(binary));
     }
     catch(const std::bad_alloc &)
     {
@@ -290,8 +421,12 @@ json CallIgorFunctionFromReqInterface(const RequestInterfacePtr &req)
       req->CanBeProcessed();
       auto reply = req->Call();
 
-      DEBUG_OUTPUT("Function return value is {:.255s}",
-                   reply.dump(DEFAULT_INDENT));
+      // avoid serializing large replies only for throwing the result away
+      if(GlobalData::Instance().GetDebugFlag())
+      {
+        DEBUG_OUTPUT("Function return value is {:.255s}",
+                     reply.dump(DEFAULT_INDENT));
+      }
 
       GlobalData::Instance().AddLogEntry(reply, req->GetCallerIdentity(),
                                          MessageDirection::Outgoing);
@@ -326,33 +461,46 @@ json CallIgorFunctionFromReqInterface(const RequestInterfacePtr &req)
   }
 }
 
-int ZeroMQClientSend(const std::string &payload)
+int ZeroMQClientSend(std::string payload)
 {
-  GET_SOCKET(socket, SocketTypes::Client);
+  GET_THREADSAFE_SOCKET(socket, SocketTypes::Client);
   const auto payloadLength = payload.length();
 
   DEBUG_OUTPUT("payloadLength={}, socket={}", payloadLength, socket.get());
 
+#if HAVE_THREADSAFE_SOCKETS
+  // payload
+  int rc = SendFrame(socket.get(), std::move(payload), 0);
+  ZEROMQ_ASSERT(rc > 0);
+#else
   // empty
   int rc = zmq_send(socket.get(), nullptr, 0, ZMQ_SNDMORE);
   ZEROMQ_ASSERT(rc == 0);
 
   // payload
-  rc = zmq_send(socket.get(), payload.c_str(), payloadLength, 0);
+  rc = SendFrame(socket.get(), std::move(payload), 0);
   ZEROMQ_ASSERT(rc > 0);
+#endif
 
   DEBUG_OUTPUT("rc={}", rc);
 
   return rc;
 }
 
-int ZeroMQServerSend(const std::string &identity, const std::string &payload)
+int ZeroMQServerSend(const std::string &server, const std::string &identity,
+                     std::string payload)
 {
-  GET_SOCKET(socket, SocketTypes::Server);
+  MEASURE_LATENCY(latency, "send");
+  TraceSpan span("ZeroMQServerSend");
+  GET_THREADSAFE_NAMED_SOCKET(socket, SocketTypes::Server, server);
   const auto payloadLength = payload.length();
 
   DEBUG_OUTPUT("payloadLength={}, socket={}", payloadLength, socket.get());
 
+#if HAVE_THREADSAFE_SOCKETS
+  // payload
+  int rc = SendToRoutingId(socket.get(), identity, std::move(payload));
+#else
   // identity
   int rc =
       zmq_send(socket.get(), identity.c_str(), identity.length(), ZMQ_SNDMORE);
@@ -363,33 +511,130 @@ int ZeroMQServerSend(const std::string &identity, const std::string &payload)
   ZEROMQ_ASSERT(rc == 0);
 
   // payload
-  rc = zmq_send(socket.get(), payload.c_str(), payloadLength, 0);
+  rc = SendFrame(socket.get(), std::move(payload), 0);
   ZEROMQ_ASSERT(rc > 0);
+#endif
 
   DEBUG_OUTPUT("rc={}", rc);
 
+  static auto &sentBytes = MetricsRegistry::Instance().GetCounter("send.bytes");
+  MetricsRegistry::Instance().Count(sentBytes, payloadLength);
+
   return rc;
 }
 
-int ZeroMQPublisherSend(const SendStorageVec &vec)
+int ZeroMQServerSend(const std::string &server, const std::string &identity,
+                     const std::string &header, std::string payload)
 {
-  GET_SOCKET(socket, SocketTypes::Publisher);
-  DEBUG_OUTPUT("socket={}", socket.get());
+  MEASURE_LATENCY(latency, "send");
+  TraceSpan span("ZeroMQServerSend");
+  GET_THREADSAFE_NAMED_SOCKET(socket, SocketTypes::Server, server);
+  const auto payloadLength = payload.length();
+
+  DEBUG_OUTPUT("headerLength={}, payloadLength={}, socket={}", header.length(),
+               payloadLength, socket.get());
+
+#if HAVE_THREADSAFE_SOCKETS
+  // header, a null byte, which JSON can not contain, and the payload in one
+  // frame, so that messages from other threads can not come in between
+  std::string frame;
+  frame.reserve(header.length() + 1 + payloadLength);
+  frame.append(header);
+  frame.push_back('\0');
+  frame.append(payload);
+
+  int rc = SendToRoutingId(socket.get(), identity, std::move(frame));
+#else
+  // identity
+  int rc =
+      zmq_send(socket.get(), identity.c_str(), identity.length(), ZMQ_SNDMORE);
+  ZEROMQ_ASSERT(rc > 0);
+
+  // empty
+  rc = zmq_send(socket.get(), nullptr, 0, ZMQ_SNDMORE);
+  ZEROMQ_ASSERT(rc == 0);
+
+  // header
+  rc = zmq_send(socket.get(), header.c_str(), header.length(), ZMQ_SNDMORE);
+  ZEROMQ_ASSERT(rc > 0);
+
+  // payload, can be empty
+  rc = SendFrame(socket.get(), std::move(payload), 0);
+  ZEROMQ_ASSERT(rc >= 0);
+#endif
+
+  DEBUG_OUTPUT("rc={}", rc);
+
+  static auto &sentBytes = MetricsRegistry::Instance().GetCounter("send.bytes");
+  MetricsRegistry::Instance().Count(sentBytes, payloadLength);
 
+  return rc;
+}
+
+int ZeroMQPublisherSend(const std::string &channel, SendStorageVec vec)
+{
+  if(PublisherSender::Instance().Enqueue(channel, vec) ||
+     PublisherFanIn::Instance().Send(channel, vec))
+  {
+    return 0;
+  }
+
+  return ZeroMQPublisherSendNow(channel, vec);
+}
+
+int ZeroMQPublisherSendNow(const std::string &channel, SendStorageVec &vec)
+{
+  GET_NAMED_SOCKET(socket, SocketTypes::Publisher, channel);
+  DEBUG_OUTPUT("channel={}, socket={}", channel, socket.get());
+
+  return ZeroMQPublisherSendFrames(socket.get(), vec);
+}
+
+int ZeroMQPublisherSendFrames(void *socket, SendStorageVec &vec)
+{
   const auto vecLen = vec.size();
   ASSERT(vecLen >= 2);
 
+  const std::string filter(reinterpret_cast<const char *>(vec[0].GetPtr()),
+                           vec[0].GetLength());
+  const auto compression =
+      GlobalData::Instance().GetPublisherCompression(filter);
+
   int rc = 0;
   for(size_t i = 0; i < vecLen; i++)
   {
     const int flag = i < (vecLen - 1) ? ZMQ_SNDMORE : 0;
 
-    const auto ptr    = vec[i].GetPtr();
-    const auto msgLen = vec[i].GetLength();
+    auto &frame = vec[i];
+    zmq_msg_t msg;
+    std::string compressed;
+
+    // the filter frame must stay readable for the subscriber side filtering,
+    // and it is copied so that the frames are intact if the socket would block
+    if(i > 0 && CompressFrame(compression, frame.GetPtr(), frame.GetLength(),
+                              compressed))
+    {
+      InitMessage(&msg, std::move(compressed));
+    }
+    else if(i > 0 && frame.OwnsData())
+    {
+      InitMessage(&msg, frame.ReleaseData());
+    }
+    else
+    {
+      InitMessage(&msg, frame.GetPtr(), frame.GetLength());
+    }
+
+    DEBUG_OUTPUT("element[{}]: len={}, flag={}", i, zmq_msg_size(&msg), flag);
 
-    DEBUG_OUTPUT("element[{}]: ptr={}, len={}, flag={}", i, ptr, msgLen, flag);
+    rc = SendFrame(socket, &msg, flag);
+
+    // the other frames of a multipart message can not block
+    if(i == 0 && rc < 0 && zmq_errno() == EAGAIN)
+    {
+      return rc;
+    }
 
-    rc = zmq_send(socket.get(), ptr, msgLen, flag);
     ZEROMQ_ASSERT(rc >= 0);
   }
 
@@ -400,9 +645,31 @@ int ZeroMQPublisherSend(const SendStorageVec &vec)
 /// - identity
 /// - empty
 /// - payload
-int ZeroMQServerReceive(zmq_msg_t *identityMsg, zmq_msg_t *payloadMsg)
+/// - binary (optional, only with `binaryMsg`)
+///
+/// or a single payload frame for thread-safe sockets, the identity is then
+/// the routing id. Thread-safe sockets can not send multi-part messages, so
+/// the binary part follows the payload after a null byte in the same frame,
+/// see SplitBinaryPayload().
+int ZeroMQServerReceive(const std::string &server, zmq_msg_t *identityMsg,
+                        zmq_msg_t *payloadMsg, zmq_msg_t *binaryMsg)
 {
-  GET_SOCKET(socket, SocketTypes::Server);
+  GET_THREADSAFE_NAMED_SOCKET(socket, SocketTypes::Server, server);
+
+#if HAVE_THREADSAFE_SOCKETS
+  auto numBytes = zmq_msg_recv(payloadMsg, socket.get(), 0);
+
+  if(numBytes < 0)
+  {
+    return numBytes;
+  }
+
+  // only measure received messages and not the waiting time
+  MEASURE_LATENCY(latency, "receive");
+  TraceSpan span("receive");
+
+  SetIdentityFromRoutingId(identityMsg, zmq_msg_routing_id(payloadMsg));
+#else
   auto numBytes = zmq_msg_recv(identityMsg, socket.get(), 0);
 
   if(numBytes < 0)
@@ -410,6 +677,10 @@ int ZeroMQServerReceive(zmq_msg_t *identityMsg, zmq_msg_t *payloadMsg)
     return numBytes;
   }
 
+  // only measure received messages and not the waiting time
+  MEASURE_LATENCY(latency, "receive");
+  TraceSpan span("receive");
+
   // zeromq guarantees that either all parts in multi-part messages
   // arrive or none.
   if(!zmq_msg_more(identityMsg))
@@ -424,10 +695,41 @@ int ZeroMQServerReceive(zmq_msg_t *identityMsg, zmq_msg_t *payloadMsg)
   }
 
   numBytes = zmq_msg_recv(payloadMsg, socket.get(), 0);
-  if(numBytes < 0 || zmq_msg_more(payloadMsg))
+  if(numBytes < 0 || (zmq_msg_more(payloadMsg) && binaryMsg == nullptr))
   {
     throw IgorException(INVALID_MESSAGE_FORMAT);
   }
+#endif
+
+  static auto &receivedBytes =
+      MetricsRegistry::Instance().GetCounter("receive.bytes");
+  MetricsRegistry::Instance().Count(receivedBytes, To<uint64_t>(numBytes));
+
+  if(binaryMsg == nullptr)
+  {
+    return numBytes;
+  }
+
+  if(!zmq_msg_more(payloadMsg))
+  {
+    // release the binary frame of the previous request
+    auto rc = zmq_msg_close(binaryMsg);
+    ZEROMQ_ASSERT(rc == 0);
+
+    rc = zmq_msg_init(binaryMsg);
+    ZEROMQ_ASSERT(rc == 0);
+
+    return numBytes;
+  }
+
+  auto numBinaryBytes = zmq_msg_recv(binaryMsg, socket.get(), 0);
+  if(numBinaryBytes < 0 || zmq_msg_more(binaryMsg))
+  {
+    throw IgorException(INVALID_MESSAGE_FORMAT);
+  }
+
+  MetricsRegistry::Instance().Count(receivedBytes,
+                                    To<uint64_t>(numBinaryBytes));
 
   return numBytes;
 }
@@ -435,9 +737,11 @@ int ZeroMQServerReceive(zmq_msg_t *identityMsg, zmq_msg_t *payloadMsg)
 /// Expect two frames:
 /// - empty
 /// - payload
+///
+/// or a single payload frame for thread-safe sockets.
 int ZeroMQClientReceive(zmq_msg_t *payloadMsg)
 {
-  GET_SOCKET(socket, SocketTypes::Client);
+  GET_THREADSAFE_SOCKET(socket, SocketTypes::Client);
   auto numBytes = zmq_msg_recv(payloadMsg, socket.get(), 0);
 
   if(numBytes < 0)
@@ -445,6 +749,8 @@ int ZeroMQClientReceive(zmq_msg_t *payloadMsg)
     return numBytes;
   }
 
+#if !HAVE_THREADSAFE_SOCKETS
+
   // zeromq guarantees that either all parts in multi-part messages
   // arrive or none.
   if(!zmq_msg_more(payloadMsg))
@@ -458,18 +764,44 @@ int ZeroMQClientReceive(zmq_msg_t *payloadMsg)
   {
     throw IgorException(INVALID_MESSAGE_FORMAT);
   }
+#endif
 
-  return numBytes;
+  // replies are encoded messages, which never start with the magic number of
+  // a compressed frame, so every frame can be checked on its own
+  DecompressMessageIfRequired(payloadMsg);
+
+  return To<int>(zmq_msg_size(payloadMsg));
+}
+
+bool ZeroMQSubscriberReceive(ZeroMQMessageSharedPtrVec &vec,
+                             bool allowAdditionalFrames)
+{
+  auto &receiver = SubscriberReceiver::Instance();
+
+  if(!receiver.IsRunning())
+  {
+    return ZeroMQSubscriberReceiveNow(vec, allowAdditionalFrames);
+  }
+
+  if(!receiver.Receive(vec))
+  {
+    return false;
+  }
+
+  if(vec.size() > 2 && !allowAdditionalFrames)
+  {
+    throw IgorException(INVALID_MESSAGE_FORMAT);
+  }
+
+  return true;
 }
 
 /// Expect at least two frames:
 /// - filter
 /// - payload
 /// - [optionally, more payload]
-///
-/// Return error code `< 0` or success `0`
-int ZeroMQSubscriberReceive(ZeroMQMessageSharedPtrVec &vec,
-                            bool allowAdditionalFrames)
+bool ZeroMQSubscriberReceiveNow(ZeroMQMessageSharedPtrVec &vec,
+                                bool allowAdditionalFrames)
 {
   vec.resize(0);
 
@@ -481,29 +813,37 @@ int ZeroMQSubscriberReceive(ZeroMQMessageSharedPtrVec &vec,
   auto ret = zmq_msg_recv(filter->get(), socket.get(), 0);
   vec.push_back(filter);
 
-  if(ret < 0)
+  if(ret == -1 && zmq_errno() == EAGAIN) // timeout
   {
-    return ret;
+    return false;
   }
 
+  ZEROMQ_ASSERT(ret >= 0);
+
   if(!zmq_msg_more(filter->get()))
   {
     throw IgorException(INVALID_MESSAGE_FORMAT);
   }
 
+  const auto decompress = GlobalData::Instance().HasSubscriberCompression(
+      CreateStringFromZMsg(filter->get()));
+
   for(;;)
   {
     auto payload = std::make_shared<ZeroMQMessage>();
     ret          = zmq_msg_recv(payload->get(), socket.get(), 0);
     vec.push_back(payload);
 
-    if(ret < 0)
-    {
-      return ret;
-    }
+    // the remaining frames of a multipart message are already there
+    ZEROMQ_ASSERT(ret >= 0);
 
     auto moreData = zmq_msg_more(payload->get());
 
+    if(decompress)
+    {
+      DecompressMessageIfRequired(payload->get());
+    }
+
     if(moreData)
     {
       if(!allowAdditionalFrames)
@@ -517,7 +857,7 @@ int ZeroMQSubscriberReceive(ZeroMQMessageSharedPtrVec &vec,
     }
   }
 
-  return 0;
+  return true;
 }
 
 std::string SerializeDataFolder(DataFolderHandle dataFolderHandle)
@@ -573,6 +913,19 @@ std::string CreateStringFromZMsg(zmq_msg_t *msg)
                      zmq_msg_size(msg));
 }
 
+void SplitBinaryPayload(std::string &payload, std::string &binary)
+{
+  const auto pos = payload.find('\0');
+
+  if(pos == std::string::npos)
+  {
+    return;
+  }
+
+  binary.assign(payload, pos + 1, std::string::npos);
+  payload.resize(pos);
+}
+
 void InitHandle(Handle *handle, size_t size)
 {
   if(*handle == nullptr)
@@ -776,7 +1129,7 @@ int CreateDirectory(const std::string &path)
     return INTERNAL_ERROR;
   }
 #else
-#ifdef MACIGOR
+#if defined(MACIGOR) || defined(XOP_STUB)
   // https://developer.apple.com/library/archive/documentation/System/Conceptual/ManPages_iPhoneOS/man2/mkdir.2.html
   auto ret = mkdir(path.c_str(), 0777);
   if(!ret)
@@ -6,7 +6,7 @@
 #include <sstream>
 #include <iomanip>
 
-#ifdef MACIGOR
+#if defined(MACIGOR) || defined(XOP_STUB)
 #include <sys/stat.h>
 #endif
 
@@ -129,12 +129,13 @@ enum ZeroMQ_SET_FLAGS
   DEBUG                = 2,
   IPV6                 = 4,
   NO_RECV_BUSY_WAITING = 8,
-  LOGGING              = 16
+  LOGGING              = 16,
+  METRICS              = 32,
+  TRACING              = 64
 };
 }
 
 std::string GetLastEndPoint(void *s);
-void ToggleIPV6Support(bool enable);
 
 template <typename T, int withComma>
 struct GetFormatString
@@ -176,22 +177,77 @@ std::string To_stringHighRes(const T val)
 }
 
 double ConvertStringToDouble(const std::string &str);
-json CallIgorFunctionFromMessage(const std::string &msg);
+json CallIgorFunctionFromMessage(const std::string &msg,
+                                 std::string binary = {});
 json CallIgorFunctionFromReqInterface(const RequestInterfacePtr &req);
 
-int ZeroMQClientSend(const std::string &payload);
-int ZeroMQPublisherSend(const SendStorageVec &vec);
-int ZeroMQServerSend(const std::string &identity, const std::string &payload);
+/// @brief Send the payload as client
+///
+/// Larger payloads are moved into the ZeroMQ message without copying.
+int ZeroMQClientSend(std::string payload);
+
+/// @brief Publish the frames on the given channel
+///
+/// Channels with a send thread only queue the frames, channels with thread
+/// sockets send them over the socket of the calling thread.
+int ZeroMQPublisherSend(const std::string &channel, SendStorageVec vec);
+
+/// @brief Publish the frames on the given channel in the calling thread
+int ZeroMQPublisherSendNow(const std::string &channel, SendStorageVec &vec);
+
+/// @brief Compress and send the frames over the socket
+///
+/// Larger frames owning their data are moved into the ZeroMQ messages, so
+/// `vec` must not be sent again.
+///
+/// @return -1 with `zmq_errno() == EAGAIN` if the socket would block, which
+///         is only the case for publisher sockets with `ZMQ_XPUB_NODROP`,
+///         i.e. channels with a send thread. The frames are then intact.
+int ZeroMQPublisherSendFrames(void *socket, SendStorageVec &vec);
+
+/// @brief Send the payload to the peer with the given identity
+///
+/// Larger payloads are moved into the ZeroMQ message without copying.
+int ZeroMQServerSend(const std::string &server, const std::string &identity,
+                     std::string payload);
+int ZeroMQServerSend(const std::string &server, const std::string &identity,
+                     const std::string &header, std::string payload);
 int ZeroMQClientReceive(zmq_msg_t *payloadMsg);
-int ZeroMQSubscriberReceive(ZeroMQMessageSharedPtrVec &vec,
-                            bool allowAdditionalFrames);
-int ZeroMQServerReceive(zmq_msg_t *identityMsg, zmq_msg_t *payloadMsg);
+
+/// @brief Receive the next subscriber message
+///
+/// Reads from the SubscriberReceiver if its thread runs, from the socket
+/// otherwise.
+///
+/// @return true if a message was received, false on timeout
+bool ZeroMQSubscriberReceive(ZeroMQMessageSharedPtrVec &vec,
+                             bool allowAdditionalFrames);
+
+/// @brief Receive the next subscriber message from the socket
+///
+/// @return true if a message was received, false on timeout
+bool ZeroMQSubscriberReceiveNow(ZeroMQMessageSharedPtrVec &vec,
+                                bool allowAdditionalFrames);
+
+/// @brief Receive the next request of the server
+///
+/// @param binaryMsg optional, receives the binary frame following the payload
+///                  or is empty if there is none. Without it additional frames
+///                  are an error.
+int ZeroMQServerReceive(const std::string &server, zmq_msg_t *identityMsg,
+                        zmq_msg_t *payloadMsg, zmq_msg_t *binaryMsg = nullptr);
 
 std::string SerializeDataFolder(DataFolderHandle dataFolderHandle);
 DataFolderHandle DeSerializeDataFolder(const std::string &path);
 
 std::string CreateStringFromZMsg(zmq_msg_t *msg);
 
+/// @brief Move everything after the first null byte of `payload` into `binary`
+///
+/// Used for requests with binary data over thread-safe sockets, JSON can not
+/// contain a null byte.
+void SplitBinaryPayload(std::string &payload, std::string &binary);
+
 void InitHandle(Handle *handle, size_t size);
 void WriteZMsgIntoHandle(Handle *handle, zmq_msg_t *msg);
 
@@ -20,7 +20,7 @@ constexpr std::array<const char *, 4> RESERVED_KEYS = {
 #ifdef WINIGOR
 constexpr const char DIR_SEPARATOR[] = "\\";
 #else
-#ifdef MACIGOR
+#if defined(MACIGOR) || defined(XOP_STUB)
 constexpr const char DIR_SEPARATOR[] = "/";
 #endif // MACIGOR
 #endif // WINIGOR
@@ -0,0 +1,131 @@
+#include "ZeroMQ.h"
+#include "MessageEncoding.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+bool IsMessagePackMap(unsigned char c)
+{
+  // fixmap, map 16 and map 32
+  return (c >= 0x80 && c <= 0x8F) || c == 0xDE || c == 0xDF;
+}
+
+bool IsCBORMap(unsigned char c)
+{
+  // major type 5 with definite or indefinite length
+  return (c >= 0xA0 && c <= 0xBB) || c == 0xBF;
+}
+
+bool HasCBORSelfDescribeTag(const std::string &payload)
+{
+  return payload.size() > 3 && static_cast<unsigned char>(payload[0]) == 0xD9 &&
+         static_cast<unsigned char>(payload[1]) == 0xD9 &&
+         static_cast<unsigned char>(payload[2]) == 0xF7;
+}
+
+} // anonymous namespace
+
+std::string GetMessageEncodingString(MessageEncoding encoding)
+{
+  switch(encoding)
+  {
+  case MessageEncoding::JSON:
+    return "json";
+  case MessageEncoding::MessagePack:
+    return "msgpack";
+  case MessageEncoding::CBOR:
+    return "cbor";
+  }
+
+  ASSERT(0);
+}
+
+MessageEncoding DetectMessageEncoding(const std::string &payload)
+{
+  if(payload.empty())
+  {
+    return MessageEncoding::JSON;
+  }
+
+  const auto first = static_cast<unsigned char>(payload[0]);
+
+  if(IsMessagePackMap(first))
+  {
+    return MessageEncoding::MessagePack;
+  }
+
+  if(IsCBORMap(first) || HasCBORSelfDescribeTag(payload))
+  {
+    return MessageEncoding::CBOR;
+  }
+
+  return MessageEncoding::JSON;
+}
+
+json DecodeMessage(const std::string &payload, MessageEncoding encoding)
+{
+  try
+  {
+    switch(encoding)
+    {
+    case MessageEncoding::JSON:
+      return json::parse(payload);
+    case MessageEncoding::MessagePack:
+      return json::from_msgpack(payload);
+    case MessageEncoding::CBOR:
+      // tags, e.g. the self-describe tag, carry no information for us
+      return json::from_cbor(payload, true, true,
+                             json::cbor_tag_handler_t::ignore);
+    }
+  }
+  catch(const json::exception &)
+  {
+    throw RequestInterfaceException(REQ_INVALID_JSON_OBJECT);
+  }
+
+  ASSERT(0);
+}
+
+std::string EncodeMessage(const json &doc, MessageEncoding encoding)
+{
+  std::string result;
+
+  switch(encoding)
+  {
+  case MessageEncoding::JSON:
+    result = doc.dump();
+    break;
+  case MessageEncoding::MessagePack:
+    json::to_msgpack(doc, result);
+    break;
+  case MessageEncoding::CBOR:
+    json::to_cbor(doc, result);
+    break;
+  }
+
+  return result;
+}
+
+void EncodeMessage(const json &doc, MessageEncoding encoding,
+                   std::ostream &stream)
+{
+  switch(encoding)
+  {
+  case MessageEncoding::JSON:
+    // a width would enable pretty printing
+    stream.width(0);
+    stream << doc;
+    return;
+  case MessageEncoding::MessagePack:
+    json::to_msgpack(doc, stream);
+    return;
+  case MessageEncoding::CBOR:
+    json::to_cbor(doc, stream);
+    return;
+  }
+
+  ASSERT(0);
+}
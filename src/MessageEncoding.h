@@ -0,0 +1,49 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// @brief Binary encodings of requests and replies
+///
+/// Besides JSON text, requests can be encoded as MessagePack or CBOR. The
+/// encoding is detected from the first byte, as a request is always an object:
+/// JSON text starts with `{` or whitespace, a MessagePack map with `0x80` to
+/// `0x8F`, `0xDE` or `0xDF` and a CBOR map with `0xA0` to `0xBB` or `0xBF`,
+/// optionally preceded by the CBOR self-describe tag `0xD9D9F7`. The reply uses
+/// the encoding of the request.
+
+enum class MessageEncoding
+{
+  JSON,
+  MessagePack,
+  CBOR
+};
+
+std::string GetMessageEncodingString(MessageEncoding encoding);
+
+/// @brief Return the encoding of the message from its first byte
+///
+/// Everything not looking like a MessagePack or CBOR map is treated as JSON
+/// text.
+MessageEncoding DetectMessageEncoding(const std::string &payload);
+
+/// @brief Decode the message with the given encoding
+///
+/// Throws a RequestInterfaceException with REQ_INVALID_JSON_OBJECT for
+/// malformed messages.
+json DecodeMessage(const std::string &payload, MessageEncoding encoding);
+
+/// @brief Encode the message with the given encoding
+///
+/// JSON is written without whitespace.
+std::string EncodeMessage(const json &doc, MessageEncoding encoding);
+
+/// @brief Encode the message with the given encoding into the stream
+///
+/// Allows to write the serialized message piece by piece, e.g. into a stream
+/// buffer which sends it in chunks.
+void EncodeMessage(const json &doc, MessageEncoding encoding,
+                   std::ostream &stream);
@@ -2,33 +2,62 @@
 #include "MessageHandler.h"
 #include "RequestInterface.h"
 
+#include <atomic>
 #include <chrono>
 #include <thread>
 
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
 
+struct ServerHandler
+{
+  explicit ServerHandler(std::string serverName)
+      : name(std::move(serverName)),
+        settings(GlobalData::Instance().GetServerSettings(name))
+  {
+  }
+
+  const std::string name;
+  const ServerSettings settings;
+  ConcurrentQueue<RequestInterfacePtr> queue;
+  std::atomic<bool> shouldFinish{false};
+  std::thread thread;
+};
+
 namespace
 {
 
 using namespace std::chrono_literals;
-std::recursive_mutex threadMutex;
-ConcurrentQueue<RequestInterfacePtr> reqQueue;
-bool threadShouldFinish;
-std::recursive_mutex threadShouldFinishMutex;
 
-void WorkerThread()
+std::mutex healthMutex;
+double lastIdleLatency;
+json lastError;
+
+void RecordReply(const json &reply)
 {
-  DEBUG_OUTPUT("Begin");
+  const auto &errorCode = reply.at("errorCode");
 
+  if(errorCode.at("value") == REQ_SUCCESS)
   {
-    // initialize to false
-    LockGuard lock(threadShouldFinishMutex);
-    threadShouldFinish = false;
+    return;
   }
 
+  std::lock_guard<std::mutex> lock(healthMutex);
+  lastError = errorCode;
+}
+
+void WorkerThread(ServerHandlerPtr handler)
+{
+  const auto &server = handler->name;
+
+  DEBUG_OUTPUT("Begin server={}", server);
+
+  Tracer::Instance().SetThreadName(
+      server.empty() ? "MessageHandler" : "MessageHandler " + server);
+
   zmq_msg_t identityMsg;
   zmq_msg_t payloadMsg;
+  zmq_msg_t binaryMsg;
 
   int rc = zmq_msg_init(&identityMsg);
   ZEROMQ_ASSERT(rc == 0);
@@ -36,21 +65,25 @@ void WorkerThread()
   rc = zmq_msg_init(&payloadMsg);
   ZEROMQ_ASSERT(rc == 0);
 
+  rc = zmq_msg_init(&binaryMsg);
+  ZEROMQ_ASSERT(rc == 0);
+
   for(;;)
   {
     try
     {
       // check if stop is requested
+      if(handler->shouldFinish)
       {
-        LockGuard lock(threadShouldFinishMutex);
-        if(threadShouldFinish)
-        {
-          DEBUG_OUTPUT("Exiting");
-          break;
-        }
+        DEBUG_OUTPUT("Exiting");
+        break;
       }
 
-      auto numBytes = ZeroMQServerReceive(&identityMsg, &payloadMsg);
+      // all spans until the request is queued belong to the same request
+      TraceRequestScope traceScope;
+
+      auto numBytes =
+          ZeroMQServerReceive(server, &identityMsg, &payloadMsg, &binaryMsg);
 
       if(numBytes == -1 && zmq_errno() == EAGAIN) // timeout
       {
@@ -63,12 +96,45 @@ void WorkerThread()
 
       const auto identity = CreateStringFromZMsg(&identityMsg);
 
+      // error replies use the encoding of the request
+      auto encoding = MessageEncoding::JSON;
+
       try
       {
         try
         {
-          const auto payload = CreateStringFromZMsg(&payloadMsg);
-          reqQueue.push(std::make_shared<RequestInterface>(identity, payload));
+          MEASURE_LATENCY(latency, "enqueue");
+          auto payload = CreateStringFromZMsg(&payloadMsg);
+          auto binary  = CreateStringFromZMsg(&binaryMsg);
+
+          encoding = DetectMessageEncoding(payload);
+
+#if HAVE_THREADSAFE_SOCKETS
+          // binary encodings can hold null bytes, so these can only be
+          // combined with a binary frame when using multi-part messages
+          if(encoding == MessageEncoding::JSON)
+          {
+            SplitBinaryPayload(payload, binary);
+          }
+#endif
+
+          RequestInterfacePtr req;
+          {
+            TraceSpan span("RequestInterface");
+            req = std::make_shared<RequestInterface>(server, identity, payload,
+                                                     std::move(binary));
+          }
+
+          // credits must not wait for IDLE, as the main thread is blocked
+          // while streaming
+          if(req->IsStreamCredit())
+          {
+            AddStreamCredit(server, identity, req->GetStreamCredit());
+          }
+          else
+          {
+            handler->queue.push(req);
+          }
         }
         catch(const std::bad_alloc &)
         {
@@ -78,7 +144,8 @@ void WorkerThread()
       catch(const IgorException &e)
       {
         const json reply = e;
-        rc = ZeroMQServerSend(identity, reply.dump(DEFAULT_INDENT));
+        RecordReply(reply);
+        rc = ZeroMQServerSend(server, identity, EncodeMessage(reply, encoding));
 
         DEBUG_OUTPUT("ZeroMQSendAsServer returned {}", rc);
       }
@@ -98,17 +165,51 @@ void WorkerThread()
   // ignore errors
   zmq_msg_close(&identityMsg);
   zmq_msg_close(&payloadMsg);
+  zmq_msg_close(&binaryMsg);
 }
 
 void CallAndReply(const RequestInterfacePtr &req) noexcept
 {
+  TraceRequestScope traceScope(req->GetTraceRequestId());
+
   try
   {
     try
     {
-      auto doc     = CallIgorFunctionFromReqInterface(req);
-      auto message = doc.dump(DEFAULT_INDENT);
-      ZeroMQServerSend(req->GetCallerIdentity(), message);
+      auto doc = CallIgorFunctionFromReqInterface(req);
+      RecordReply(doc);
+
+      // the function might have closed its own server
+      if(!GlobalData::Instance().HasNamedSocket(SocketTypes::Server,
+                                                req->GetServer()))
+      {
+        DEBUG_OUTPUT("Dropping the reply as server \"{}\" was closed",
+                     req->GetServer());
+        return;
+      }
+
+      if(req->GetStream().enabled)
+      {
+        SendStreamedReply(req, std::move(doc));
+        return;
+      }
+
+      std::string message;
+
+      {
+        MEASURE_LATENCY(latency, "replyDump");
+        message = EncodeMessage(doc, req->GetEncoding());
+      }
+
+      std::string compressed;
+      if(CompressFrame(req->GetCompression(), message.data(), message.size(),
+                       compressed))
+      {
+        message.swap(compressed);
+      }
+
+      ZeroMQServerSend(req->GetServer(), req->GetCallerIdentity(),
+                       std::move(message));
     }
     catch(const std::exception &e)
     {
@@ -125,61 +226,177 @@ void CallAndReply(const RequestInterfacePtr &req) noexcept
 
 } // anonymous namespace
 
-void MessageHandler::Start()
+void MessageHandler::Start(const std::string &server)
 {
-  LockGuard lock(threadMutex);
+  LockGuard lock(m_mutex);
 
-  if(m_thread.joinable())
+  if(m_handlers.find(server) != m_handlers.end())
   {
     throw IgorException(HANDLER_ALREADY_RUNNING);
   }
 
-  DEBUG_OUTPUT("Trying to start the handler.");
+  DEBUG_OUTPUT("Trying to start the handler of server \"{}\".", server);
 
-  if(!GlobalData::Instance().HasBindsOrConnections(SocketTypes::Server))
+  if(!GlobalData::Instance().HasBindsOrConnections(SocketTypes::Server,
+                                                    server))
   {
     throw IgorException(HANDLER_NO_CONNECTION);
   }
 
   DEBUG_OUTPUT("Before WorkerThread() start.");
 
-  auto t = std::thread(WorkerThread);
-  m_thread.swap(t);
+  auto handler    = std::make_shared<ServerHandler>(server);
+  handler->thread = std::thread(WorkerThread, handler);
+
+  m_handlers.emplace(server, handler);
 }
 
-void MessageHandler::Stop()
+void MessageHandler::Stop(const std::string &server)
 {
-  LockGuard lock(threadMutex);
+  ServerHandlerPtr handler;
 
-  if(!m_thread.joinable())
   {
-    return;
+    LockGuard lock(m_mutex);
+
+    auto it = m_handlers.find(server);
+
+    if(it == m_handlers.end())
+    {
+      return;
+    }
+
+    handler = it->second;
+    m_handlers.erase(it);
   }
 
-  DEBUG_OUTPUT("Shutting down the handler.");
+  DEBUG_OUTPUT("Shutting down the handler of server \"{}\".", server);
+
+  handler->shouldFinish = true;
+  handler->thread.join();
+
+  StopStreamedReplies(server);
+}
+
+void MessageHandler::StopAll()
+{
+  std::vector<std::string> servers;
+
+  {
+    LockGuard lock(m_mutex);
+
+    for(const auto &entry : m_handlers)
+    {
+      servers.push_back(entry.first);
+    }
+  }
+
+  for(const auto &server : servers)
+  {
+    Stop(server);
+  }
+}
+
+std::vector<ServerHandlerPtr> MessageHandler::GetHandlersByPriority()
+{
+  std::vector<ServerHandlerPtr> handlers;
 
   {
-    LockGuard innerLock(threadShouldFinishMutex);
-    threadShouldFinish = true;
+    LockGuard lock(m_mutex);
+
+    for(const auto &entry : m_handlers)
+    {
+      handlers.push_back(entry.second);
+    }
   }
 
-  m_thread.join();
+  std::stable_sort(handlers.begin(), handlers.end(),
+                   [](const ServerHandlerPtr &a, const ServerHandlerPtr &b)
+                   { return a->settings.priority > b->settings.priority; });
+
+  return handlers;
 }
 
 void MessageHandler::HandleAllQueuedMessages()
 {
-  if(!RunningInMainThread() || reqQueue.empty())
+  if(!RunningInMainThread())
   {
     return;
   }
 
-  auto msg = fmt::format("IDLE event messages: #{}", reqQueue.size());
-  GlobalData::Instance().AddLogEntry(msg);
+  // the handlers are only kept alive by the snapshot if a called function
+  // stops their server
+  for(const auto &handler : GetHandlersByPriority())
+  {
+    auto &queue = handler->queue;
+
+    if(queue.empty())
+    {
+      continue;
+    }
+
+    auto num          = queue.size();
+    const auto budget = handler->settings.requestsPerIdle;
+
+    if(budget > 0)
+    {
+      num = std::min(num, budget);
+    }
+
+    auto msg = handler->name.empty()
+                   ? fmt::format("IDLE event messages: #{}", num)
+                   : fmt::format("IDLE event messages of server {}: #{}",
+                                 handler->name, num);
+    GlobalData::Instance().AddLogEntry(msg);
+
+    // don't hold the queue lock while calling, streamed replies wait for
+    // credits and the handler thread must be able to queue new requests
+    // meanwhile
+    RequestInterfacePtr req;
+    for(; num > 0 && queue.try_pop(req); num--)
+    {
+      const auto now = std::chrono::steady_clock::now();
+      const std::chrono::duration<double> latency =
+          now - req->GetReceivedTime();
+
+      {
+        std::lock_guard<std::mutex> lock(healthMutex);
+        lastIdleLatency = latency.count();
+      }
+
+      static auto &queueWait =
+          MetricsRegistry::Instance().GetHistogram("queueWait");
+      MetricsRegistry::Instance().Record(
+          queueWait,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(latency));
+
+      if(Tracer::Instance().IsEnabled())
+      {
+        TraceRequestScope traceScope(req->GetTraceRequestId());
+        Tracer::Instance().AddSpan("queueWait", req->GetReceivedTime(), now);
+      }
+
+      CallAndReply(req);
+    }
+  }
+}
+
+json MessageHandler::GetHealthInformation()
+{
+  size_t queueDepth = 0;
+
+  for(const auto &handler : GetHandlersByPriority())
+  {
+    queueDepth += handler->queue.size();
+  }
+
+  std::lock_guard<std::mutex> lock(healthMutex);
 
-  reqQueue.apply_to_all(CallAndReply);
+  return {{"queueDepth", queueDepth},
+          {"idleLatency", lastIdleLatency},
+          {"lastError", lastError}};
 }
 
 MessageHandler::~MessageHandler()
 {
-  Stop();
+  StopAll();
 }
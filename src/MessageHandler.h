@@ -5,6 +5,15 @@
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
 
+/// Receive thread and request queue of a server, see MessageHandler.cpp
+struct ServerHandler;
+using ServerHandlerPtr = std::shared_ptr<ServerHandler>;
+
+/// @brief Threaded message handler
+///
+/// Every server, see GlobalData::CreateServer(), has its own receive thread
+/// and request queue. The queued requests are processed in the main thread
+/// during IDLE events according to the ServerSettings of each server.
 class MessageHandler
 {
 public:
@@ -15,16 +24,26 @@ public:
     return obj;
   }
 
-  void Start();
-  void Stop();
+  void Start(const std::string &server);
+  void Stop(const std::string &server);
+  void StopAll();
   void HandleAllQueuedMessages();
 
+  /// @brief Return health information for the heartbeat
+  ///
+  /// Holds the number of queued requests of all servers, the time in seconds
+  /// the last request waited for being called and the last error reply.
+  json GetHealthInformation();
+
 private:
   MessageHandler() = default;
   ~MessageHandler();
   MessageHandler(const MessageHandler &)            = delete;
   MessageHandler &operator=(const MessageHandler &) = delete;
 
-  class thread;
-  std::thread m_thread;
+  /// Return all running handlers sorted by decreasing priority
+  std::vector<ServerHandlerPtr> GetHandlersByPriority();
+
+  std::map<std::string, ServerHandlerPtr> m_handlers;
+  std::recursive_mutex m_mutex;
 };
@@ -0,0 +1,209 @@
+#include "ZeroMQ.h"
+#include "Metrics.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+void UpdateMinimum(std::atomic<uint64_t> &minimum, uint64_t value)
+{
+  auto current = minimum.load(std::memory_order_relaxed);
+
+  while(value < current &&
+        !minimum.compare_exchange_weak(current, value,
+                                       std::memory_order_relaxed))
+  {
+  }
+}
+
+void UpdateMaximum(std::atomic<uint64_t> &maximum, uint64_t value)
+{
+  auto current = maximum.load(std::memory_order_relaxed);
+
+  while(value > current &&
+        !maximum.compare_exchange_weak(current, value,
+                                       std::memory_order_relaxed))
+  {
+  }
+}
+
+} // anonymous namespace
+
+size_t Histogram::GetBucketIndex(uint64_t value)
+{
+  // values smaller than NUM_SUB_BUCKETS have their own bucket
+  if(value < NUM_SUB_BUCKETS)
+  {
+    return static_cast<size_t>(value);
+  }
+
+  int msb = 0;
+  for(auto v = value; v > 1; v >>= 1)
+  {
+    msb++;
+  }
+
+  const auto shift = msb - SUB_BUCKET_BITS;
+  const auto sub   = (value >> shift) & (NUM_SUB_BUCKETS - 1);
+
+  return static_cast<size_t>((shift + 1) * NUM_SUB_BUCKETS) +
+         static_cast<size_t>(sub);
+}
+
+uint64_t Histogram::GetBucketLowerBound(size_t index)
+{
+  if(index < NUM_SUB_BUCKETS)
+  {
+    return index;
+  }
+
+  const auto shift = index / NUM_SUB_BUCKETS - 1;
+  const auto sub   = index % NUM_SUB_BUCKETS;
+
+  return (static_cast<uint64_t>(NUM_SUB_BUCKETS) + sub) << shift;
+}
+
+void Histogram::Record(uint64_t value)
+{
+  m_buckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  m_sum.fetch_add(value, std::memory_order_relaxed);
+  UpdateMinimum(m_min, value);
+  UpdateMaximum(m_max, value);
+}
+
+void Histogram::RecordError()
+{
+  m_errors.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Histogram::Reset()
+{
+  for(auto &bucket : m_buckets)
+  {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+
+  m_count.store(0, std::memory_order_relaxed);
+  m_errors.store(0, std::memory_order_relaxed);
+  m_sum.store(0, std::memory_order_relaxed);
+  m_min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  m_max.store(0, std::memory_order_relaxed);
+}
+
+/// Return the lower bound of the bucket holding the given percentile
+uint64_t Histogram::GetPercentile(double percentile) const
+{
+  const auto count = m_count.load(std::memory_order_relaxed);
+
+  if(count == 0)
+  {
+    return 0;
+  }
+
+  const auto rank = static_cast<uint64_t>(
+      std::ceil(percentile / 100.0 * static_cast<double>(count)));
+
+  uint64_t sum = 0;
+  for(size_t i = 0; i < m_buckets.size(); i++)
+  {
+    sum += m_buckets[i].load(std::memory_order_relaxed);
+
+    if(sum >= rank)
+    {
+      return GetBucketLowerBound(i);
+    }
+  }
+
+  return m_max.load(std::memory_order_relaxed);
+}
+
+json Histogram::ToJSON() const
+{
+  const auto count = m_count.load(std::memory_order_relaxed);
+  const auto sum   = m_sum.load(std::memory_order_relaxed);
+  const auto mean  =
+      count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+
+  json buckets = json::array();
+  for(size_t i = 0; i < m_buckets.size(); i++)
+  {
+    const auto value = m_buckets[i].load(std::memory_order_relaxed);
+
+    if(value > 0)
+    {
+      buckets.push_back({GetBucketLowerBound(i), value});
+    }
+  }
+
+  return {{"count", count},
+          {"errors", m_errors.load(std::memory_order_relaxed)},
+          {"sum", sum},
+          {"min", count ? m_min.load(std::memory_order_relaxed) : 0},
+          {"max", m_max.load(std::memory_order_relaxed)},
+          {"mean", mean},
+          {"p50", GetPercentile(50)},
+          {"p90", GetPercentile(90)},
+          {"p99", GetPercentile(99)},
+          {"p999", GetPercentile(99.9)},
+          {"buckets", buckets}};
+}
+
+Histogram &MetricsRegistry::GetHistogram(const std::string &name)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_histograms[name];
+}
+
+Counter &MetricsRegistry::GetCounter(const std::string &name)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_counters[name];
+}
+
+void MetricsRegistry::Reset()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for(auto &elem : m_histograms)
+  {
+    elem.second.Reset();
+  }
+
+  for(auto &elem : m_counters)
+  {
+    elem.second.Reset();
+  }
+}
+
+json MetricsRegistry::ToJSON()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  json histograms = json::object();
+  for(const auto &elem : m_histograms)
+  {
+    // skip metrics of call sites which were not executed since the last reset
+    if(elem.second.GetCount() == 0)
+    {
+      continue;
+    }
+
+    histograms[elem.first] = elem.second.ToJSON();
+  }
+
+  json counters = json::object();
+  for(const auto &elem : m_counters)
+  {
+    counters[elem.first] = elem.second.Get();
+  }
+
+  return {{"enabled", IsEnabled()},
+          {"unit", "ns"},
+          {"histograms", histograms},
+          {"counters", counters}};
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// @brief Latency histogram with logarithmic buckets
+///
+/// Similar to HDR histograms every power of two is split into
+/// `NUM_SUB_BUCKETS` linear buckets, which bounds the relative error of the
+/// reported percentiles to 1 / NUM_SUB_BUCKETS. Recording is lock free.
+class Histogram
+{
+public:
+  static constexpr int SUB_BUCKET_BITS = 3;
+  static constexpr int NUM_SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static constexpr int NUM_BUCKETS =
+      (64 - SUB_BUCKET_BITS + 1) * NUM_SUB_BUCKETS;
+
+  /// @brief Record a value, usually a duration in nanoseconds
+  void Record(uint64_t value);
+
+  /// @brief Count a failed call, the duration is recorded separately
+  void RecordError();
+
+  void Reset();
+
+  uint64_t GetCount() const
+  {
+    return m_count.load(std::memory_order_relaxed);
+  }
+
+  json ToJSON() const;
+
+private:
+  static size_t GetBucketIndex(uint64_t value);
+  static uint64_t GetBucketLowerBound(size_t index);
+  uint64_t GetPercentile(double percentile) const;
+
+  std::array<std::atomic<uint64_t>, NUM_BUCKETS> m_buckets{};
+  std::atomic<uint64_t> m_count{0};
+  std::atomic<uint64_t> m_errors{0};
+  std::atomic<uint64_t> m_sum{0};
+  std::atomic<uint64_t> m_min{std::numeric_limits<uint64_t>::max()};
+  std::atomic<uint64_t> m_max{0};
+};
+
+class Counter
+{
+public:
+  void Add(uint64_t value)
+  {
+    m_value.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  void Reset()
+  {
+    m_value.store(0, std::memory_order_relaxed);
+  }
+
+  uint64_t Get() const
+  {
+    return m_value.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint64_t> m_value{0};
+};
+
+/// @brief Registry of all histograms and counters
+///
+/// Metrics are created on first use and never removed, so references to them
+/// stay valid. Everything is a no-op when disabled, see
+/// ZeroMQ_SET_FLAGS::METRICS.
+class MetricsRegistry
+{
+public:
+  /// Access to singleton-type global object
+  static MetricsRegistry &Instance()
+  {
+    static MetricsRegistry obj;
+    return obj;
+  }
+
+  void SetEnabled(bool val)
+  {
+    m_enabled.store(val, std::memory_order_relaxed);
+  }
+
+  bool IsEnabled() const
+  {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  Histogram &GetHistogram(const std::string &name);
+  Counter &GetCounter(const std::string &name);
+
+  /// @brief Add `value` to the given counter if enabled
+  void Count(Counter &counter, uint64_t value)
+  {
+    if(IsEnabled())
+    {
+      counter.Add(value);
+    }
+  }
+
+  /// @brief Record the duration in the given histogram if enabled
+  void Record(Histogram &histogram, std::chrono::nanoseconds duration)
+  {
+    if(IsEnabled())
+    {
+      histogram.Record(static_cast<uint64_t>(duration.count()));
+    }
+  }
+
+  void Reset();
+
+  json ToJSON();
+
+private:
+  MetricsRegistry()                                   = default;
+  ~MetricsRegistry()                                  = default;
+  MetricsRegistry(const MetricsRegistry &)            = delete;
+  MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+  std::atomic<bool> m_enabled{false};
+  std::mutex m_mutex;
+  std::map<std::string, Histogram> m_histograms;
+  std::map<std::string, Counter> m_counters;
+};
+
+/// @brief Record the lifetime of the object in the given histogram
+class ScopedLatency
+{
+public:
+  explicit ScopedLatency(Histogram &histogram)
+      : m_histogram(histogram),
+        m_enabled(MetricsRegistry::Instance().IsEnabled())
+  {
+    if(m_enabled)
+    {
+      m_start = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~ScopedLatency()
+  {
+    if(!m_enabled)
+    {
+      return;
+    }
+
+    const auto duration = std::chrono::steady_clock::now() - m_start;
+    m_histogram.Record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+            .count()));
+
+    if(m_failed)
+    {
+      m_histogram.RecordError();
+    }
+  }
+
+  ScopedLatency(const ScopedLatency &)            = delete;
+  ScopedLatency &operator=(const ScopedLatency &) = delete;
+
+  void SetFailed()
+  {
+    m_failed = true;
+  }
+
+private:
+  Histogram &m_histogram;
+  bool m_enabled;
+  bool m_failed{false};
+  std::chrono::steady_clock::time_point m_start;
+};
+
+/// @brief Measure the latency from here until the end of the scope
+///
+/// The histogram lookup is only done once per call site.
+#define MEASURE_LATENCY(var, name)                                             \
+  static Histogram &var##Histogram =                                           \
+      MetricsRegistry::Instance().GetHistogram(name);                          \
+  ScopedLatency var(var##Histogram)
@@ -0,0 +1,670 @@
+#include "ZeroMQ.h"
+#include "NativeOperation.h"
+#include "SerializeWave.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+const std::array<std::pair<const char *, NativeOperationType>, 5>
+    NATIVE_OPERATIONS = {{{"GetWave", NativeOperationType::GetWave},
+                          {"ListFolder", NativeOperationType::ListFolder},
+                          {"SetWaveData", NativeOperationType::SetWaveData},
+                          {"WaveExists", NativeOperationType::WaveExists},
+                          {"WaveInfo", NativeOperationType::WaveInfo}}};
+
+/// Split the path at the last colon outside of quotes into the data folder
+/// path, including the colon, and the unquoted object name
+void SplitObjectPath(const std::string &path, std::string &folderPath,
+                     std::string &name)
+{
+  size_t pos  = std::string::npos;
+  bool quoted = false;
+
+  for(size_t i = 0; i < path.size(); i++)
+  {
+    if(path[i] == '\'')
+    {
+      quoted = !quoted;
+    }
+    else if(path[i] == ':' && !quoted)
+    {
+      pos = i;
+    }
+  }
+
+  if(pos == std::string::npos)
+  {
+    folderPath.clear();
+    name = path;
+  }
+  else
+  {
+    folderPath = path.substr(0, pos + 1);
+    name       = path.substr(pos + 1);
+  }
+
+  // liberal names
+  if(name.size() >= 2 && name.front() == '\'' && name.back() == '\'')
+  {
+    name = name.substr(1, name.size() - 2);
+  }
+}
+
+/// Return the data folder or nullptr if it does not exist
+DataFolderHandle LookupDataFolder(const std::string &path)
+{
+  DataFolderHandle dataFolderHandle = nullptr;
+
+  if(GetNamedDataFolder(nullptr, path.c_str(), &dataFolderHandle))
+  {
+    return nullptr;
+  }
+
+  return dataFolderHandle;
+}
+
+/// Return the wave or nullptr if it does not exist, paths without data folder
+/// are relative to the current data folder
+waveHndl LookupWave(const std::string &path)
+{
+  std::string folderPath, name;
+  SplitObjectPath(path, folderPath, name);
+
+  if(name.empty() || name.size() > MAX_OBJ_NAME)
+  {
+    return nullptr;
+  }
+
+  DataFolderHandle dataFolderHandle = nullptr;
+
+  if(!folderPath.empty())
+  {
+    dataFolderHandle = LookupDataFolder(folderPath);
+
+    if(dataFolderHandle == nullptr)
+    {
+      return nullptr;
+    }
+  }
+
+  return FetchWaveFromDataFolder(dataFolderHandle, name.c_str());
+}
+
+json GetObjectNames(DataFolderHandle dataFolderHandle, int objectType)
+{
+  int numObjects = 0;
+  auto rc = GetNumDataFolderObjects(dataFolderHandle, objectType, &numObjects);
+  ASSERT(rc == 0);
+
+  auto names = json::array();
+
+  for(int i = 0; i < numObjects; i++)
+  {
+    char name[MAX_OBJ_NAME + 1];
+    rc = GetIndexedDataFolderObject(dataFolderHandle, objectType, i, name,
+                                    nullptr);
+    ASSERT(rc == 0);
+
+    names.push_back(name);
+  }
+
+  return names;
+}
+
+json GetChildDataFolderNames(DataFolderHandle dataFolderHandle)
+{
+  int numChildren = 0;
+  auto rc = GetNumChildDataFolders(dataFolderHandle, &numChildren);
+  ASSERT(rc == 0);
+
+  auto names = json::array();
+
+  for(int i = 0; i < numChildren; i++)
+  {
+    DataFolderHandle child = nullptr;
+    rc = GetIndexedChildDataFolder(dataFolderHandle, i, &child);
+    ASSERT(rc == 0);
+
+    char name[MAXCMDLEN + 1];
+    rc = GetDataFolderNameOrPath(child, 0x0, name);
+    ASSERT(rc == 0);
+
+    names.push_back(name);
+  }
+
+  return names;
+}
+
+double ConvertToDouble(const json &elem)
+{
+  if(elem.is_number())
+  {
+    return elem.get<double>();
+  }
+
+  // NaN and Inf
+  if(elem.is_string())
+  {
+    const auto str = elem.get<std::string>();
+
+    if(!str.empty() && IsConvertibleToDouble(str))
+    {
+      return ConvertStringToDouble(str);
+    }
+  }
+
+  throw RequestInterfaceException(REQ_INVALID_WAVE_DATA);
+}
+
+void SetNumericWaveData(waveHndl waveHandle, const json &data)
+{
+  const auto isComplex = (WaveType(waveHandle) & NT_CMPLX) != 0;
+  const auto numValues =
+      To<size_t>(WavePoints(waveHandle)) * (isComplex ? 2 : 1);
+
+  if(data.size() != numValues)
+  {
+    throw RequestInterfaceException(REQ_INVALID_WAVE_DATA);
+  }
+
+  std::vector<double> values;
+  values.reserve(numValues);
+
+  for(const auto &elem : data)
+  {
+    values.push_back(ConvertToDouble(elem));
+  }
+
+  auto rc = MDStoreDPDataInNumericWave(waveHandle, values.data());
+
+  if(rc != 0)
+  {
+    throw IgorException(rc, "Error writing values to numeric wave");
+  }
+}
+
+void SetTextWaveData(waveHndl waveHandle, const json &data)
+{
+  const auto dimSizes = GetWaveDimension(waveHandle);
+
+  if(data.size() != To<size_t>(WavePoints(waveHandle)))
+  {
+    throw RequestInterfaceException(REQ_INVALID_WAVE_DATA);
+  }
+
+  if(!std::all_of(data.begin(), data.end(),
+                  [](const json &elem) { return elem.is_string(); }))
+  {
+    throw RequestInterfaceException(REQ_INVALID_WAVE_DATA);
+  }
+
+  std::vector<IndexInt> indices(MAX_DIMENSIONS, 0);
+
+  for(const auto &elem : data)
+  {
+    SetWaveElement(waveHandle, indices, elem.get<std::string>());
+
+    // column major order as in the wave serialization
+    for(size_t dim = 0; dim < MAX_DIMENSIONS; dim++)
+    {
+      if(++indices[dim] < dimSizes[dim])
+      {
+        break;
+      }
+
+      indices[dim] = 0;
+    }
+  }
+}
+
+/// Parse a wave type as written by the wave serialization, e.g.
+/// `NT_FP32 | NT_CMPLX`
+int ParseWaveType(const std::string &str)
+{
+  const std::array<std::pair<const char *, int>, 8> WAVE_TYPE_FLAGS = {
+      {{"NT_FP32", NT_FP32},
+       {"NT_FP64", NT_FP64},
+       {"NT_I8", NT_I8},
+       {"NT_I16", NT_I16},
+       {"NT_I32", NT_I32},
+       {"NT_I64", NT_I64},
+       {"NT_UNSIGNED", NT_UNSIGNED},
+       {"NT_CMPLX", NT_CMPLX}}};
+
+  int waveType = 0;
+  std::stringstream ss(str);
+  std::string flag;
+
+  while(std::getline(ss, flag, '|'))
+  {
+    flag.erase(0, flag.find_first_not_of(' '));
+    flag.erase(flag.find_last_not_of(' ') + 1);
+
+    auto it = std::find_if(
+        WAVE_TYPE_FLAGS.begin(), WAVE_TYPE_FLAGS.end(),
+        [&flag](const auto &entry) { return flag == entry.first; });
+
+    if(it == WAVE_TYPE_FLAGS.end())
+    {
+      throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+    }
+
+    waveType |= it->second;
+  }
+
+  // also rejects complex integer waves
+  if(GetWaveElementSize(waveType) == 0)
+  {
+    throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+  }
+
+  return waveType;
+}
+
+/// Parse an array of at most MAX_DIMENSIONS indices or sizes
+std::vector<CountInt> ParseDimensionArray(const json &elem, CountInt minimum)
+{
+  if(!elem.is_array() || elem.empty() || elem.size() > MAX_DIMENSIONS)
+  {
+    throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+  }
+
+  std::vector<CountInt> result;
+
+  for(const auto &entry : elem)
+  {
+    if(!entry.is_number_integer() || entry.get<int64_t>() < minimum)
+    {
+      throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+    }
+
+    result.push_back(entry.get<CountInt>());
+  }
+
+  return result;
+}
+
+} // anonymous namespace
+
+NativeOperation::NativeOperation(NativeOperationType type, const json &j,
+                                 std::string binary)
+    : m_type(type), m_binary(std::move(binary))
+{
+  DEBUG_OUTPUT("type={}, size={}", type, j.size());
+
+  auto it = j.find("path");
+
+  if(it == j.end() || !it.value().is_string())
+  {
+    throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+  }
+
+  m_path = it.value().get<std::string>();
+
+  if(m_path.empty() || m_path.size() >= MAXCMDLEN)
+  {
+    throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+  }
+
+  size_t numKnownObjects = 1;
+
+  switch(m_type)
+  {
+  case NativeOperationType::GetWave:
+    // optional decimation
+    numKnownObjects += j.count("decimation");
+    m_serializationOptions = ParseWaveSerializationOptions(j);
+    break;
+  case NativeOperationType::SetWaveData:
+    it = j.find("data");
+
+    // without data the values are in the binary frame
+    if(it == j.end())
+    {
+      ParseBinaryUpload(j, numKnownObjects);
+      break;
+    }
+
+    if(!it.value().is_array() || !m_binary.empty())
+    {
+      throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+    }
+
+    numKnownObjects += 1;
+    m_data = it.value();
+    break;
+  case NativeOperationType::WaveInfo:
+    m_serializationOptions.withData = false;
+    break;
+  case NativeOperationType::ListFolder:
+  case NativeOperationType::WaveExists:
+    break;
+  }
+
+  // unknown other objects or binary data for operations without support
+  if(j.size() != numKnownObjects ||
+     (!m_binary.empty() && m_type != NativeOperationType::SetWaveData))
+  {
+    throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+  }
+
+  DEBUG_OUTPUT("Native operation could be created: {}", *this);
+}
+
+void NativeOperation::ParseBinaryUpload(const json &j, size_t &numKnownObjects)
+{
+  auto it = j.find("type");
+
+  if(it != j.end())
+  {
+    if(!it.value().is_string())
+    {
+      throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+    }
+
+    m_dataType = ParseWaveType(it.value().get<std::string>());
+    numKnownObjects += 1;
+  }
+
+  it = j.find("size");
+
+  if(it != j.end())
+  {
+    m_size = ParseDimensionArray(it.value(), 1);
+    numKnownObjects += 1;
+  }
+
+  it = j.find("offset");
+
+  if(it != j.end())
+  {
+    m_offset = ParseDimensionArray(it.value(), 0);
+    numKnownObjects += 1;
+
+    if(m_offset.size() != m_size.size())
+    {
+      throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+    }
+  }
+
+  it = j.find("redimension");
+
+  if(it != j.end())
+  {
+    if(!it.value().is_boolean())
+    {
+      throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+    }
+
+    m_redimension = it.value().get<bool>();
+    numKnownObjects += 1;
+
+    if(m_redimension && m_size.empty())
+    {
+      throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+    }
+  }
+
+  m_offset.resize(m_size.size(), 0);
+}
+
+void NativeOperation::CanBeProcessed() const
+{
+  // nothing to check, as the objects are looked up during the call and the
+  // procedures don't need to be compiled
+  DEBUG_OUTPUT("Request Object can be processed: {}", *this);
+}
+
+json NativeOperation::Call()
+{
+  DEBUG_OUTPUT("Data={}", *this);
+
+  json doc;
+  doc["errorCode"] = {{"value", 0}};
+
+  switch(m_type)
+  {
+  case NativeOperationType::GetWave:
+    doc["result"] = GetWave();
+    break;
+  case NativeOperationType::ListFolder:
+    doc["result"] = ListFolder();
+    break;
+  case NativeOperationType::SetWaveData:
+    doc["result"] = SetWaveData();
+    break;
+  case NativeOperationType::WaveExists:
+    doc["result"] = WaveExists();
+    break;
+  case NativeOperationType::WaveInfo:
+    doc["result"] = WaveInfo();
+    break;
+  }
+
+  return doc;
+}
+
+std::string NativeOperation::GetHistoryDuringCall() const
+{
+  // no Igor Pro code is executed
+  return {};
+}
+
+std::string NativeOperation::ToString() const
+{
+  return fmt::format("{}", *this);
+}
+
+json NativeOperation::GetWave() const
+{
+  return {{"type", "wave"},
+          {"value", SerializeWave(LookupWave(m_path), m_serializationOptions)}};
+}
+
+json NativeOperation::ListFolder() const
+{
+  auto dataFolderHandle = LookupDataFolder(m_path);
+
+  if(dataFolderHandle == nullptr)
+  {
+    throw RequestInterfaceException(REQ_NON_EXISTING_DATAFOLDER);
+  }
+
+  json value;
+  value["path"]      = SerializeDataFolder(dataFolderHandle);
+  value["folders"]   = GetChildDataFolderNames(dataFolderHandle);
+  value["waves"]     = GetObjectNames(dataFolderHandle, WAVE_OBJECT);
+  value["variables"] = GetObjectNames(dataFolderHandle, VAR_OBJECT);
+  value["strings"]   = GetObjectNames(dataFolderHandle, STR_OBJECT);
+
+  return {{"type", "folder"}, {"value", value}};
+}
+
+json NativeOperation::SetWaveData() const
+{
+  auto waveHandle = LookupWave(m_path);
+
+  if(waveHandle == nullptr)
+  {
+    throw RequestInterfaceException(REQ_NON_EXISTING_WAVE);
+  }
+
+  const auto waveType = WaveType(waveHandle);
+  CountInt numPoints   = 0;
+
+  if(IsBitSet(waveType, WAVE_TYPE) || IsBitSet(waveType, DATAFOLDER_TYPE))
+  {
+    throw RequestInterfaceException(REQ_INVALID_WAVE_DATA);
+  }
+  else if(m_data.is_null())
+  {
+    numPoints = SetBinaryWaveData(waveHandle);
+  }
+  else if(waveType == TEXT_WAVE_TYPE)
+  {
+    SetTextWaveData(waveHandle, m_data);
+    numPoints = WavePoints(waveHandle);
+  }
+  else
+  {
+    SetNumericWaveData(waveHandle, m_data);
+    numPoints = WavePoints(waveHandle);
+  }
+
+  WaveHandleModified(waveHandle);
+
+  return {{"type", "variable"}, {"value", numPoints}};
+}
+
+CountInt NativeOperation::SetBinaryWaveData(waveHndl waveHandle) const
+{
+  auto waveType = WaveType(waveHandle);
+
+  if(waveType == TEXT_WAVE_TYPE)
+  {
+    throw RequestInterfaceException(REQ_INVALID_WAVE_DATA);
+  }
+
+  const auto dataType = (m_dataType == -1) ? waveType : m_dataType;
+  auto dimSizes       = GetWaveDimension(waveHandle);
+
+  if(m_redimension)
+  {
+    // only grow, so that the data outside of the hyperslab is kept
+    auto newDimSizes = dimSizes;
+
+    for(size_t dim = 0; dim < m_size.size(); dim++)
+    {
+      newDimSizes[dim] = std::max(dimSizes[dim], m_offset[dim] + m_size[dim]);
+    }
+
+    if(dataType != waveType || newDimSizes != dimSizes)
+    {
+      auto rc = MDChangeWave2(waveHandle, dataType, newDimSizes.data(), 0);
+
+      if(rc != 0)
+      {
+        throw IgorException(rc, "Error redimensioning the wave");
+      }
+
+      waveType = dataType;
+      dimSizes = newDimSizes;
+    }
+  }
+  else if(dataType != waveType)
+  {
+    throw RequestInterfaceException(REQ_INVALID_WAVE_DATA);
+  }
+
+  // the hyperslab defaults to the complete wave
+  std::array<CountInt, MAX_DIMENSIONS> offset{}, size{}, waveSize{};
+
+  for(size_t dim = 0; dim < MAX_DIMENSIONS; dim++)
+  {
+    // unused dimensions hold one element, rows must exist
+    waveSize[dim] =
+        (dim == 0) ? dimSizes[dim] : std::max<CountInt>(dimSizes[dim], 1);
+
+    if(m_size.empty())
+    {
+      size[dim] = (dim == 0) ? dimSizes[dim] : waveSize[dim];
+    }
+    else if(dim < m_size.size())
+    {
+      offset[dim] = m_offset[dim];
+      size[dim]   = m_size[dim];
+    }
+    else
+    {
+      size[dim] = 1;
+    }
+
+    if(offset[dim] + size[dim] > waveSize[dim] && size[dim] > 0)
+    {
+      throw RequestInterfaceException(REQ_INVALID_WAVE_DATA);
+    }
+  }
+
+  const auto elementSize = GetWaveElementSize(waveType);
+  const auto numPoints   = std::accumulate(size.begin(), size.end(),
+                                           CountInt{1}, std::multiplies<>());
+
+  if(elementSize == 0 ||
+     m_binary.size() != To<size_t>(numPoints) * elementSize)
+  {
+    throw RequestInterfaceException(REQ_INVALID_WAVE_DATA);
+  }
+
+  auto *dest      = static_cast<char *>(WaveData(waveHandle));
+  const auto *src = m_binary.data();
+
+  if(size == waveSize || numPoints == 0)
+  {
+    std::memcpy(dest, src, m_binary.size());
+    return numPoints;
+  }
+
+  // copy the hyperslab column by column
+  const auto columnBytes = To<size_t>(size[0]) * elementSize;
+
+  for(CountInt chunk = 0; chunk < size[3]; chunk++)
+  {
+    for(CountInt layer = 0; layer < size[2]; layer++)
+    {
+      for(CountInt col = 0; col < size[1]; col++)
+      {
+        const auto index =
+            offset[0] +
+            waveSize[0] *
+                (offset[1] + col +
+                 waveSize[1] * (offset[2] + layer +
+                                waveSize[2] * (offset[3] + chunk)));
+
+        std::memcpy(dest + To<size_t>(index) * elementSize, src, columnBytes);
+        src += columnBytes;
+      }
+    }
+  }
+
+  return numPoints;
+}
+
+json NativeOperation::WaveExists() const
+{
+  return {{"type", "variable"}, {"value", LookupWave(m_path) != nullptr ? 1 : 0}};
+}
+
+json NativeOperation::WaveInfo() const
+{
+  return {{"type", "wave"},
+          {"value", SerializeWave(LookupWave(m_path), m_serializationOptions)}};
+}
+
+OperationPtr CreateNativeOperation(const json &request, std::string binary)
+{
+  OperationPtr op;
+
+  for(const auto &entry : NATIVE_OPERATIONS)
+  {
+    auto it = request.find(entry.first);
+
+    if(it == request.end())
+    {
+      continue;
+    }
+
+    // only one operation per request
+    if(op || !it.value().is_object())
+    {
+      throw RequestInterfaceException(REQ_INVALID_OPERATION);
+    }
+
+    op = std::make_shared<NativeOperation>(entry.second, it.value(),
+                                           std::move(binary));
+  }
+
+  return op;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "ZeroMQ.h"
+#include "Operation.h"
+#include "SerializeWave.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+enum class NativeOperationType
+{
+  GetWave,
+  ListFolder,
+  SetWaveData,
+  WaveExists,
+  WaveInfo
+};
+
+/// @brief Operations implemented in the XOP
+///
+/// These look up waves and data folders directly with the XOP Toolkit instead
+/// of calling the helper functions of ZeroMQ_Interop.ipf, which avoids the
+/// function lookup and the Igor Pro interpreter.
+class NativeOperation : public Operation
+{
+public:
+  /// @param binary optional binary frame of the request, only supported by
+  ///               `SetWaveData`
+  NativeOperation(NativeOperationType type, const json &j,
+                  std::string binary = {});
+  void CanBeProcessed() const override;
+  json Call() override;
+  std::string GetHistoryDuringCall() const override;
+  std::string ToString() const override;
+
+  friend struct fmt::formatter<NativeOperation>;
+
+private:
+  json GetWave() const;
+  json ListFolder() const;
+  json SetWaveData() const;
+  json WaveExists() const;
+  json WaveInfo() const;
+
+  void ParseBinaryUpload(const json &j, size_t &numKnownObjects);
+  CountInt SetBinaryWaveData(waveHndl waveHandle) const;
+
+  NativeOperationType m_type;
+  std::string m_path;
+  json m_data;
+  WaveSerializationOptions m_serializationOptions;
+
+  // binary upload of SetWaveData
+  std::string m_binary;
+  int m_dataType{-1}; ///< -1 for the type of the wave
+  std::vector<CountInt> m_offset, m_size;
+  bool m_redimension{};
+};
+
+/// @brief Create the native operation of the request
+///
+/// @return nullptr if the request does not hold a native operation
+OperationPtr CreateNativeOperation(const json &request,
+                                   std::string binary = {});
+
+template <>
+struct fmt::formatter<NativeOperationType> : fmt::formatter<std::string>
+{
+  // parse is inherited from formatter<std::string>.
+  template <typename FormatContext>
+  auto format(NativeOperationType type, FormatContext &ctx) const
+  {
+    std::string name;
+
+    switch(type)
+    {
+    case NativeOperationType::GetWave:
+      name = "GetWave";
+      break;
+    case NativeOperationType::ListFolder:
+      name = "ListFolder";
+      break;
+    case NativeOperationType::SetWaveData:
+      name = "SetWaveData";
+      break;
+    case NativeOperationType::WaveExists:
+      name = "WaveExists";
+      break;
+    case NativeOperationType::WaveInfo:
+      name = "WaveInfo";
+      break;
+    }
+
+    return formatter<std::string>::format(name, ctx);
+  }
+};
+
+template <>
+struct fmt::formatter<NativeOperation> : fmt::formatter<std::string>
+{
+  // parse is inherited from formatter<std::string>.
+  template <typename FormatContext>
+  auto format(const NativeOperation &op, FormatContext &ctx) const
+  {
+    return format_to(ctx.out(), "{}: path={}", op.m_type, op.m_path);
+  }
+};
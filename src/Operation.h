@@ -0,0 +1,24 @@
+#pragma once
+
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// @brief Operation of a request, see CallFunctionOperation and
+/// NativeOperation
+class Operation
+{
+public:
+  virtual ~Operation() = default;
+
+  /// Throw a RequestInterfaceException if the operation can not be called
+  virtual void CanBeProcessed() const = 0;
+  virtual json Call()                 = 0;
+
+  // Return the Igor history outputted during the call
+  virtual std::string GetHistoryDuringCall() const = 0;
+
+  /// Return a description for logging
+  virtual std::string ToString() const = 0;
+};
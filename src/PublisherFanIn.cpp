@@ -0,0 +1,394 @@
+#include "ZeroMQ.h"
+#include "PublisherFanIn.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+struct ThreadSocket
+{
+  void *socket{nullptr};
+  std::mutex mutex; ///< only contended when the channel is stopped
+};
+
+struct FanInChannel
+{
+  FanInChannel(std::string channelName, std::string inprocEndpoint)
+      : name(std::move(channelName)), endpoint(std::move(inprocEndpoint))
+  {
+  }
+
+  const std::string name;
+  const std::string endpoint;
+  void *pullSocket{nullptr}; ///< owned by the forwarding thread
+  std::atomic<bool> shouldFinish{false};
+  std::thread thread;
+
+  // protected by socketsMutex
+  std::shared_mutex socketsMutex;
+  bool closed{false};
+  std::map<std::thread::id, std::unique_ptr<ThreadSocket>> sockets;
+};
+
+namespace
+{
+
+/// @brief Channels the calling thread has a socket for
+///
+/// The sockets are closed and forgotten when the thread exits, as threads
+/// come and go with the Igor Pro preemptive threads calling the XOP.
+class ThreadSocketRegistry
+{
+public:
+  ~ThreadSocketRegistry();
+
+  void Add(const FanInChannelPtr &fanIn)
+  {
+    // forget stopped channels
+    m_channels.erase(std::remove_if(m_channels.begin(), m_channels.end(),
+                                    [](const std::weak_ptr<FanInChannel> &elem)
+                                    { return elem.expired(); }),
+                     m_channels.end());
+
+    m_channels.push_back(fanIn);
+  }
+
+private:
+  std::vector<std::weak_ptr<FanInChannel>> m_channels;
+};
+
+thread_local ThreadSocketRegistry threadSocketRegistry;
+
+ThreadSocketRegistry::~ThreadSocketRegistry()
+{
+  const auto id = std::this_thread::get_id();
+
+  for(const auto &elem : m_channels)
+  {
+    auto fanIn = elem.lock();
+
+    if(!fanIn)
+    {
+      continue;
+    }
+
+    try
+    {
+      std::unique_lock<std::shared_mutex> lock(fanIn->socketsMutex);
+
+      auto it = fanIn->sockets.find(id);
+
+      if(it == fanIn->sockets.end())
+      {
+        continue;
+      }
+
+      // already closed if the channel was stopped
+      if(it->second->socket != nullptr)
+      {
+        DEBUG_OUTPUT("Closing thread socket {} for channel \"{}\"",
+                     it->second->socket, fanIn->name);
+
+        GlobalData::Instance().CloseInternalSocket(it->second->socket);
+      }
+
+      fanIn->sockets.erase(it);
+    }
+    catch(const std::exception &e)
+    {
+      EMERGENCY_OUTPUT(
+          "Caught std::exception with what = \"{}\". This must NOT happen!",
+          e.what());
+    }
+  }
+}
+
+/// Receive all frames of a message, return false on timeout
+bool ReceiveFrames(void *socket, ZeroMQMessageSharedPtrVec &vec)
+{
+  vec.clear();
+
+  for(;;)
+  {
+    auto frame = std::make_shared<ZeroMQMessage>();
+    auto rc    = zmq_msg_recv(frame->get(), socket, 0);
+
+    if(rc < 0 && vec.empty() && zmq_errno() == EAGAIN) // timeout
+    {
+      return false;
+    }
+
+    // the remaining frames of a multipart message are already there
+    ZEROMQ_ASSERT(rc >= 0);
+
+    vec.push_back(frame);
+
+    if(!zmq_msg_more(frame->get()))
+    {
+      return true;
+    }
+  }
+}
+
+/// Send the already compressed frames without copying
+void ForwardFrames(const std::string &channel, ZeroMQMessageSharedPtrVec &vec)
+{
+  GET_NAMED_SOCKET(socket, SocketTypes::Publisher, channel);
+
+  const auto vecLen = vec.size();
+
+  for(size_t i = 0; i < vecLen; i++)
+  {
+    const int flag = i < (vecLen - 1) ? ZMQ_SNDMORE : 0;
+
+    auto rc = zmq_msg_send(vec[i]->get(), socket.get(), flag);
+
+    // the channel got a send thread meanwhile, see SetNoDrop()
+    if(i == 0 && rc < 0 && zmq_errno() == EAGAIN)
+    {
+      DEBUG_OUTPUT("Dropping message as channel \"{}\" is at the high water "
+                   "mark",
+                   channel);
+      return;
+    }
+
+    ZEROMQ_ASSERT(rc >= 0);
+  }
+}
+
+void ForwardingThread(FanInChannelPtr fanIn)
+{
+  const auto &channel = fanIn->name;
+
+  DEBUG_OUTPUT("Begin channel={}", channel);
+
+  Tracer::Instance().SetThreadName("PublisherFanIn " + channel);
+
+  for(;;)
+  {
+    try
+    {
+      ZeroMQMessageSharedPtrVec vec;
+
+      if(!ReceiveFrames(fanIn->pullSocket, vec))
+      {
+        // forward the remaining messages before finishing
+        if(fanIn->shouldFinish)
+        {
+          DEBUG_OUTPUT("Exiting");
+          break;
+        }
+
+        continue;
+      }
+
+      ForwardFrames(channel, vec);
+    }
+    catch(const IgorException &e)
+    {
+      DEBUG_OUTPUT("Dropping message as forwarding failed with {}",
+                   e.GetErrorCode());
+    }
+    catch(const std::exception &e)
+    {
+      EMERGENCY_OUTPUT(
+          "Caught std::exception with what = \"{}\". This must NOT happen!",
+          e.what());
+    }
+    catch(...)
+    {
+      EMERGENCY_OUTPUT("Caught exception. This must NOT happen!");
+    }
+  }
+}
+
+/// @brief Return the socket of the calling thread
+///
+/// @return nullptr if the channel was stopped
+ThreadSocket *GetThreadSocket(const FanInChannelPtr &channel)
+{
+  auto &fanIn = *channel;
+  const auto id = std::this_thread::get_id();
+
+  {
+    std::shared_lock<std::shared_mutex> lock(fanIn.socketsMutex);
+
+    if(fanIn.closed)
+    {
+      return nullptr;
+    }
+
+    auto it = fanIn.sockets.find(id);
+
+    if(it != fanIn.sockets.end())
+    {
+      return it->second.get();
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> lock(fanIn.socketsMutex);
+
+  if(fanIn.closed)
+  {
+    return nullptr;
+  }
+
+  auto threadSocket    = std::make_unique<ThreadSocket>();
+  threadSocket->socket = GlobalData::Instance().CreateInternalSocket(ZMQ_PUSH);
+
+  auto rc = zmq_connect(threadSocket->socket, fanIn.endpoint.c_str());
+  ZEROMQ_ASSERT(rc == 0);
+
+  DEBUG_OUTPUT("Creating thread socket {} for channel \"{}\"",
+               threadSocket->socket, fanIn.name);
+
+  auto *result = threadSocket.get();
+  fanIn.sockets.emplace(id, std::move(threadSocket));
+
+  threadSocketRegistry.Add(channel);
+
+  return result;
+}
+
+} // anonymous namespace
+
+void PublisherFanIn::Start(const std::string &channel)
+{
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+  if(m_channels.find(channel) != m_channels.end())
+  {
+    return;
+  }
+
+  DEBUG_OUTPUT("Starting the forwarding thread of channel \"{}\"", channel);
+
+  // channel names are arbitrary strings, so number the endpoints instead
+  auto fanIn = std::make_shared<FanInChannel>(
+      channel, fmt::format("inproc://zeromq-xop-fan-in-{}", m_numEndpoints++));
+
+  fanIn->pullSocket = GlobalData::Instance().CreateInternalSocket(ZMQ_PULL);
+
+  auto rc = zmq_bind(fanIn->pullSocket, fanIn->endpoint.c_str());
+  ZEROMQ_ASSERT(rc == 0);
+
+  fanIn->thread = std::thread(ForwardingThread, fanIn);
+
+  m_channels.emplace(channel, fanIn);
+}
+
+void PublisherFanIn::Stop(const std::string &channel)
+{
+  FanInChannelPtr fanIn;
+
+  {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+    auto it = m_channels.find(channel);
+
+    if(it == m_channels.end())
+    {
+      return;
+    }
+
+    fanIn = it->second;
+    m_channels.erase(it);
+  }
+
+  DEBUG_OUTPUT("Shutting down the forwarding thread of channel \"{}\".",
+               channel);
+
+  {
+    std::unique_lock<std::shared_mutex> lock(fanIn->socketsMutex);
+
+    fanIn->closed = true;
+
+    for(auto &entry : fanIn->sockets)
+    {
+      auto &threadSocket = *entry.second;
+
+      // wait for a running send
+      std::lock_guard<std::mutex> socketLock(threadSocket.mutex);
+
+      GlobalData::Instance().CloseInternalSocket(threadSocket.socket);
+      threadSocket.socket = nullptr;
+    }
+  }
+
+  fanIn->shouldFinish = true;
+  fanIn->thread.join();
+
+  GlobalData::Instance().CloseInternalSocket(fanIn->pullSocket);
+  fanIn->pullSocket = nullptr;
+}
+
+void PublisherFanIn::StopAll()
+{
+  std::vector<std::string> channels;
+
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+    for(const auto &entry : m_channels)
+    {
+      channels.push_back(entry.first);
+    }
+  }
+
+  for(const auto &channel : channels)
+  {
+    Stop(channel);
+  }
+}
+
+bool PublisherFanIn::Send(const std::string &channel, SendStorageVec &vec)
+{
+  auto fanIn = GetChannel(channel);
+
+  if(!fanIn)
+  {
+    return false;
+  }
+
+  auto threadSocket = GetThreadSocket(fanIn);
+
+  if(threadSocket == nullptr)
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(threadSocket->mutex);
+
+  // the channel was stopped in the meantime, let the caller send it directly
+  if(threadSocket->socket == nullptr)
+  {
+    return false;
+  }
+
+  if(ZeroMQPublisherSendFrames(threadSocket->socket, vec) < 0)
+  {
+    DEBUG_OUTPUT("Dropping message as the forwarding thread of channel \"{}\" "
+                 "can not keep up",
+                 channel);
+  }
+
+  return true;
+}
+
+FanInChannelPtr PublisherFanIn::GetChannel(const std::string &channel)
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+  auto it = m_channels.find(channel);
+
+  if(it == m_channels.end())
+  {
+    return nullptr;
+  }
+
+  return it->second;
+}
+
+PublisherFanIn::~PublisherFanIn()
+{
+  StopAll();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ZeroMQ.h"
+
+#include <shared_mutex>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// Thread sockets and forwarding thread of a publisher channel, see
+/// PublisherFanIn.cpp
+struct FanInChannel;
+using FanInChannelPtr = std::shared_ptr<FanInChannel>;
+
+/// @brief Per-thread sockets of publisher channels
+///
+/// The publisher socket of a channel can only be used by one thread at a
+/// time. For channels with thread sockets each sending thread gets its own
+/// inproc socket instead, so that threads compress and send in parallel. A
+/// forwarding thread per channel moves the messages from all thread sockets,
+/// without copying, to the publisher socket. Messages of one thread keep
+/// their order.
+///
+/// As with the high water mark of the publisher socket, messages are dropped
+/// if the forwarding thread can not keep up. The socket of a thread is closed
+/// when the thread exits or the channel is stopped.
+class PublisherFanIn
+{
+public:
+  /// Access to singleton-type global object
+  static PublisherFanIn &Instance()
+  {
+    static PublisherFanIn obj;
+    return obj;
+  }
+
+  /// Start the forwarding thread of the channel, does nothing if it is
+  /// already running
+  void Start(const std::string &channel);
+
+  /// @brief Stop the forwarding thread and close all thread sockets of the
+  /// channel
+  ///
+  /// The already sent messages are still forwarded.
+  void Stop(const std::string &channel);
+  void StopAll();
+
+  /// @brief Send the frames over the socket of the calling thread
+  ///
+  /// The frames are consumed only if true is returned.
+  ///
+  /// @return false if the channel does not have thread sockets
+  bool Send(const std::string &channel, SendStorageVec &vec);
+
+private:
+  PublisherFanIn() = default;
+  ~PublisherFanIn();
+  PublisherFanIn(const PublisherFanIn &)            = delete;
+  PublisherFanIn &operator=(const PublisherFanIn &) = delete;
+
+  FanInChannelPtr GetChannel(const std::string &channel);
+
+  // read by every send, so all sending threads only share the lock
+  std::map<std::string, FanInChannelPtr> m_channels;
+  std::shared_mutex m_mutex;
+  uint64_t m_numEndpoints{};
+};
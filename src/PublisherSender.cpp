@@ -0,0 +1,421 @@
+#include "ZeroMQ.h"
+#include "PublisherSender.h"
+#include "send_struct.h"
+
+#include <condition_variable>
+#include <deque>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+struct ChannelSender
+{
+  explicit ChannelSender(std::string channelName)
+      : name(std::move(channelName))
+  {
+  }
+
+  const std::string name;
+  PublisherQueueSettings settings;
+  std::deque<SendStorageVec> queue;
+  bool shouldFinish{false};
+  std::mutex mutex;
+  std::condition_variable condition;      ///< queue is not empty
+  std::condition_variable spaceCondition; ///< queue is not full
+  std::thread thread;
+
+  // message counters
+  uint64_t enqueued{};
+  std::atomic<uint64_t> sent{};
+  std::atomic<uint64_t> dropped{};
+};
+
+namespace
+{
+
+/// Time the send thread waits before retrying a message which the socket
+/// could not take
+const std::chrono::milliseconds SEND_RETRY_INTERVAL{1};
+
+/// Copy frames which reference external memory, e.g. wave data
+SendStorageVec CopyFrames(const SendStorageVec &vec)
+{
+  SendStorageVec copy;
+  copy.reserve(vec.size());
+
+  for(const auto &elem : vec)
+  {
+    copy.emplace_back(SendStorage{
+        std::string(reinterpret_cast<const char *>(elem.GetPtr()),
+                    elem.GetLength())});
+  }
+
+  return copy;
+}
+
+/// @brief Let sending on the socket of the channel fail at the high water
+/// mark instead of silently dropping the message
+///
+/// The send thread then keeps the message, so that the queue fills up and
+/// the drop policy applies.
+void SetNoDrop(const std::string &channel, bool enable)
+{
+  try
+  {
+    GET_NAMED_SOCKET(socket, SocketTypes::Publisher, channel);
+
+    const int val = enable ? 1 : 0;
+    auto rc =
+        zmq_setsockopt(socket.get(), ZMQ_XPUB_NODROP, &val, sizeof(val));
+    ZEROMQ_ASSERT(rc == 0);
+  }
+  catch(const IgorException &e)
+  {
+    // e.g. the channel was closed meanwhile
+    DEBUG_OUTPUT("Could not set ZMQ_XPUB_NODROP on channel \"{}\": {}",
+                 channel, e.GetErrorCode());
+  }
+}
+
+/// Put the message back at the head of the queue as the socket could not
+/// take it, and wait before retrying
+void Requeue(ChannelSender &sender, SendStorageVec vec)
+{
+  std::unique_lock<std::mutex> lock(sender.mutex);
+
+  sender.queue.emplace_front(std::move(vec));
+
+  // the queue was filled up while sending
+  if(sender.queue.size() > sender.settings.capacity)
+  {
+    switch(sender.settings.dropPolicy)
+    {
+    case DropPolicy::Oldest:
+      sender.queue.pop_front();
+      sender.dropped++;
+      break;
+    case DropPolicy::Newest:
+      sender.queue.pop_back();
+      sender.dropped++;
+      break;
+    case DropPolicy::Block:
+      // the callers keep waiting until this message is sent
+      break;
+    }
+  }
+
+  sender.condition.wait_for(lock, SEND_RETRY_INTERVAL,
+                            [&sender] { return sender.shouldFinish; });
+}
+
+void WorkerThread(ChannelSenderPtr sender)
+{
+  const auto &channel = sender->name;
+
+  DEBUG_OUTPUT("Begin channel={}", channel);
+
+  Tracer::Instance().SetThreadName("PublisherSender " + channel);
+
+  for(;;)
+  {
+    SendStorageVec vec;
+
+    {
+      std::unique_lock<std::mutex> lock(sender->mutex);
+
+      sender->condition.wait(
+          lock, [&sender]
+          { return sender->shouldFinish || !sender->queue.empty(); });
+
+      // send the remaining messages before finishing
+      if(sender->queue.empty())
+      {
+        DEBUG_OUTPUT("Exiting");
+        break;
+      }
+
+      vec = std::move(sender->queue.front());
+      sender->queue.pop_front();
+    }
+
+    sender->spaceCondition.notify_one();
+
+    try
+    {
+      if(ZeroMQPublisherSendNow(channel, vec) >= 0)
+      {
+        sender->sent++;
+      }
+      else
+      {
+        // high water mark reached, the frames are still intact
+        Requeue(*sender, std::move(vec));
+      }
+
+      continue;
+    }
+    catch(const IgorException &e)
+    {
+      DEBUG_OUTPUT("Dropping message as sending failed with {}",
+                   e.GetErrorCode());
+    }
+    catch(const std::exception &e)
+    {
+      EMERGENCY_OUTPUT(
+          "Caught std::exception with what = \"{}\". This must NOT happen!",
+          e.what());
+    }
+    catch(...)
+    {
+      EMERGENCY_OUTPUT("Caught exception. This must NOT happen!");
+    }
+
+    sender->dropped++;
+  }
+}
+
+} // anonymous namespace
+
+bool ParseDropPolicy(const std::string &name, DropPolicy &policy)
+{
+  if(name == "oldest")
+  {
+    policy = DropPolicy::Oldest;
+    return true;
+  }
+  if(name == "newest")
+  {
+    policy = DropPolicy::Newest;
+    return true;
+  }
+  if(name == "block")
+  {
+    policy = DropPolicy::Block;
+    return true;
+  }
+
+  return false;
+}
+
+std::string GetDropPolicyString(DropPolicy policy)
+{
+  switch(policy)
+  {
+  case DropPolicy::Oldest:
+    return "oldest";
+  case DropPolicy::Newest:
+    return "newest";
+  case DropPolicy::Block:
+    return "block";
+  }
+
+  ASSERT(0);
+}
+
+void PublisherSender::Start(const std::string &channel,
+                            const PublisherQueueSettings &settings)
+{
+  ASSERT(settings.capacity > 0);
+
+  LockGuard lock(m_mutex);
+
+  auto it = m_senders.find(channel);
+
+  if(it != m_senders.end())
+  {
+    DEBUG_OUTPUT("Changing the send queue of channel \"{}\" to capacity={}, "
+                 "dropPolicy={}",
+                 channel, settings.capacity,
+                 GetDropPolicyString(settings.dropPolicy));
+
+    auto &sender = it->second;
+
+    {
+      std::lock_guard<std::mutex> senderLock(sender->mutex);
+
+      sender->settings = settings;
+
+      // shrink the queue right away if the new capacity is smaller
+      while(sender->queue.size() > settings.capacity)
+      {
+        sender->queue.pop_front();
+        sender->dropped++;
+      }
+    }
+
+    // the capacity or the policy might allow the blocked threads to continue
+    sender->spaceCondition.notify_all();
+    return;
+  }
+
+  DEBUG_OUTPUT("Starting the send thread of channel \"{}\" with capacity={}, "
+               "dropPolicy={}",
+               channel, settings.capacity,
+               GetDropPolicyString(settings.dropPolicy));
+
+  SetNoDrop(channel, true);
+
+  auto sender      = std::make_shared<ChannelSender>(channel);
+  sender->settings = settings;
+  sender->thread   = std::thread(WorkerThread, sender);
+
+  m_senders.emplace(channel, sender);
+}
+
+void PublisherSender::Stop(const std::string &channel)
+{
+  ChannelSenderPtr sender;
+
+  {
+    LockGuard lock(m_mutex);
+
+    auto it = m_senders.find(channel);
+
+    if(it == m_senders.end())
+    {
+      return;
+    }
+
+    sender = it->second;
+    m_senders.erase(it);
+  }
+
+  DEBUG_OUTPUT("Shutting down the send thread of channel \"{}\".", channel);
+
+  {
+    std::lock_guard<std::mutex> lock(sender->mutex);
+    sender->shouldFinish = true;
+  }
+
+  // the queued messages are sent out, subscribers not keeping up miss them as
+  // without send thread
+  SetNoDrop(channel, false);
+
+  sender->condition.notify_all();
+  sender->spaceCondition.notify_all();
+  sender->thread.join();
+}
+
+void PublisherSender::StopAll()
+{
+  std::vector<std::string> channels;
+
+  {
+    LockGuard lock(m_mutex);
+
+    for(const auto &entry : m_senders)
+    {
+      channels.push_back(entry.first);
+    }
+  }
+
+  for(const auto &channel : channels)
+  {
+    Stop(channel);
+  }
+}
+
+bool PublisherSender::Enqueue(const std::string &channel,
+                              const SendStorageVec &vec)
+{
+  auto sender = GetSender(channel);
+
+  if(!sender)
+  {
+    return false;
+  }
+
+  auto copy = CopyFrames(vec);
+
+  {
+    std::unique_lock<std::mutex> lock(sender->mutex);
+
+    // the send thread is gone, let the caller send it directly
+    if(sender->shouldFinish)
+    {
+      return false;
+    }
+
+    while(sender->queue.size() >= sender->settings.capacity)
+    {
+      switch(sender->settings.dropPolicy)
+      {
+      case DropPolicy::Oldest:
+        sender->queue.pop_front();
+        sender->dropped++;
+        break;
+      case DropPolicy::Newest:
+        sender->dropped++;
+        return true;
+      case DropPolicy::Block:
+        // the policy is checked again, it might have been changed meanwhile
+        sender->spaceCondition.wait(
+            lock,
+            [&sender]
+            {
+              return sender->shouldFinish ||
+                     sender->settings.dropPolicy != DropPolicy::Block ||
+                     sender->queue.size() < sender->settings.capacity;
+            });
+
+        if(sender->shouldFinish)
+        {
+          return false;
+        }
+        break;
+      }
+    }
+
+    sender->queue.emplace_back(std::move(copy));
+    sender->enqueued++;
+  }
+
+  sender->condition.notify_one();
+
+  return true;
+}
+
+json PublisherSender::GetStatistics(const std::string &channel)
+{
+  auto sender = GetSender(channel);
+
+  if(!sender)
+  {
+    PublisherQueueSettings settings;
+
+    return {{"capacity", 0},
+            {"dropPolicy", GetDropPolicyString(settings.dropPolicy)},
+            {"queued", 0},
+            {"enqueued", 0},
+            {"sent", 0},
+            {"dropped", 0}};
+  }
+
+  std::lock_guard<std::mutex> lock(sender->mutex);
+
+  return {{"capacity", sender->settings.capacity},
+          {"dropPolicy", GetDropPolicyString(sender->settings.dropPolicy)},
+          {"queued", sender->queue.size()},
+          {"enqueued", sender->enqueued},
+          {"sent", sender->sent.load()},
+          {"dropped", sender->dropped.load()}};
+}
+
+ChannelSenderPtr PublisherSender::GetSender(const std::string &channel)
+{
+  LockGuard lock(m_mutex);
+
+  auto it = m_senders.find(channel);
+
+  if(it == m_senders.end())
+  {
+    return nullptr;
+  }
+
+  return it->second;
+}
+
+PublisherSender::~PublisherSender()
+{
+  StopAll();
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// What to do with a message if the send queue of a channel is full
+enum class DropPolicy
+{
+  Oldest, ///< drop the oldest queued message
+  Newest, ///< drop the message to enqueue
+  Block   ///< wait until the send thread made room
+};
+
+/// Default number of messages in the send queue of a channel
+const size_t DEFAULT_PUB_QUEUE_CAPACITY = 1000;
+
+struct PublisherQueueSettings
+{
+  size_t capacity{DEFAULT_PUB_QUEUE_CAPACITY};
+  DropPolicy dropPolicy{DropPolicy::Oldest};
+};
+
+/// @brief Convert a policy name (`oldest`, `newest` or `block`) to its
+/// enumeration
+///
+/// @return true on success, false for unknown names
+bool ParseDropPolicy(const std::string &name, DropPolicy &policy);
+
+std::string GetDropPolicyString(DropPolicy policy);
+
+/// Send thread and message queue of a publisher channel, see
+/// PublisherSender.cpp
+struct ChannelSender;
+using ChannelSenderPtr = std::shared_ptr<ChannelSender>;
+
+/// @brief Send threads of publisher channels
+///
+/// For channels with a send queue the calling thread only copies the frames
+/// into the bounded queue of the channel and the send thread of the channel
+/// does the sending. The queued messages are still sent when the thread is
+/// stopped.
+class PublisherSender
+{
+public:
+  /// Access to singleton-type global object
+  static PublisherSender &Instance()
+  {
+    static PublisherSender obj;
+    return obj;
+  }
+
+  /// Start the send thread of the channel or change the settings of the
+  /// running one, the statistics are kept in the latter case
+  void Start(const std::string &channel,
+             const PublisherQueueSettings &settings);
+  void Stop(const std::string &channel);
+  void StopAll();
+
+  /// @brief Queue the frames for the send thread of the channel
+  ///
+  /// Full queues are handled according to the DropPolicy of the channel.
+  ///
+  /// @return false if the channel does not have a send thread
+  bool Enqueue(const std::string &channel, const SendStorageVec &vec);
+
+  /// @brief Return the queue settings and the message counters of the channel
+  ///
+  /// Channels without send thread report a capacity of zero.
+  json GetStatistics(const std::string &channel);
+
+private:
+  PublisherSender() = default;
+  ~PublisherSender();
+  PublisherSender(const PublisherSender &)            = delete;
+  PublisherSender &operator=(const PublisherSender &) = delete;
+
+  ChannelSenderPtr GetSender(const std::string &channel);
+
+  std::map<std::string, ChannelSenderPtr> m_senders;
+  std::recursive_mutex m_mutex;
+};
@@ -1,5 +1,7 @@
 #include "CallFunctionOperation.h"
+#include "NativeOperation.h"
 #include "RequestInterface.h"
+#include "RequestParser.h"
 #include "ZeroMQ.h"
 
 #include <utility>
@@ -19,43 +21,71 @@ bool IsValidMessageId(const std::string &messageId)
 
 } // anonymous namespace
 
-RequestInterface::RequestInterface(std::string callerIdentity,
-                                   const std::string &payload)
-    : m_callerIdentity(std::move(callerIdentity))
+RequestInterface::RequestInterface(std::string server,
+                                   std::string callerIdentity,
+                                   const std::string &payload,
+                                   std::string binary)
+    : m_server(std::move(server)), m_callerIdentity(std::move(callerIdentity)),
+      m_encoding(DetectMessageEncoding(payload))
 {
-  json doc;
+  ParsedRequest request;
   try
   {
-    doc = json::parse(payload);
+    request = ParseRequest(payload, m_encoding);
   }
-  catch(const std::exception &)
+  catch(const IgorException &)
   {
-    GlobalData::Instance().AddLogEntry(payload, m_callerIdentity,
-                                       MessageDirection::Incoming);
-    throw RequestInterfaceException(REQ_INVALID_JSON_OBJECT);
+    if(m_encoding == MessageEncoding::JSON)
+    {
+      GlobalData::Instance().AddLogEntry(payload, m_callerIdentity,
+                                         MessageDirection::Incoming);
+    }
+    else
+    {
+      GlobalData::Instance().AddLogEntry(
+          fmt::format("Invalid {} message with {} bytes",
+                      GetMessageEncodingString(m_encoding), payload.size()),
+          m_callerIdentity, MessageDirection::Incoming);
+    }
+
+    throw;
   }
 
-  // the idea is to log the incoming payload as json document if possible
-  GlobalData::Instance().AddLogEntry(doc, m_callerIdentity,
-                                     MessageDirection::Incoming);
+  // the idea is to log the incoming payload as json document if possible,
+  // the parsed document lacks the function parameters so decode it again
+  if(GlobalData::Instance().GetLoggingFlag())
+  {
+    GlobalData::Instance().AddLogEntry(DecodeMessage(payload, m_encoding),
+                                       m_callerIdentity,
+                                       MessageDirection::Incoming);
+  }
 
-  DEBUG_OUTPUT("JSON Document is valid, data={}", doc.dump());
-  FillFromJSON(doc);
+  DEBUG_OUTPUT("JSON Document is valid, size={}", payload.size());
+  FillFromJSON(request.doc, std::move(request.params), std::move(binary));
 }
 
 RequestInterface::RequestInterface(const std::string &payload)
-    : RequestInterface("", payload)
+    : RequestInterface(DEFAULT_SERVER_NAME, "", payload)
 {
 }
 
 void RequestInterface::CanBeProcessed() const
 {
+  TraceSpan span("CanBeProcessed");
+
+  if(IsStreamCredit())
+  {
+    throw RequestInterfaceException(REQ_INVALID_OPERATION);
+  }
+
   ASSERT(m_op);
   m_op->CanBeProcessed();
 }
 
 json RequestInterface::Call() const
 {
+  MEASURE_LATENCY(latency, "callFunction");
+  TraceSpan span("Call");
   ASSERT(m_op);
   auto reply = m_op->Call();
 
@@ -67,6 +97,11 @@ json RequestInterface::Call() const
   return reply;
 }
 
+std::string RequestInterface::GetServer() const
+{
+  return m_server;
+}
+
 std::string RequestInterface::GetCallerIdentity() const
 {
   return m_callerIdentity;
@@ -88,7 +123,38 @@ std::string RequestInterface::GetHistoryDuringOperation() const
   return m_op->GetHistoryDuringCall();
 }
 
-void RequestInterface::FillFromJSON(json j)
+CompressionSettings RequestInterface::GetCompression() const
+{
+  return m_compression;
+}
+
+MessageEncoding RequestInterface::GetEncoding() const
+{
+  return m_encoding;
+}
+
+StreamSettings RequestInterface::GetStream() const
+{
+  return m_stream;
+}
+
+bool RequestInterface::IsStreamCredit() const
+{
+  return m_isStreamCredit;
+}
+
+StreamCredit RequestInterface::GetStreamCredit() const
+{
+  return m_streamCredit;
+}
+
+std::chrono::steady_clock::time_point RequestInterface::GetReceivedTime() const
+{
+  return m_receivedTime;
+}
+
+void RequestInterface::FillFromJSON(const json &j, CallFunctionParams params,
+                                    std::string binary)
 {
   auto it = j.find("version");
 
@@ -125,14 +191,51 @@ void RequestInterface::FillFromJSON(json j)
     m_messageId = messageId;
   }
 
+  if(ParseStreamCredit(j, m_streamCredit))
+  {
+    m_isStreamCredit = true;
+    DEBUG_OUTPUT("Credit object could be created: id={}, chunks={}",
+                 m_streamCredit.id, m_streamCredit.chunks);
+    return;
+  }
+
+  m_compression = ParseCompressionRequest(j);
+  m_stream      = ParseStreamRequest(j);
+
+  const auto hasBinary = !binary.empty();
+
+  m_op = CreateNativeOperation(j, std::move(binary));
+
   it = j.find("CallFunction");
 
-  if(it == j.end() || !it.value().is_object())
+  if(it == j.end())
   {
-    throw RequestInterfaceException(REQ_INVALID_OPERATION);
+    if(!m_op)
+    {
+      throw RequestInterfaceException(REQ_INVALID_OPERATION);
+    }
   }
+  else
+  {
+    // only one operation per request
+    if(m_op || !it.value().is_object())
+    {
+      throw RequestInterfaceException(REQ_INVALID_OPERATION);
+    }
 
-  m_op = std::make_shared<CallFunctionOperation>(*it);
+    // binary data is only supported by native operations
+    if(hasBinary)
+    {
+      throw RequestInterfaceException(REQ_INVALID_OPERATION_FORMAT);
+    }
+
+    m_op = std::make_shared<CallFunctionOperation>(*it, std::move(params));
+  }
 
   DEBUG_OUTPUT("Request Object could be created: {}", *this);
 }
+
+uint64_t RequestInterface::GetTraceRequestId() const
+{
+  return m_traceRequestId;
+}
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "ZeroMQ.h"
+#include "Operation.h"
+#include "CallFunctionOperation.h"
+#include "MessageEncoding.h"
+#include "StreamedReply.h"
 
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
@@ -8,25 +12,55 @@
 class RequestInterface
 {
 public:
-  explicit RequestInterface(std::string callerIdentity,
-                            const std::string &payload);
+  /// @param binary optional binary frame following the JSON payload
+  explicit RequestInterface(std::string server, std::string callerIdentity,
+                            const std::string &payload,
+                            std::string binary = {});
   explicit RequestInterface(const std::string &payload);
   void CanBeProcessed() const;
   json Call() const;
 
+  /// @brief Return the name of the server which received the request
+  std::string GetServer() const;
   std::string GetCallerIdentity() const;
   bool HasValidMessageId() const;
   std::string GetMessageId() const;
   std::string GetHistoryDuringOperation() const;
+  CompressionSettings GetCompression() const;
+
+  /// @brief Return the encoding of the request, which is also used for the
+  /// reply
+  MessageEncoding GetEncoding() const;
+  StreamSettings GetStream() const;
+
+  /// @brief Return true for credit messages of streamed replies, these can
+  /// not be called
+  bool IsStreamCredit() const;
+  StreamCredit GetStreamCredit() const;
+
+  /// @brief Return the time the request was received
+  std::chrono::steady_clock::time_point GetReceivedTime() const;
+
+  /// @brief Return the request number used for tracing
+  uint64_t GetTraceRequestId() const;
 
   friend struct fmt::formatter<RequestInterface>;
 
 private:
-  void FillFromJSON(json j);
+  void FillFromJSON(const json &j, CallFunctionParams params,
+                    std::string binary);
 
   int m_version{};
-  std::string m_callerIdentity, m_messageId;
-  CallFunctionOperationPtr m_op;
+  std::string m_server, m_callerIdentity, m_messageId;
+  MessageEncoding m_encoding;
+  OperationPtr m_op;
+  CompressionSettings m_compression;
+  StreamSettings m_stream;
+  bool m_isStreamCredit{};
+  StreamCredit m_streamCredit;
+  std::chrono::steady_clock::time_point m_receivedTime{
+      std::chrono::steady_clock::now()};
+  uint64_t m_traceRequestId{::GetTraceRequestId()};
 };
 
 template <>
@@ -38,9 +72,9 @@ struct fmt::formatter<RequestInterface> : fmt::formatter<std::string>
   {
     return format_to(
         ctx.out(),
-        "version={}, callerIdentity={}, messageId={}, CallFunction: {}",
-        req.m_version, req.m_callerIdentity,
+        "version={}, callerIdentity={}, messageId={}, {}", req.m_version,
+        req.m_callerIdentity,
         (req.m_messageId.empty() ? "(not provided)" : req.m_messageId),
-        *(req.m_op));
+        req.m_op->ToString());
   }
 };
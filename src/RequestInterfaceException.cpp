@@ -24,6 +24,12 @@ std::string GetErrorMessageFromCode(int errorCode)
     return "Invalid optional messageID.";
   case REQ_OUT_OF_MEMORY:
     return "Request cancelled due to Out Of Memory condition.";
+  case REQ_INVALID_COMPRESSION:
+    return "Invalid optional compression object.";
+  case REQ_INVALID_STREAM:
+    return "Invalid optional stream or credit object.";
+  case REQ_NO_BACKEND:
+    return "Broker: No backend available.";
   case REQ_NON_EXISTING_FUNCTION:
     return "CallFunction: Unknown function.";
   case REQ_PROC_NOT_COMPILED:
@@ -41,6 +47,14 @@ std::string GetErrorMessageFromCode(int errorCode)
   case REQ_FUNCTION_ABORTED:
     return "CallFunction: The function was partially executed but aborted at "
            "some point.";
+  case REQ_INVALID_DECIMATION:
+    return "CallFunction: Invalid decimation object.";
+  case REQ_NON_EXISTING_WAVE:
+    return "Native operation: Unknown wave.";
+  case REQ_NON_EXISTING_DATAFOLDER:
+    return "Native operation: Unknown datafolder.";
+  case REQ_INVALID_WAVE_DATA:
+    return "Native operation: Data does not match the wave type or size.";
   default:
     ASSERT(0);
   }
@@ -0,0 +1,454 @@
+#include "ZeroMQ.h"
+#include "RequestParser.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+/// SAX handler building the document
+class DOMBuilder
+{
+public:
+  explicit DOMBuilder(json &root) : m_root(root)
+  {
+  }
+
+  bool null()
+  {
+    AddValue(nullptr);
+    return true;
+  }
+
+  bool boolean(bool val)
+  {
+    AddValue(val);
+    return true;
+  }
+
+  bool number_integer(json::number_integer_t val)
+  {
+    AddValue(val);
+    return true;
+  }
+
+  bool number_unsigned(json::number_unsigned_t val)
+  {
+    AddValue(val);
+    return true;
+  }
+
+  bool number_float(json::number_float_t val, const json::string_t &)
+  {
+    AddValue(val);
+    return true;
+  }
+
+  bool string(json::string_t &val)
+  {
+    AddValue(std::move(val));
+    return true;
+  }
+
+  bool binary(json::binary_t &val)
+  {
+    AddValue(std::move(val));
+    return true;
+  }
+
+  bool start_object(std::size_t)
+  {
+    m_stack.push_back(AddValue(json::value_t::object));
+    return true;
+  }
+
+  bool key(json::string_t &val)
+  {
+    // later duplicates replace earlier entries
+    m_element = &(*m_stack.back())[val];
+    return true;
+  }
+
+  bool end_object()
+  {
+    m_stack.pop_back();
+    return true;
+  }
+
+  bool start_array(std::size_t len)
+  {
+    m_stack.push_back(AddValue(json::value_t::array));
+
+    if(len != static_cast<std::size_t>(-1))
+    {
+      m_stack.back()->get_ref<json::array_t &>().reserve(len);
+    }
+
+    return true;
+  }
+
+  bool end_array()
+  {
+    m_stack.pop_back();
+    return true;
+  }
+
+  template <class Exception>
+  bool parse_error(std::size_t, const std::string &, const Exception &)
+  {
+    return false;
+  }
+
+private:
+  /// Add the value to the current array or object, return the added value
+  template <typename Value>
+  json *AddValue(Value &&val)
+  {
+    if(m_stack.empty())
+    {
+      m_root = json(std::forward<Value>(val));
+      return &m_root;
+    }
+
+    auto &parent = *m_stack.back();
+
+    if(parent.is_array())
+    {
+      parent.emplace_back(std::forward<Value>(val));
+      return &parent.back();
+    }
+
+    *m_element = json(std::forward<Value>(val));
+    return m_element;
+  }
+
+  json &m_root;
+  std::vector<json *> m_stack;
+  json *m_element{};
+};
+
+/// SAX handler building the request document, except for the elements of
+/// `CallFunction.params` which are converted into strings
+class RequestSaxHandler
+{
+public:
+  using number_integer_t  = json::number_integer_t;
+  using number_unsigned_t = json::number_unsigned_t;
+  using number_float_t    = json::number_float_t;
+  using string_t          = json::string_t;
+  using binary_t          = json::binary_t;
+
+  explicit RequestSaxHandler(ParsedRequest &request)
+      : m_dom(request.doc), m_params(request.params)
+  {
+  }
+
+  bool null()
+  {
+    return m_inParams ? AddInvalidParam() : m_dom.null();
+  }
+
+  bool boolean(bool val)
+  {
+    return m_inParams ? AddParam(std::to_string(val)) : m_dom.boolean(val);
+  }
+
+  bool number_integer(number_integer_t val)
+  {
+    return m_inParams ? AddParam(To_stringHighRes(static_cast<double>(val)))
+                      : m_dom.number_integer(val);
+  }
+
+  bool number_unsigned(number_unsigned_t val)
+  {
+    return m_inParams ? AddParam(To_stringHighRes(static_cast<double>(val)))
+                      : m_dom.number_unsigned(val);
+  }
+
+  bool number_float(number_float_t val, const string_t &str)
+  {
+    return m_inParams ? AddParam(To_stringHighRes(val))
+                      : m_dom.number_float(val, str);
+  }
+
+  bool string(string_t &val)
+  {
+    return m_inParams ? AddParam(std::move(val)) : m_dom.string(val);
+  }
+
+  bool binary(binary_t &val)
+  {
+    return m_inParams ? AddInvalidParam() : m_dom.binary(val);
+  }
+
+  bool start_object(std::size_t len)
+  {
+    if(m_inParams)
+    {
+      return StartNestedParam();
+    }
+
+    m_depth++;
+
+    if(m_depth == 2 && m_topLevelKey == "CallFunction")
+    {
+      m_inCallFunction = true;
+      m_callFunctionKey.clear();
+    }
+
+    return m_dom.start_object(len);
+  }
+
+  bool key(string_t &val)
+  {
+    if(m_inParams)
+    {
+      return true;
+    }
+
+    if(m_depth == 1)
+    {
+      m_topLevelKey = val;
+    }
+    else if(m_depth == 2 && m_inCallFunction)
+    {
+      m_callFunctionKey = val;
+    }
+
+    return m_dom.key(val);
+  }
+
+  bool end_object()
+  {
+    if(m_inParams)
+    {
+      return EndNestedParam();
+    }
+
+    if(m_depth == 2)
+    {
+      m_inCallFunction = false;
+    }
+
+    m_depth--;
+
+    return m_dom.end_object();
+  }
+
+  bool start_array(std::size_t len)
+  {
+    if(m_inParams)
+    {
+      return StartNestedParam();
+    }
+
+    if(m_inCallFunction && m_depth == 2 && m_callFunctionKey == "params")
+    {
+      // a later params entry replaces an earlier one, as for objects
+      m_params = CallFunctionParams();
+      m_inParams = true;
+
+      if(len != static_cast<std::size_t>(-1))
+      {
+        m_params.values.reserve(len);
+      }
+
+      return true;
+    }
+
+    m_depth++;
+
+    return m_dom.start_array(len);
+  }
+
+  bool end_array()
+  {
+    if(m_inParams)
+    {
+      if(m_paramsNesting > 0)
+      {
+        return EndNestedParam();
+      }
+
+      m_inParams = false;
+
+      // keep params in the document for the format checks
+      return m_dom.start_array(0) && m_dom.end_array();
+    }
+
+    m_depth--;
+
+    return m_dom.end_array();
+  }
+
+  template <class Exception>
+  bool parse_error(std::size_t position, const std::string &last_token,
+                   const Exception &ex)
+  {
+    return m_dom.parse_error(position, last_token, ex);
+  }
+
+private:
+  bool AddParam(std::string str)
+  {
+    // elements of nested arrays or objects are invalid anyway
+    if(m_paramsNesting == 0)
+    {
+      m_params.values.push_back(std::move(str));
+    }
+
+    return true;
+  }
+
+  bool AddInvalidParam()
+  {
+    m_params.valid = false;
+    return true;
+  }
+
+  bool StartNestedParam()
+  {
+    m_params.valid = false;
+    m_paramsNesting++;
+    return true;
+  }
+
+  bool EndNestedParam()
+  {
+    m_paramsNesting--;
+    return true;
+  }
+
+  DOMBuilder m_dom;
+  CallFunctionParams &m_params;
+
+  // the top-level object has depth 1
+  size_t m_depth{};
+  std::string m_topLevelKey, m_callFunctionKey;
+  bool m_inCallFunction{};
+  bool m_inParams{};
+  size_t m_paramsNesting{};
+};
+
+/// Generate the SAX events of the document
+bool GenerateEvents(const json &doc, RequestSaxHandler &handler)
+{
+  switch(doc.type())
+  {
+  case json::value_t::null:
+  case json::value_t::discarded:
+    return handler.null();
+  case json::value_t::boolean:
+    return handler.boolean(doc.get<bool>());
+  case json::value_t::number_integer:
+    return handler.number_integer(doc.get<json::number_integer_t>());
+  case json::value_t::number_unsigned:
+    return handler.number_unsigned(doc.get<json::number_unsigned_t>());
+  case json::value_t::number_float:
+    return handler.number_float(doc.get<json::number_float_t>(), {});
+  case json::value_t::string:
+  {
+    auto str = doc.get<json::string_t>();
+    return handler.string(str);
+  }
+  case json::value_t::binary:
+  {
+    auto binary = doc.get_binary();
+    return handler.binary(binary);
+  }
+  case json::value_t::object:
+  {
+    if(!handler.start_object(doc.size()))
+    {
+      return false;
+    }
+
+    for(const auto &elem : doc.items())
+    {
+      auto key = elem.key();
+
+      if(!handler.key(key) || !GenerateEvents(elem.value(), handler))
+      {
+        return false;
+      }
+    }
+
+    return handler.end_object();
+  }
+  case json::value_t::array:
+  {
+    if(!handler.start_array(doc.size()))
+    {
+      return false;
+    }
+
+    for(const auto &elem : doc)
+    {
+      if(!GenerateEvents(elem, handler))
+      {
+        return false;
+      }
+    }
+
+    return handler.end_array();
+  }
+  }
+
+  ASSERT(0);
+}
+
+bool Parse(const std::string &payload, MessageEncoding encoding,
+           RequestSaxHandler &handler)
+{
+  switch(encoding)
+  {
+  case MessageEncoding::JSON:
+    return json::sax_parse(payload, &handler);
+  case MessageEncoding::MessagePack:
+    return json::sax_parse(payload, &handler, json::input_format_t::msgpack);
+  case MessageEncoding::CBOR:
+  {
+    // the SAX interface treats tags as errors, skip the self-describe tag
+    // which most encoders add, see DetectMessageEncoding()
+    const auto skip = payload.compare(0, 3, "\xD9\xD9\xF7") == 0 ? 3 : 0;
+
+    return json::sax_parse(payload.begin() + skip, payload.end(), &handler,
+                           json::input_format_t::cbor);
+  }
+  }
+
+  ASSERT(0);
+}
+
+} // anonymous namespace
+
+ParsedRequest ParseRequest(const std::string &payload, MessageEncoding encoding)
+{
+  {
+    ParsedRequest request;
+    RequestSaxHandler handler(request);
+
+    if(Parse(payload, encoding, handler))
+    {
+      return request;
+    }
+  }
+
+  // other tags carry no information for us either, so decode them as
+  // DecodeMessage() does, which throws for malformed messages
+  if(encoding == MessageEncoding::CBOR)
+  {
+    const auto doc = DecodeMessage(payload, encoding);
+
+    ParsedRequest request;
+    RequestSaxHandler handler(request);
+
+    if(GenerateEvents(doc, handler))
+    {
+      return request;
+    }
+  }
+
+  throw RequestInterfaceException(REQ_INVALID_JSON_OBJECT);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "ZeroMQ.h"
+#include "CallFunctionOperation.h"
+#include "MessageEncoding.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+struct ParsedRequest
+{
+  /// Request document, the `params` array of `CallFunction` is empty
+  json doc;
+  CallFunctionParams params;
+};
+
+/// @brief Parse the request in a single pass with a SAX parser
+///
+/// All entries except the elements of the `params` array of `CallFunction`
+/// are stored in the document. The elements of `params`, which make up most of
+/// a typical request, are converted directly into the strings passed to the
+/// function. CBOR requests with tags, apart from the leading self-describe
+/// tag, are decoded into a document first.
+///
+/// Throws a RequestInterfaceException with REQ_INVALID_JSON_OBJECT for
+/// malformed requests.
+ParsedRequest ParseRequest(const std::string &payload,
+                           MessageEncoding encoding);
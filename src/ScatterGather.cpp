@@ -0,0 +1,250 @@
+#include "ZeroMQ.h"
+#include "ScatterGather.h"
+#include "Compression.h"
+#include "MessageEncoding.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/// Longest time we wait in zmq_poll before checking for user aborts
+const std::chrono::milliseconds MAX_POLL_INTERVAL{100};
+
+struct ScatterTarget
+{
+  std::string endpoint;
+  InternalSocketPtr socket;
+  bool pending{false};
+  bool received{false};
+  std::string error;
+  std::chrono::duration<double> latency{};
+  std::string reply;
+};
+
+std::string GetZeroMQErrorString()
+{
+  return zmq_strerror(zmq_errno());
+}
+
+void Send(ScatterTarget &target, const std::string &msg)
+{
+  auto rc = zmq_connect(target.socket.get(), target.endpoint.c_str());
+
+  if(rc != 0)
+  {
+    target.error = "connect: " + GetZeroMQErrorString();
+    return;
+  }
+
+#if !HAVE_THREADSAFE_SOCKETS
+  // empty
+  rc = zmq_send(target.socket.get(), nullptr, 0, ZMQ_SNDMORE);
+
+  if(rc != 0)
+  {
+    target.error = "send: " + GetZeroMQErrorString();
+    return;
+  }
+#endif
+
+  // payload
+  rc = zmq_send(target.socket.get(), msg.c_str(), msg.length(), 0);
+
+  if(rc < 0)
+  {
+    target.error = "send: " + GetZeroMQErrorString();
+    return;
+  }
+
+  target.pending = true;
+}
+
+/// Receive the reply, expects the same frames as ZeroMQClientReceive()
+void Receive(ScatterTarget &target, Clock::time_point start, bool decompress)
+{
+  zmq_msg_t msg;
+  auto rc = zmq_msg_init(&msg);
+  ZEROMQ_ASSERT(rc == 0);
+
+  target.pending  = false;
+  target.received = true;
+  target.latency  = Clock::now() - start;
+
+  rc = zmq_msg_recv(&msg, target.socket.get(), ZMQ_DONTWAIT);
+
+#if !HAVE_THREADSAFE_SOCKETS
+  // empty frame followed by the payload
+  if(rc == 0 && zmq_msg_more(&msg))
+  {
+    rc = zmq_msg_recv(&msg, target.socket.get(), ZMQ_DONTWAIT);
+  }
+  else
+  {
+    rc = -1;
+  }
+#endif
+
+  if(rc < 0 || zmq_msg_more(&msg))
+  {
+    target.error = "invalid message format";
+  }
+  else
+  {
+    try
+    {
+      if(decompress)
+      {
+        DecompressMessageIfRequired(&msg);
+      }
+
+      target.reply = CreateStringFromZMsg(&msg);
+    }
+    catch(const IgorException &)
+    {
+      target.error = "invalid message format";
+    }
+  }
+
+  rc = zmq_msg_close(&msg);
+  ZEROMQ_ASSERT(rc == 0);
+}
+
+json ToJSON(const ScatterTarget &target)
+{
+  json elem;
+  elem["endpoint"] = target.endpoint;
+  elem["error"]    = target.error;
+
+  if(target.received)
+  {
+    elem["latency"] = target.latency.count();
+  }
+  else
+  {
+    elem["latency"] = nullptr;
+  }
+
+  if(!target.error.empty())
+  {
+    elem["reply"] = nullptr;
+    return elem;
+  }
+
+  try
+  {
+    elem["reply"] =
+        DecodeMessage(target.reply, DetectMessageEncoding(target.reply));
+  }
+  catch(const IgorException &)
+  {
+    elem["reply"] = target.reply;
+  }
+
+  return elem;
+}
+
+} // anonymous namespace
+
+json ScatterGather(const std::vector<std::string> &endpoints,
+                   const std::string &msg, std::chrono::milliseconds timeout)
+{
+  std::vector<ScatterTarget> targets(endpoints.size());
+
+  for(size_t i = 0; i < endpoints.size(); i++)
+  {
+    targets[i].endpoint = endpoints[i];
+    targets[i].socket.reset(
+        GlobalData::Instance().CreateInternalSocket(SocketTypes::Client));
+  }
+
+  const auto start      = Clock::now();
+  const auto deadline   = start + timeout;
+  const auto decompress = RequestsCompression(msg);
+
+  for(auto &target : targets)
+  {
+    Send(target, msg);
+  }
+
+  GlobalData::Instance().AddLogEntry(msg, MessageDirection::Outgoing);
+
+  std::vector<zmq_pollitem_t> items;
+  std::vector<ScatterTarget *> pending;
+  std::string remainingError = "timeout";
+
+  for(;;)
+  {
+    items.clear();
+    pending.clear();
+
+    for(auto &target : targets)
+    {
+      if(target.pending)
+      {
+        items.push_back({target.socket.get(), 0, ZMQ_POLLIN, 0});
+        pending.push_back(&target);
+      }
+    }
+
+    const auto now = Clock::now();
+
+    if(pending.empty() || now >= deadline)
+    {
+      break;
+    }
+
+    const auto interval = std::min(
+        std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now),
+        MAX_POLL_INTERVAL);
+
+    // at least one millisecond to not spin if the deadline is imminent
+    auto rc = zmq_poll(items.data(), To<int>(items.size()),
+                       std::max(To<long>(interval.count()), 1L));
+    ZEROMQ_ASSERT(rc >= 0);
+
+    for(size_t i = 0; i < items.size(); i++)
+    {
+      if(items[i].revents & ZMQ_POLLIN)
+      {
+        Receive(*pending[i], start, decompress);
+        GlobalData::Instance().AddLogEntry(pending[i]->reply,
+                                           MessageDirection::Incoming);
+      }
+    }
+
+    if(SpinProcess()) // user requested abort
+    {
+      remainingError = "aborted";
+      break;
+    }
+
+    // allow the servers of this Igor Pro instance to reply
+    if(RunningInMainThread())
+    {
+      XOPSilentCommand("DoXOPIdle");
+    }
+  }
+
+  json doc = json::array();
+
+  for(auto &target : targets)
+  {
+    if(target.pending)
+    {
+      target.error = remainingError;
+    }
+
+    target.socket.reset();
+
+    DEBUG_OUTPUT("endpoint={}, error={}, latency={}", target.endpoint,
+                 target.error, target.latency.count());
+
+    doc.push_back(ToJSON(target));
+  }
+
+  return doc;
+}
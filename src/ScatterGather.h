@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// @brief Send one message to multiple servers and gather the replies
+///
+/// Every endpoint gets its own client socket, the message is sent to all of
+/// them before waiting for the first reply. The total time is therefore about
+/// the slowest round trip instead of the sum of all round trips.
+///
+/// Returns an array with one object per endpoint in the given order, e.g.
+/// `{"endpoint" : "tcp://127.0.0.1:5670", "error" : "", "latency" : 0.0012,
+/// "reply" : {...}}`.
+///
+/// `error` is empty on success, `latency` is in seconds and measured from
+/// sending the message. `reply` holds the decoded reply, see
+/// MessageEncoding.h, or the raw string if it can not be decoded. Both are
+/// `null` without reply.
+///
+/// Endpoints without a reply when the deadline `timeout` passes, or when the
+/// user aborts, get the error `timeout` or `aborted`.
+json ScatterGather(const std::vector<std::string> &endpoints,
+                   const std::string &msg, std::chrono::milliseconds timeout);
@@ -525,6 +525,122 @@ void AddDimensionLabelsEachIfSet(json &doc, waveHndl waveHandle,
   }
 }
 
+bool CanBeDecimated(int waveType, int numDims, waveHndl waveHandle,
+                    const WaveSerializationOptions &options)
+{
+  if(options.decimation == DecimationMethod::None)
+  {
+    return false;
+  }
+
+  // decimation is only done for real numeric 1D waves
+  if(numDims != 1 || (waveType & NT_CMPLX) ||
+     GetWaveElementSize(waveType) == 0)
+  {
+    return false;
+  }
+
+  return WavePoints(waveHandle) > options.points;
+}
+
+template <typename T>
+std::vector<size_t> DecimateImpl(fmt::memory_buffer &buf, waveHndl waveHandle,
+                                 const WaveSerializationOptions &options)
+{
+  const auto *data  = GetWaveDataPtr<T>(waveHandle);
+  const auto length = To<size_t>(WavePoints(waveHandle));
+
+  auto indices =
+      Decimate(options.decimation, data, length, To<size_t>(options.points));
+
+  std::vector<T> values(indices.size());
+  std::transform(indices.begin(), indices.end(), values.begin(),
+                 [data](size_t index) { return data[index]; });
+
+  OutputArray(buf, values.data(), To<CountInt>(values.size()));
+
+  return indices;
+}
+
+/// Decimate the wave data, writes the selected values into `buf` and returns
+/// the selected indices
+std::vector<size_t> DecimateWaveData(fmt::memory_buffer &buf, int waveType,
+                                     waveHndl waveHandle,
+                                     const WaveSerializationOptions &options)
+{
+  switch(waveType)
+  {
+  case NT_FP32:
+    return DecimateImpl<float>(buf, waveHandle, options);
+  case NT_FP64:
+    return DecimateImpl<double>(buf, waveHandle, options);
+  case NT_I8:
+    return DecimateImpl<int8_t>(buf, waveHandle, options);
+  case NT_I16:
+    return DecimateImpl<int16_t>(buf, waveHandle, options);
+  case NT_I32:
+    return DecimateImpl<int32_t>(buf, waveHandle, options);
+  case NT_I64:
+    return DecimateImpl<int64_t>(buf, waveHandle, options);
+  case NT_I8 | NT_UNSIGNED:
+    return DecimateImpl<uint8_t>(buf, waveHandle, options);
+  case NT_I16 | NT_UNSIGNED:
+    return DecimateImpl<uint16_t>(buf, waveHandle, options);
+  case NT_I32 | NT_UNSIGNED:
+    return DecimateImpl<uint32_t>(buf, waveHandle, options);
+  case NT_I64 | NT_UNSIGNED:
+    return DecimateImpl<uint64_t>(buf, waveHandle, options);
+  default:
+    ASSERT(0);
+  }
+}
+
+std::string GetDecimationMethodString(DecimationMethod method)
+{
+  switch(method)
+  {
+  case DecimationMethod::MinMax:
+    return "MinMax";
+  case DecimationMethod::LTTB:
+    return "LTTB";
+  case DecimationMethod::None:
+    break;
+  }
+
+  ASSERT(0);
+}
+
+/// Add the decimation information including the x-values of the selected
+/// points, the latter honour the dimension scaling of the wave
+void AddDecimation(json &doc, waveHndl waveHandle,
+                   const WaveSerializationOptions &options,
+                   const std::vector<size_t> &indices)
+{
+  double delta  = std::numeric_limits<double>::quiet_NaN();
+  double offset = std::numeric_limits<double>::quiet_NaN();
+
+  auto rc = MDGetWaveScaling(waveHandle, 0, &delta, &offset);
+  ASSERT(rc == 0);
+
+  std::vector<double> xValues(indices.size());
+  std::transform(indices.begin(), indices.end(), xValues.begin(),
+                 [offset, delta](size_t index)
+                 { return offset + static_cast<double>(index) * delta; });
+
+  fmt::memory_buffer buf;
+
+  OutputArray(buf, &indices[0], To<CountInt>(indices.size()));
+  doc["decimation"]["index"] = json::parse(to_string(buf));
+
+  buf.clear();
+
+  OutputArray(buf, &xValues[0], To<CountInt>(xValues.size()));
+  doc["decimation"]["x"] = json::parse(to_string(buf));
+
+  doc["decimation"]["method"] = GetDecimationMethodString(options.decimation);
+  doc["decimation"]["size"]   = json::array({WavePoints(waveHandle)});
+}
+
 void AddWaveNoteIfSet(json &doc, waveHndl waveHandle)
 {
   auto *handle = WaveNoteCopy(waveHandle);
@@ -540,8 +656,76 @@ void AddWaveNoteIfSet(json &doc, waveHndl waveHandle)
 
 } // anonymous namespace
 
-json SerializeWave(waveHndl waveHandle)
+WaveSerializationOptions ParseWaveSerializationOptions(const json &doc)
 {
+  WaveSerializationOptions options;
+
+  auto it = doc.find("decimation");
+
+  if(it == doc.end())
+  {
+    return options;
+  }
+
+  const auto &decimation = it.value();
+
+  if(!decimation.is_object() || decimation.size() != 2)
+  {
+    throw RequestInterfaceException(REQ_INVALID_DECIMATION);
+  }
+
+  it = decimation.find("method");
+
+  if(it == decimation.end() || !it.value().is_string())
+  {
+    throw RequestInterfaceException(REQ_INVALID_DECIMATION);
+  }
+
+  const auto method = it.value().get<std::string>();
+
+  CountInt minimumPoints = 0;
+
+  if(method == "MinMax")
+  {
+    options.decimation = DecimationMethod::MinMax;
+    minimumPoints      = 2;
+  }
+  else if(method == "LTTB")
+  {
+    options.decimation = DecimationMethod::LTTB;
+    minimumPoints      = 3;
+  }
+  else
+  {
+    throw RequestInterfaceException(REQ_INVALID_DECIMATION);
+  }
+
+  it = decimation.find("points");
+
+  if(it == decimation.end() || !it.value().is_number_integer())
+  {
+    throw RequestInterfaceException(REQ_INVALID_DECIMATION);
+  }
+
+  const auto points = it.value().get<int64_t>();
+
+  if(points < minimumPoints ||
+     points > static_cast<int64_t>(std::numeric_limits<CountInt>::max()))
+  {
+    throw RequestInterfaceException(REQ_INVALID_DECIMATION);
+  }
+
+  options.points = static_cast<CountInt>(points);
+
+  return options;
+}
+
+json SerializeWave(waveHndl waveHandle,
+                   const WaveSerializationOptions &options)
+{
+  MEASURE_LATENCY(latency, "serializeWave");
+  TraceSpan span("SerializeWave");
+
   if(waveHandle == nullptr)
   {
     return nullptr;
@@ -550,12 +734,32 @@ json SerializeWave(waveHndl waveHandle)
   const auto waveType = WaveType(waveHandle);
   const auto modDate  = GetModificationDate(waveHandle);
   const auto type     = GetWaveTypeString(waveType);
-  const auto rawData  = WaveToString(waveType, waveHandle);
 
   int numDims;
   auto dimSizes = GetWaveDimension(waveHandle, numDims);
   dimSizes.resize(numDims);
-  const auto dimSizesString = DimensionSizesToString(dimSizes);
+
+  const auto decimate =
+      options.withData &&
+      CanBeDecimated(waveType, numDims, waveHandle, options);
+
+  std::string rawData;
+  std::vector<size_t> decimatedIndices;
+
+  if(decimate)
+  {
+    fmt::memory_buffer buf;
+    decimatedIndices = DecimateWaveData(buf, waveType, waveHandle, options);
+    rawData          = to_string(buf);
+  }
+  else if(options.withData)
+  {
+    rawData = WaveToString(waveType, waveHandle);
+  }
+
+  const auto dimSizesString =
+      decimate ? DimensionSizesToString({To<CountInt>(decimatedIndices.size())})
+               : DimensionSizesToString(dimSizes);
 
   DEBUG_OUTPUT(
       "waveType={}, modDate={}, type={}, dimSizes={}, rawData={:.255s}",
@@ -564,14 +768,28 @@ json SerializeWave(waveHndl waveHandle)
   json doc;
   doc["type"]                 = type;
   doc["date"]["modification"] = modDate;
-  doc["data"]["raw"]          = json::parse(rawData);
   doc["dimension"]["size"]    = json::parse(dimSizesString);
 
+  if(options.withData)
+  {
+    doc["data"]["raw"] = json::parse(rawData);
+  }
+
   AddDataUnitIfSet(doc, waveHandle);
   AddDataFullScaleIfSet(doc, waveHandle);
   AddDimensionScalingIfSet(doc, waveHandle, dimSizes);
   AddDimensionUnitsIfSet(doc, waveHandle, dimSizes);
-  AddDimensionLabelsEachIfSet(doc, waveHandle, dimSizes);
+
+  if(decimate)
+  {
+    // labels for each index are not meaningful for a subset of the points
+    AddDecimation(doc, waveHandle, options, decimatedIndices);
+  }
+  else
+  {
+    AddDimensionLabelsEachIfSet(doc, waveHandle, dimSizes);
+  }
+
   AddDimensionLabelsFullIfSet(doc, waveHandle, dimSizes);
   AddWaveNoteIfSet(doc, waveHandle);
 
@@ -1,6 +1,21 @@
 #pragma once
 
+#include "Decimation.h"
+
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
 
-json SerializeWave(waveHndl waveHandle);
+struct WaveSerializationOptions
+{
+  DecimationMethod decimation{DecimationMethod::None};
+  CountInt points{0};
+  bool withData{true}; ///< false serializes only the metadata
+};
+
+/// @brief Parse the optional `decimation` object of an operation
+///
+/// Expected format: `{"method" : "MinMax" | "LTTB", "points" : 2000}`
+WaveSerializationOptions ParseWaveSerializationOptions(const json &doc);
+
+json SerializeWave(waveHndl waveHandle,
+                   const WaveSerializationOptions &options = {});
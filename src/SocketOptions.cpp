@@ -0,0 +1,96 @@
+#include "ZeroMQ.h"
+#include "SocketOptions.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+struct OptionDefinition
+{
+  const char *name;
+  int option;
+  int minimum;
+  int maximum;
+};
+
+const int MAX_INT = std::numeric_limits<int>::max();
+
+// clang-format off
+const std::array<OptionDefinition, 8> SOCKET_OPTIONS = {{
+  {"SNDHWM",              ZMQ_SNDHWM,              0,  MAX_INT},
+  {"RCVHWM",              ZMQ_RCVHWM,              0,  MAX_INT},
+  {"SNDBUF",              ZMQ_SNDBUF,              -1, MAX_INT},
+  {"RCVBUF",              ZMQ_RCVBUF,              -1, MAX_INT},
+  {"TCP_KEEPALIVE",       ZMQ_TCP_KEEPALIVE,       -1, 1},
+  {"TCP_KEEPALIVE_CNT",   ZMQ_TCP_KEEPALIVE_CNT,   -1, MAX_INT},
+  {"TCP_KEEPALIVE_IDLE",  ZMQ_TCP_KEEPALIVE_IDLE,  -1, MAX_INT},
+  {"TCP_KEEPALIVE_INTVL", ZMQ_TCP_KEEPALIVE_INTVL, -1, MAX_INT}
+}};
+
+const std::array<OptionDefinition, 3> CONTEXT_OPTIONS = {{
+  {"IO_THREADS",                 ZMQ_IO_THREADS,                 1, MAX_INT},
+  {"THREAD_AFFINITY_CPU_ADD",    ZMQ_THREAD_AFFINITY_CPU_ADD,    0, MAX_INT},
+  {"THREAD_AFFINITY_CPU_REMOVE", ZMQ_THREAD_AFFINITY_CPU_REMOVE, 0, MAX_INT}
+}};
+// clang-format on
+
+template <size_t N>
+bool ParseOption(const std::array<OptionDefinition, N> &definitions,
+                 const std::string &name, int value, ZeroMQOption &option)
+{
+  auto it = std::find_if(definitions.begin(), definitions.end(),
+                         [&name](const OptionDefinition &def)
+                         { return name == def.name; });
+
+  if(it == definitions.end() || value < it->minimum || value > it->maximum)
+  {
+    return false;
+  }
+
+  option = {it->option, value};
+
+  return true;
+}
+
+} // anonymous namespace
+
+bool ParseSocketOption(const std::string &name, int value,
+                       ZeroMQOption &option)
+{
+  return ParseOption(SOCKET_OPTIONS, name, value, option);
+}
+
+bool ParseContextOption(const std::string &name, int value,
+                        ZeroMQOption &option)
+{
+  return ParseOption(CONTEXT_OPTIONS, name, value, option);
+}
+
+void SetSocketOption(void *socket, const ZeroMQOption &option)
+{
+  DEBUG_OUTPUT("socket={}, option={}, value={}", socket, option.option,
+               option.value);
+
+  auto rc = zmq_setsockopt(socket, option.option, &option.value,
+                           sizeof(option.value));
+  ZEROMQ_ASSERT(rc == 0);
+}
+
+void *CreateContext(const ZeroMQOptionVec &options)
+{
+  auto context = zmq_ctx_new();
+  ZEROMQ_ASSERT(context != nullptr);
+
+  for(const auto &option : options)
+  {
+    DEBUG_OUTPUT("context={}, option={}, value={}", context, option.option,
+                 option.value);
+
+    auto rc = zmq_ctx_set(context, option.option, option.value);
+    ZEROMQ_ASSERT(rc == 0);
+  }
+
+  return context;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// @brief Socket or context option with its value
+///
+/// `option` is the ZMQ_* constant, all supported options are of type int.
+struct ZeroMQOption
+{
+  int option;
+  int value;
+};
+
+using ZeroMQOptionVec = std::vector<ZeroMQOption>;
+
+/// @brief Convert a socket option name, e.g. `SNDHWM`, and its value
+///
+/// Supports `SNDHWM`, `RCVHWM`, `SNDBUF`, `RCVBUF`, `TCP_KEEPALIVE`,
+/// `TCP_KEEPALIVE_CNT`, `TCP_KEEPALIVE_IDLE` and `TCP_KEEPALIVE_INTVL`.
+///
+/// @return true on success, false for unknown names or invalid values
+bool ParseSocketOption(const std::string &name, int value,
+                       ZeroMQOption &option);
+
+/// @brief Convert a context option name, e.g. `IO_THREADS`, and its value
+///
+/// Supports `IO_THREADS`, `THREAD_AFFINITY_CPU_ADD` and
+/// `THREAD_AFFINITY_CPU_REMOVE`.
+///
+/// @return true on success, false for unknown names or invalid values
+bool ParseContextOption(const std::string &name, int value,
+                        ZeroMQOption &option);
+
+/// @brief Set the socket option, throws on error
+void SetSocketOption(void *socket, const ZeroMQOption &option);
+
+/// @brief Return a new context with the given options set, throws on error
+void *CreateContext(const ZeroMQOptionVec &options);
@@ -3,15 +3,31 @@
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
 
-#define GET_SOCKET(A, ST)                                                      \
-  SocketWithMutex A(GlobalData::Instance().ZMQSocket(ST),                      \
-                    GlobalData::Instance().GetMutex(ST));
+#define GET_SOCKET(A, ST) SocketWithMutex A(ST, std::string());
+
+#define GET_NAMED_SOCKET(A, ST, NAME) SocketWithMutex A(ST, NAME);
+
+// Client and server sockets of builds with thread-safe sockets are used
+// without locking, see ThreadSafeSocket
+#if HAVE_THREADSAFE_SOCKETS
+#define GET_THREADSAFE_SOCKET(A, ST)                                           \
+  ThreadSafeSocket A(GlobalData::Instance().ZMQSocket(ST));
+
+#define GET_THREADSAFE_NAMED_SOCKET(A, ST, NAME)                               \
+  ThreadSafeSocket A(GlobalData::Instance().ZMQSocket(ST, NAME));
+#else
+#define GET_THREADSAFE_SOCKET(A, ST) GET_SOCKET(A, ST)
+
+#define GET_THREADSAFE_NAMED_SOCKET(A, ST, NAME) GET_NAMED_SOCKET(A, ST, NAME)
+#endif
 
 class SocketWithMutex
 {
 public:
-  SocketWithMutex(void *s, std::recursive_mutex &mutex)
-      : m_lock(mutex), m_plainSocket(s)
+  /// Locks the socket before reading it, see GlobalData::LockSocket()
+  SocketWithMutex(SocketTypes st, const std::string &name)
+      : m_plainSocket(
+            GlobalData::Instance().LockSocket(st, name, m_mutex, m_lock))
   {
     // DEBUG_OUTPUT("Locking {}",  m_plainSocket);
   }
@@ -30,6 +46,30 @@ public:
   }
 
 private:
-  LockGuard m_lock;
+  std::shared_ptr<std::recursive_mutex> m_mutex;
+  std::unique_lock<std::recursive_mutex> m_lock;
+  void *m_plainSocket;
+};
+
+/// @brief Socket which can be used from multiple threads at once
+///
+/// Only the draft ZMQ_CLIENT and ZMQ_SERVER sockets are thread-safe. They must
+/// not be closed while other threads still use them.
+class ThreadSafeSocket
+{
+public:
+  explicit ThreadSafeSocket(void *s) : m_plainSocket(s)
+  {
+  }
+
+  ThreadSafeSocket(const ThreadSafeSocket &)            = delete;
+  ThreadSafeSocket &operator=(const ThreadSafeSocket &) = delete;
+
+  void *get()
+  {
+    return m_plainSocket;
+  }
+
+private:
   void *m_plainSocket;
 };
@@ -0,0 +1,444 @@
+#include "ZeroMQ.h"
+#include "RequestInterface.h"
+#include "StreamedReply.h"
+
+#include <condition_variable>
+#include <map>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include <utility>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+struct StreamState
+{
+  std::string server;
+  std::string identity;
+  size_t credits{};
+  bool shouldFinish{false};
+  bool finished{false};
+  std::thread thread;
+};
+
+std::mutex streamMutex;
+std::condition_variable streamCondition;
+std::map<uint64_t, StreamState> streams;
+uint64_t lastStreamId;
+
+class ChunkedReplySender
+{
+public:
+  explicit ChunkedReplySender(const RequestInterfacePtr &req)
+      : m_server(req->GetServer()), m_identity(req->GetCallerIdentity()),
+        m_settings(req->GetStream()), m_compression(req->GetCompression())
+  {
+    if(req->HasValidMessageId())
+    {
+      m_messageId = req->GetMessageId();
+    }
+  }
+
+  uint64_t GetId() const
+  {
+    return m_id;
+  }
+
+  void SetId(uint64_t id)
+  {
+    m_id = id;
+  }
+
+  size_t GetChunkSize() const
+  {
+    return m_settings.chunkSize;
+  }
+
+  /// Send an empty last chunk marked as aborted, together with the error if
+  /// given
+  void SendAborted(const json &error) const
+  {
+    DEBUG_OUTPUT("Aborting stream {}", m_id);
+
+    auto header                 = CreateHeader(true);
+    header["stream"]["aborted"] = true;
+
+    if(!error.is_null())
+    {
+      header["stream"]["error"] = error;
+    }
+
+    ZeroMQServerSend(m_server, m_identity, header.dump(), "");
+  }
+
+  /// Wait for a credit of the client
+  ///
+  /// @return false if none was granted within the timeout or the stream
+  ///         should finish
+  bool AcquireCredit()
+  {
+    std::unique_lock<std::mutex> lock(streamMutex);
+    auto &state = streams.at(m_id);
+
+    const auto pred = [&state]
+    { return state.credits > 0 || state.shouldFinish; };
+
+    streamCondition.wait_for(lock, m_settings.timeout, pred);
+
+    if(state.credits == 0 || state.shouldFinish)
+    {
+      return false;
+    }
+
+    state.credits--;
+    return true;
+  }
+
+  void SendChunk(std::string chunk, bool last)
+  {
+    DEBUG_OUTPUT("stream={}, index={}, size={}, last={}", m_id, m_index,
+                 chunk.size(), last);
+
+    std::string compressed;
+    if(CompressFrame(m_compression, chunk.data(), chunk.size(), compressed))
+    {
+      chunk.swap(compressed);
+    }
+
+    ZeroMQServerSend(m_server, m_identity, CreateHeader(last).dump(),
+                     std::move(chunk));
+
+    m_index++;
+  }
+
+private:
+  json CreateHeader(bool last) const
+  {
+    json header;
+    header["stream"] = {{"id", m_id}, {"index", m_index}, {"last", last}};
+
+    if(!m_messageId.empty())
+    {
+      header[MESSAGEID_KEY] = m_messageId;
+    }
+
+    return header;
+  }
+
+  std::string m_server, m_identity, m_messageId;
+  StreamSettings m_settings;
+  CompressionSettings m_compression;
+  uint64_t m_id{};
+  uint64_t m_index{};
+};
+
+/// Thrown if the stream was aborted as no credit was granted in time
+struct StreamAbortedException
+{
+};
+
+/// Stream buffer sending the data written into it in chunks
+///
+/// Only one chunk is buffered, it is sent as soon as it is full and more data
+/// is written, or when the stream is finished.
+class ChunkStreamBuffer : public std::streambuf
+{
+public:
+  explicit ChunkStreamBuffer(ChunkedReplySender &sender) : m_sender(sender)
+  {
+    ResetChunk();
+  }
+
+  /// Send the buffered data as last chunk
+  void Finish()
+  {
+    SendChunk(true);
+  }
+
+protected:
+  int_type overflow(int_type ch) override
+  {
+    SendChunk(false);
+
+    if(!traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+    }
+
+    return traits_type::not_eof(ch);
+  }
+
+private:
+  void SendChunk(bool last)
+  {
+    if(!m_sender.AcquireCredit())
+    {
+      throw StreamAbortedException();
+    }
+
+    m_chunk.resize(pptr() - pbase());
+    m_sender.SendChunk(std::move(m_chunk), last);
+
+    ResetChunk();
+  }
+
+  void ResetChunk()
+  {
+    m_chunk.assign(m_sender.GetChunkSize(), '\0');
+    setp(&m_chunk[0], &m_chunk[0] + m_chunk.size());
+  }
+
+  ChunkedReplySender &m_sender;
+  std::string m_chunk;
+};
+
+/// Serialize the reply into chunks and send them
+void SendChunked(ChunkedReplySender &sender, const json &reply,
+                 MessageEncoding encoding)
+{
+  const auto id = sender.GetId();
+
+  ChunkStreamBuffer buffer(sender);
+  std::ostream stream(&buffer);
+
+  // pass on the exceptions of the stream buffer
+  stream.exceptions(std::ios::badbit);
+
+  try
+  {
+    EncodeMessage(reply, encoding, stream);
+    buffer.Finish();
+  }
+  catch(const StreamAbortedException &)
+  {
+    sender.SendAborted(json());
+
+    GlobalData::Instance().AddLogEntry(fmt::format(
+        "Aborted stream {} as no credits were granted in time.", id));
+  }
+  catch(const json::exception &e)
+  {
+    // e.g. invalid UTF-8 in strings, the chunks before were already sent
+    sender.SendAborted(e.what());
+
+    GlobalData::Instance().AddLogEntry(fmt::format(
+        "Aborted stream {} as serializing failed: {}", id, e.what()));
+  }
+}
+
+void SenderThread(ChunkedReplySender sender, json reply,
+                  MessageEncoding encoding)
+{
+  const auto id = sender.GetId();
+
+  DEBUG_OUTPUT("Begin stream={}", id);
+
+  Tracer::Instance().SetThreadName(fmt::format("StreamedReply {}", id));
+
+  try
+  {
+    MEASURE_LATENCY(latency, "replyStream");
+    SendChunked(sender, reply, encoding);
+  }
+  catch(const std::exception &e)
+  {
+    // e.g. the server was closed meanwhile
+    DEBUG_OUTPUT("Stream {} failed with \"{}\"", id, e.what());
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(streamMutex);
+    streams.at(id).finished = true;
+  }
+
+  DEBUG_OUTPUT("End stream={}", id);
+}
+
+/// Join the sender threads of the selected streams and forget them
+template <typename Predicate>
+void JoinStreams(Predicate pred)
+{
+  std::vector<std::pair<uint64_t, std::thread>> threads;
+
+  {
+    std::lock_guard<std::mutex> lock(streamMutex);
+
+    for(auto &entry : streams)
+    {
+      auto &state = entry.second;
+
+      if(state.thread.joinable() && pred(state))
+      {
+        state.shouldFinish = true;
+        threads.emplace_back(entry.first, std::move(state.thread));
+      }
+    }
+  }
+
+  streamCondition.notify_all();
+
+  for(auto &entry : threads)
+  {
+    entry.second.join();
+  }
+
+  std::lock_guard<std::mutex> lock(streamMutex);
+
+  for(const auto &entry : threads)
+  {
+    streams.erase(entry.first);
+  }
+}
+
+uint64_t RegisterStream(const RequestInterfacePtr &req)
+{
+  std::lock_guard<std::mutex> lock(streamMutex);
+
+  const auto id = ++lastStreamId;
+  auto &state    = streams[id];
+  state.server   = req->GetServer();
+  state.identity = req->GetCallerIdentity();
+  state.credits  = req->GetStream().window;
+
+  return id;
+}
+
+} // anonymous namespace
+
+StreamSettings ParseStreamRequest(const json &doc)
+{
+  StreamSettings settings;
+
+  auto it = doc.find("stream");
+
+  if(it == doc.end())
+  {
+    return settings;
+  }
+
+  const auto &stream = it.value();
+
+  if(!stream.is_object())
+  {
+    throw RequestInterfaceException(REQ_INVALID_STREAM);
+  }
+
+  for(const auto &elem : stream.items())
+  {
+    const auto &value = elem.value();
+
+    if(!value.is_number_unsigned())
+    {
+      throw RequestInterfaceException(REQ_INVALID_STREAM);
+    }
+
+    if(elem.key() == "chunkSize")
+    {
+      settings.chunkSize = value.get<size_t>();
+    }
+    else if(elem.key() == "window")
+    {
+      settings.window = value.get<size_t>();
+    }
+    else if(elem.key() == "timeout" &&
+            value.get<uint64_t>() <= std::numeric_limits<int32_t>::max())
+    {
+      settings.timeout = std::chrono::milliseconds(value.get<int32_t>());
+    }
+    else
+    {
+      throw RequestInterfaceException(REQ_INVALID_STREAM);
+    }
+  }
+
+  if(settings.chunkSize < MINIMUM_STREAM_CHUNK_SIZE || settings.window == 0)
+  {
+    throw RequestInterfaceException(REQ_INVALID_STREAM);
+  }
+
+  settings.enabled = true;
+
+  return settings;
+}
+
+bool ParseStreamCredit(const json &doc, StreamCredit &credit)
+{
+  auto it = doc.find("credit");
+
+  if(it == doc.end())
+  {
+    return false;
+  }
+
+  const auto &obj = it.value();
+
+  if(!obj.is_object() || obj.size() != 2)
+  {
+    throw RequestInterfaceException(REQ_INVALID_STREAM);
+  }
+
+  const auto id     = obj.find("id");
+  const auto chunks = obj.find("chunks");
+
+  if(id == obj.end() || chunks == obj.end() ||
+     !id.value().is_number_unsigned() ||
+     !chunks.value().is_number_unsigned() || chunks.value().get<size_t>() == 0)
+  {
+    throw RequestInterfaceException(REQ_INVALID_STREAM);
+  }
+
+  credit.id     = id.value().get<uint64_t>();
+  credit.chunks = chunks.value().get<size_t>();
+
+  return true;
+}
+
+void AddStreamCredit(const std::string &server, const std::string &identity,
+                     const StreamCredit &credit)
+{
+  {
+    std::lock_guard<std::mutex> lock(streamMutex);
+
+    auto it = streams.find(credit.id);
+
+    if(it == streams.end() || it->second.server != server ||
+       it->second.identity != identity)
+    {
+      DEBUG_OUTPUT("Ignoring credit for unknown stream {}", credit.id);
+      return;
+    }
+
+    auto &credits = it->second.credits;
+    credits += std::min(credit.chunks,
+                        std::numeric_limits<size_t>::max() - credits);
+  }
+
+  streamCondition.notify_all();
+}
+
+void SendStreamedReply(const RequestInterfacePtr &req, json reply)
+{
+  // forget the streams which finished meanwhile
+  JoinStreams([](const StreamState &state) { return state.finished; });
+
+  ChunkedReplySender sender(req);
+  sender.SetId(RegisterStream(req));
+
+  const auto id = sender.GetId();
+  std::thread thread(SenderThread, std::move(sender), std::move(reply),
+                     req->GetEncoding());
+
+  std::lock_guard<std::mutex> lock(streamMutex);
+  streams.at(id).thread = std::move(thread);
+}
+
+void StopStreamedReplies(const std::string &server)
+{
+  JoinStreams([&server](const StreamState &state)
+              { return state.server == server; });
+}
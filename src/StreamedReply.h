@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// @brief Streamed replies with credit based flow control
+///
+/// The sender thread of the stream serializes the reply into a buffer of
+/// `chunkSize` bytes and sends the buffer as chunk whenever it is full. A chunk
+/// is only sent if the client granted a credit for it, the request itself
+/// grants `window` credits, and serializing waits until then. So besides the
+/// reply document only the current chunk and at most `window` chunks queued in
+/// ZeroMQ are held in memory, but never the complete serialized reply.
+
+const size_t DEFAULT_STREAM_CHUNK_SIZE = 1024 * 1024;
+const size_t MINIMUM_STREAM_CHUNK_SIZE = 1024;
+const size_t DEFAULT_STREAM_WINDOW     = 4;
+const std::chrono::milliseconds DEFAULT_STREAM_TIMEOUT{10000};
+
+struct StreamSettings
+{
+  bool enabled{false};
+  size_t chunkSize{DEFAULT_STREAM_CHUNK_SIZE};
+  size_t window{DEFAULT_STREAM_WINDOW};
+  std::chrono::milliseconds timeout{DEFAULT_STREAM_TIMEOUT};
+};
+
+struct StreamCredit
+{
+  uint64_t id{};
+  size_t chunks{};
+};
+
+/// @brief Parse the optional `stream` object of a request
+///
+/// Expected format: `{"chunkSize" : 1048576, "window" : 4, "timeout" : 10000}`,
+/// all entries are optional.
+StreamSettings ParseStreamRequest(const json &doc);
+
+/// @brief Parse the `credit` object of a credit message
+///
+/// Expected format: `{"id" : 1, "chunks" : 4}`
+///
+/// @return false if the message is not a credit message
+bool ParseStreamCredit(const json &doc, StreamCredit &credit);
+
+/// @brief Grant additional credits to a running stream
+///
+/// Credits for unknown streams or from other callers are ignored, as the
+/// stream might have already finished.
+///
+/// Thread safe, called from the message handler thread.
+void AddStreamCredit(const std::string &server, const std::string &identity,
+                     const StreamCredit &credit);
+
+/// @brief Send the reply as a sequence of chunks
+///
+/// Hands the reply over to a new sender thread, which serializes it chunk by
+/// chunk and aborts the stream if the client did not grant a credit within
+/// the timeout. If serializing fails, e.g. due to invalid UTF-8, the stream is
+/// aborted with a last chunk holding the error.
+void SendStreamedReply(const RequestInterfacePtr &req, json reply);
+
+/// @brief Abort the running streams of the server and wait for their sender
+/// threads
+void StopStreamedReplies(const std::string &server);
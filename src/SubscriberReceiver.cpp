@@ -0,0 +1,504 @@
+#include "ZeroMQ.h"
+#include "SubscriberReceiver.h"
+
+#include <algorithm>
+#include <chrono>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+void CallSubscriberCallback(const std::string &name, const std::string &filter,
+                            const std::string &msg)
+{
+  FunctionInfo fip;
+
+  // the procedures might have changed since registering
+  if(!GetSubscriberCallbackInfo(name, fip))
+  {
+    DEBUG_OUTPUT("Dropping message as the callback function {} is invalid",
+                 name);
+    return;
+  }
+
+  // two string parameters, Igor Pro owns and disposes them
+  Handle params[2] = {WMNewHandle(filter.size()), WMNewHandle(msg.size())};
+  ASSERT(params[0] != nullptr && params[1] != nullptr);
+
+  memcpy(*params[0], filter.c_str(), filter.size());
+  memcpy(*params[1], msg.c_str(), msg.size());
+
+  double result;
+  auto rc = CallFunction(&fip, params, &result);
+
+  // e.g. the procedures are not compiled, the other messages are still
+  // delivered
+  if(rc != 0)
+  {
+    DEBUG_OUTPUT("Dropping message as calling {} failed with {}", name, rc);
+    return;
+  }
+
+  if(SpinProcess())
+  {
+    DEBUG_OUTPUT("The callback function {} was aborted", name);
+  }
+}
+
+} // anonymous namespace
+
+bool GetSubscriberCallbackInfo(const std::string &name, FunctionInfo &fip)
+{
+  if(name.empty() || GetFunctionInfo(name.c_str(), &fip) != 0)
+  {
+    return false;
+  }
+
+  return fip.returnType == NT_FP64 && fip.numRequiredParameters == 2 &&
+         fip.totalNumParameters == 2 &&
+         fip.parameterTypes[0] == HSTRING_TYPE &&
+         fip.parameterTypes[1] == HSTRING_TYPE;
+}
+
+void SubscriberReceiver::SetCapacity(const std::string &filter,
+                                     size_t capacity)
+{
+  DEBUG_OUTPUT("filter={}, capacity={}", filter, capacity);
+
+  ASSERT(capacity > 0);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto &buffer = m_buffers[filter];
+    Reconfigure(buffer, capacity, buffer.conflate);
+  }
+
+  Start();
+}
+
+void SubscriberReceiver::SetConflate(const std::string &filter, bool conflate)
+{
+  DEBUG_OUTPUT("filter={}, conflate={}", filter, conflate);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto &buffer = m_buffers[filter];
+    Reconfigure(buffer, buffer.capacity, conflate);
+  }
+
+  Start();
+}
+
+void SubscriberReceiver::SetCallback(const std::string &filter,
+                                     const std::string &callback)
+{
+  DEBUG_OUTPUT("filter={}, callback={}", filter, callback);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_buffers[filter].callback = callback;
+  }
+
+  Start();
+}
+
+void SubscriberReceiver::RemoveFilter(const std::string &filter)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto remove = [this](Buffer &buffer)
+  {
+    for(auto &msg : TakeAll(buffer))
+    {
+      Insert(m_defaultBuffer, std::move(msg));
+    }
+  };
+
+  if(filter.empty())
+  {
+    for(auto &entry : m_buffers)
+    {
+      remove(entry.second);
+    }
+
+    m_buffers.clear();
+    return;
+  }
+
+  auto it = m_buffers.find(filter);
+
+  if(it == m_buffers.end())
+  {
+    return;
+  }
+
+  remove(it->second);
+  m_buffers.erase(it);
+}
+
+bool SubscriberReceiver::IsRunning() const
+{
+  return m_running;
+}
+
+bool SubscriberReceiver::Receive(ZeroMQMessageSharedPtrVec &vec)
+{
+  using namespace std::chrono_literals;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  Buffer *next = nullptr;
+
+  auto findNext = [this, &next]
+  {
+    next = GetNextBuffer(false);
+    return next != nullptr;
+  };
+
+  if(!m_condition.wait_for(lock, 1ms, findNext))
+  {
+    return false;
+  }
+
+  vec = PopFront(*next).message;
+
+  return true;
+}
+
+json SubscriberReceiver::GetStatistics()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto doc = json::array();
+
+  auto entry      = GetStatistics(m_defaultBuffer);
+  entry["filter"] = nullptr;
+  doc.push_back(entry);
+
+  for(const auto &[filter, buffer] : m_buffers)
+  {
+    entry           = GetStatistics(buffer);
+    entry["filter"] = filter;
+    doc.push_back(entry);
+  }
+
+  return doc;
+}
+
+void SubscriberReceiver::DispatchCallbacks()
+{
+  if(!m_running)
+  {
+    return;
+  }
+
+  struct CallbackMessage
+  {
+    std::string callback;
+    ZeroMQMessageSharedPtrVec message;
+  };
+
+  std::vector<CallbackMessage> messages;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    while(auto *buffer = GetNextBuffer(true))
+    {
+      messages.push_back({buffer->callback, PopFront(*buffer).message});
+    }
+  }
+
+  // call without holding the lock, the callbacks can receive messages
+  for(const auto &[callback, vec] : messages)
+  {
+    if(vec.size() != 2)
+    {
+      DEBUG_OUTPUT("Dropping message with {} frames for callback {}",
+                   vec.size(), callback);
+      continue;
+    }
+
+    auto filter = CreateStringFromZMsg(vec[0]->get());
+    auto msg    = CreateStringFromZMsg(vec[1]->get());
+
+    GlobalData::Instance().AddLogEntry(filter + ":" + msg,
+                                       MessageDirection::Incoming);
+
+    CallSubscriberCallback(callback, filter, msg);
+  }
+}
+
+void SubscriberReceiver::Start()
+{
+  LockGuard lock(m_threadMutex);
+
+  if(m_running)
+  {
+    return;
+  }
+
+  DEBUG_OUTPUT("Starting the subscriber receive thread");
+
+  m_shouldFinish = false;
+  m_thread       = std::thread(&SubscriberReceiver::Run, this);
+  m_running      = true;
+}
+
+void SubscriberReceiver::Stop()
+{
+  LockGuard lock(m_threadMutex);
+
+  if(m_running)
+  {
+    DEBUG_OUTPUT("Shutting down the subscriber receive thread");
+
+    m_shouldFinish = true;
+    m_thread.join();
+    m_running = false;
+  }
+
+  std::lock_guard<std::mutex> dataLock(m_mutex);
+
+  m_defaultBuffer = Buffer();
+  m_buffers.clear();
+}
+
+void SubscriberReceiver::Run()
+{
+  DEBUG_OUTPUT("Begin");
+
+  Tracer::Instance().SetThreadName("SubscriberReceiver");
+
+  while(!m_shouldFinish)
+  {
+    try
+    {
+      ZeroMQMessageSharedPtrVec vec;
+
+      if(!ZeroMQSubscriberReceiveNow(vec, true))
+      {
+        continue;
+      }
+
+      Store(std::move(vec));
+    }
+    catch(const IgorException &e)
+    {
+      DEBUG_OUTPUT("Dropping message as receiving failed with {}",
+                   e.GetErrorCode());
+    }
+    catch(const std::exception &e)
+    {
+      EMERGENCY_OUTPUT(
+          "Caught std::exception with what = \"{}\". This must NOT happen!",
+          e.what());
+    }
+    catch(...)
+    {
+      EMERGENCY_OUTPUT("Caught exception. This must NOT happen!");
+    }
+  }
+
+  DEBUG_OUTPUT("Exiting");
+}
+
+void SubscriberReceiver::Store(ZeroMQMessageSharedPtrVec vec)
+{
+  auto topic = CreateStringFromZMsg(vec[0]->get());
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto &buffer = GetBuffer(topic);
+    buffer.received++;
+
+    Insert(buffer, {m_sequence++, std::move(topic), std::move(vec)});
+  }
+
+  m_condition.notify_one();
+}
+
+SubscriberReceiver::Buffer *SubscriberReceiver::GetNextBuffer(bool withCallback)
+{
+  Buffer *next          = nullptr;
+  uint64_t nextSequence = 0;
+  uint64_t sequence     = 0;
+
+  // the default buffer never has a callback
+  if(!withCallback && GetFrontSequence(m_defaultBuffer, sequence))
+  {
+    next         = &m_defaultBuffer;
+    nextSequence = sequence;
+  }
+
+  for(auto &entry : m_buffers)
+  {
+    auto &buffer = entry.second;
+
+    if(buffer.callback.empty() == withCallback)
+    {
+      continue;
+    }
+
+    if(GetFrontSequence(buffer, sequence) &&
+       (next == nullptr || sequence < nextSequence))
+    {
+      next         = &buffer;
+      nextSequence = sequence;
+    }
+  }
+
+  return next;
+}
+
+SubscriberReceiver::Buffer &
+SubscriberReceiver::GetBuffer(const std::string &topic)
+{
+  Buffer *buffer      = &m_defaultBuffer;
+  size_t matchingSize = 0;
+
+  for(auto &[filter, entry] : m_buffers)
+  {
+    if(topic.compare(0, filter.size(), filter) == 0 &&
+       (buffer == &m_defaultBuffer || filter.size() > matchingSize))
+    {
+      buffer       = &entry;
+      matchingSize = filter.size();
+    }
+  }
+
+  return *buffer;
+}
+
+void SubscriberReceiver::Reconfigure(Buffer &buffer, size_t capacity,
+                                     bool conflate)
+{
+  auto messages = TakeAll(buffer);
+
+  buffer.capacity = capacity;
+  buffer.conflate = conflate;
+
+  for(auto &msg : messages)
+  {
+    Insert(buffer, std::move(msg));
+  }
+}
+
+void SubscriberReceiver::Insert(Buffer &buffer, QueuedMessage msg)
+{
+  if(buffer.conflate)
+  {
+    auto it = buffer.latest.find(msg.topic);
+
+    if(it == buffer.latest.end())
+    {
+      buffer.topics.push_back(msg.topic);
+      buffer.latest.emplace(msg.topic, std::move(msg));
+      return;
+    }
+
+    // keep the position of the first unread message
+    it->second.message = std::move(msg.message);
+    buffer.dropped++;
+    return;
+  }
+
+  auto &queue = buffer.queue;
+
+  // messages moved from other buffers can be older than the queued ones
+  if(queue.empty() || queue.back().sequence < msg.sequence)
+  {
+    queue.push_back(std::move(msg));
+  }
+  else
+  {
+    auto it = std::upper_bound(queue.begin(), queue.end(), msg.sequence,
+                               [](uint64_t sequence, const QueuedMessage &entry)
+                               { return sequence < entry.sequence; });
+    queue.insert(it, std::move(msg));
+  }
+
+  while(queue.size() > buffer.capacity)
+  {
+    queue.pop_front();
+    buffer.dropped++;
+  }
+}
+
+bool SubscriberReceiver::GetFrontSequence(const Buffer &buffer,
+                                          uint64_t &sequence)
+{
+  if(buffer.conflate)
+  {
+    if(buffer.topics.empty())
+    {
+      return false;
+    }
+
+    sequence = buffer.latest.at(buffer.topics.front()).sequence;
+    return true;
+  }
+
+  if(buffer.queue.empty())
+  {
+    return false;
+  }
+
+  sequence = buffer.queue.front().sequence;
+  return true;
+}
+
+SubscriberReceiver::QueuedMessage SubscriberReceiver::PopFront(Buffer &buffer)
+{
+  if(buffer.conflate)
+  {
+    auto it = buffer.latest.find(buffer.topics.front());
+    ASSERT(it != buffer.latest.end());
+
+    auto msg = std::move(it->second);
+    buffer.latest.erase(it);
+    buffer.topics.pop_front();
+
+    return msg;
+  }
+
+  auto msg = std::move(buffer.queue.front());
+  buffer.queue.pop_front();
+
+  return msg;
+}
+
+std::vector<SubscriberReceiver::QueuedMessage>
+SubscriberReceiver::TakeAll(Buffer &buffer)
+{
+  std::vector<QueuedMessage> messages;
+  uint64_t sequence = 0;
+
+  while(GetFrontSequence(buffer, sequence))
+  {
+    messages.push_back(PopFront(buffer));
+  }
+
+  return messages;
+}
+
+json SubscriberReceiver::GetStatistics(const Buffer &buffer)
+{
+  return {{"capacity", buffer.capacity},
+          {"conflate", buffer.conflate},
+          {"queued", buffer.conflate ? buffer.topics.size()
+                                     : buffer.queue.size()},
+          {"received", buffer.received},
+          {"dropped", buffer.dropped}};
+}
+
+SubscriberReceiver::~SubscriberReceiver()
+{
+  Stop();
+}
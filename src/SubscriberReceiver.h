@@ -0,0 +1,154 @@
+#pragma once
+
+#include "ZeroMQ.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// Default number of messages kept per subscription by the receive thread,
+/// same as the default of ZMQ_RCVHWM in libzmq
+const size_t DEFAULT_SUB_QUEUE_CAPACITY = 1000;
+
+/// @brief Lookup the subscriber callback function `name`
+///
+/// The function must have the signature `Function proto(string filter,
+/// string msg)`.
+///
+/// @return true if the function exists, is compiled and has the right
+///         signature
+bool GetSubscriberCallbackInfo(const std::string &name, FunctionInfo &fip);
+
+/// @brief Receive thread of the subscriber socket
+///
+/// Is started by configuring the buffer of a subscription, see
+/// zeromq_sub_set_buffer() and zeromq_sub_set_conflate(), and runs until
+/// Stop(). The thread receives all messages into the buffers of their
+/// subscriptions and zeromq_sub_recv() and zeromq_sub_recv_multi() read from
+/// the buffers instead of the socket, oldest message first.
+///
+/// Messages are stored in the buffer of the longest configured subscription
+/// filter which is a prefix of their topic (the first frame), or in the
+/// default buffer. Each buffer is either a ring buffer, which drops the
+/// oldest message when it is full, or conflated, which only keeps the latest
+/// message per topic at the position of the first unread message of that
+/// topic. Dropped messages are counted per buffer.
+///
+/// The messages of buffers with a callback function are not returned by
+/// Receive() but passed to their callback function by DispatchCallbacks().
+class SubscriberReceiver
+{
+public:
+  /// Access to singleton-type global object
+  static SubscriberReceiver &Instance()
+  {
+    static SubscriberReceiver obj;
+    return obj;
+  }
+
+  /// @brief Set the capacity of the ring buffer of the subscription filter
+  ///
+  /// Starts the receive thread if required.
+  void SetCapacity(const std::string &filter, size_t capacity);
+
+  /// @brief Enable or disable conflation for the subscription filter
+  ///
+  /// Starts the receive thread if required.
+  void SetConflate(const std::string &filter, bool conflate);
+
+  /// @brief Set the Igor function called for messages of the subscription
+  /// filter, an empty name removes the callback
+  ///
+  /// Starts the receive thread if required.
+  void SetCallback(const std::string &filter, const std::string &callback);
+
+  /// @brief Remove the buffer of the removed subscription filter
+  ///
+  /// The empty string removes all. Already received messages are moved to
+  /// the default buffer.
+  void RemoveFilter(const std::string &filter);
+
+  bool IsRunning() const;
+
+  /// @brief Return the next message, waits at most one millisecond
+  ///
+  /// @return true if a message was returned, false on timeout
+  bool Receive(ZeroMQMessageSharedPtrVec &vec);
+
+  /// @brief Return settings and counters of all buffers
+  ///
+  /// The default buffer has `null` as filter.
+  json GetStatistics();
+
+  /// @brief Call the callback functions for all messages received so far
+  ///
+  /// Must be called from the main thread, messages arriving during the calls
+  /// are left for the next invocation.
+  void DispatchCallbacks();
+
+  /// Stop the receive thread and forget all buffers
+  void Stop();
+
+private:
+  SubscriberReceiver() = default;
+  ~SubscriberReceiver();
+  SubscriberReceiver(const SubscriberReceiver &)            = delete;
+  SubscriberReceiver &operator=(const SubscriberReceiver &) = delete;
+
+  struct QueuedMessage
+  {
+    uint64_t sequence;
+    std::string topic;
+    ZeroMQMessageSharedPtrVec message;
+  };
+
+  struct Buffer
+  {
+    size_t capacity{DEFAULT_SUB_QUEUE_CAPACITY};
+    bool conflate{false};
+    std::string callback;
+
+    std::deque<QueuedMessage> queue;
+
+    // conflated buffers only, the sequence of the latest message is the one
+    // of the first unread message of the topic
+    std::deque<std::string> topics;
+    std::map<std::string, QueuedMessage> latest;
+
+    uint64_t received{};
+    uint64_t dropped{};
+  };
+
+  void Start();
+  void Run();
+  void Store(ZeroMQMessageSharedPtrVec vec);
+
+  Buffer &GetBuffer(const std::string &topic);
+
+  /// Change the settings of a buffer and re-store its messages
+  void Reconfigure(Buffer &buffer, size_t capacity, bool conflate);
+
+  static void Insert(Buffer &buffer, QueuedMessage msg);
+  static bool GetFrontSequence(const Buffer &buffer, uint64_t &sequence);
+  static QueuedMessage PopFront(Buffer &buffer);
+
+  /// Return the buffer with the oldest message, nullptr if all are empty
+  Buffer *GetNextBuffer(bool withCallback);
+  static std::vector<QueuedMessage> TakeAll(Buffer &buffer);
+  static json GetStatistics(const Buffer &buffer);
+
+  std::thread m_thread;
+  std::atomic<bool> m_running{false};
+  std::atomic<bool> m_shouldFinish{false};
+  std::recursive_mutex m_threadMutex;
+
+  // protected by m_mutex
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  uint64_t m_sequence{};
+  Buffer m_defaultBuffer;
+  std::map<std::string, Buffer> m_buffers;
+};
@@ -0,0 +1,146 @@
+#include "ZeroMQ.h"
+#include "Tracing.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+namespace
+{
+
+std::atomic<uint64_t> lastRequestId{0};
+std::atomic<uint64_t> lastThreadId{0};
+
+thread_local uint64_t currentRequestId = 0;
+thread_local bool requestScopeActive   = false;
+
+/// Return a small number identifying the current thread
+uint64_t GetTraceThreadId()
+{
+  thread_local const uint64_t threadId = ++lastThreadId;
+
+  return threadId;
+}
+
+double ToMicroseconds(Tracer::Clock::duration duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+} // anonymous namespace
+
+uint64_t GetTraceRequestId()
+{
+  if(!requestScopeActive)
+  {
+    return 0;
+  }
+
+  if(currentRequestId == 0)
+  {
+    currentRequestId = ++lastRequestId;
+  }
+
+  return currentRequestId;
+}
+
+TraceRequestScope::TraceRequestScope(uint64_t requestId)
+    : m_previousRequestId(currentRequestId),
+      m_previousActive(requestScopeActive)
+{
+  currentRequestId   = requestId;
+  requestScopeActive = true;
+}
+
+TraceRequestScope::~TraceRequestScope()
+{
+  currentRequestId   = m_previousRequestId;
+  requestScopeActive = m_previousActive;
+}
+
+void Tracer::SetEnabled(bool val)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if(val && m_events.empty())
+  {
+    m_events.resize(DEFAULT_TRACE_CAPACITY);
+  }
+
+  m_enabled.store(val, std::memory_order_relaxed);
+}
+
+void Tracer::AddSpan(const char *name, Clock::time_point start,
+                     Clock::time_point end)
+{
+  const TraceEvent event{name, GetTraceThreadId(), GetTraceRequestId(), start,
+                         end};
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if(m_events.empty())
+  {
+    return;
+  }
+
+  m_events[m_next] = event;
+  m_next++;
+
+  if(m_next == m_events.size())
+  {
+    m_next    = 0;
+    m_wrapped = true;
+  }
+}
+
+void Tracer::SetThreadName(const std::string &name)
+{
+  const auto threadId = GetTraceThreadId();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_threadNames[threadId] = name;
+}
+
+json Tracer::Dump()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  json events = json::array();
+
+  for(const auto &elem : m_threadNames)
+  {
+    events.push_back({{"name", "thread_name"},
+                      {"ph", "M"},
+                      {"pid", 1},
+                      {"tid", elem.first},
+                      {"args", {{"name", elem.second}}}});
+  }
+
+  // oldest entries first
+  const auto first = m_wrapped ? m_next : 0;
+  const auto count = m_wrapped ? m_events.size() : m_next;
+
+  for(size_t i = 0; i < count; i++)
+  {
+    const auto &event = m_events[(first + i) % m_events.size()];
+
+    json elem = {{"name", event.name},
+                 {"cat", "request"},
+                 {"ph", "X"},
+                 {"ts", ToMicroseconds(event.start - m_origin)},
+                 {"dur", ToMicroseconds(event.end - event.start)},
+                 {"pid", 1},
+                 {"tid", event.threadId}};
+
+    if(event.requestId != 0)
+    {
+      elem["args"] = {{"request", event.requestId}};
+    }
+
+    events.push_back(std::move(elem));
+  }
+
+  m_next    = 0;
+  m_wrapped = false;
+
+  return {{"traceEvents", events}, {"displayTimeUnit", "ns"}};
+}
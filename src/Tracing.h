@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// @brief Span tracing of the request pipeline
+///
+/// Spans are stored in a ring buffer and can be dumped in the Chrome trace
+/// event format, which can be viewed with `chrome://tracing` or
+/// https://ui.perfetto.dev. All spans of one request share the same request
+/// number. Everything is a no-op when disabled, see
+/// ZeroMQ_SET_FLAGS::TRACING.
+
+const size_t DEFAULT_TRACE_CAPACITY = 65536;
+
+class Tracer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Access to singleton-type global object
+  static Tracer &Instance()
+  {
+    static Tracer obj;
+    return obj;
+  }
+
+  /// @brief Enable/disable tracing, the ring buffer is allocated on first
+  /// enabling
+  void SetEnabled(bool val);
+
+  bool IsEnabled() const
+  {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Add a span of the current thread
+  ///
+  /// @param name static string
+  void AddSpan(const char *name, Clock::time_point start,
+               Clock::time_point end);
+
+  /// @brief Name the current thread in the trace output
+  void SetThreadName(const std::string &name);
+
+  /// @brief Return all spans in the Chrome trace event format and clear the
+  /// ring buffer
+  json Dump();
+
+private:
+  Tracer()                          = default;
+  ~Tracer()                         = default;
+  Tracer(const Tracer &)            = delete;
+  Tracer &operator=(const Tracer &) = delete;
+
+  struct TraceEvent
+  {
+    const char *name;
+    uint64_t threadId;
+    uint64_t requestId;
+    Clock::time_point start;
+    Clock::time_point end;
+  };
+
+  std::atomic<bool> m_enabled{false};
+  std::mutex m_mutex;
+  std::vector<TraceEvent> m_events;
+  size_t m_next{0};
+  bool m_wrapped{false};
+  std::map<uint64_t, std::string> m_threadNames;
+  const Clock::time_point m_origin{Clock::now()};
+};
+
+/// @brief Return the request number of the current thread
+///
+/// Inside a TraceRequestScope without a given number a new one is assigned on
+/// first use. Returns zero outside of a scope.
+uint64_t GetTraceRequestId();
+
+/// @brief All spans of the current thread belong to the given request during
+/// the lifetime of the object
+///
+/// Zero as request number assigns a new number lazily, so that waiting for
+/// messages without receiving one does not consume numbers.
+class TraceRequestScope
+{
+public:
+  explicit TraceRequestScope(uint64_t requestId = 0);
+  ~TraceRequestScope();
+
+  TraceRequestScope(const TraceRequestScope &)            = delete;
+  TraceRequestScope &operator=(const TraceRequestScope &) = delete;
+
+private:
+  uint64_t m_previousRequestId;
+  bool m_previousActive;
+};
+
+/// @brief Record the lifetime of the object as span
+class TraceSpan
+{
+public:
+  /// @param name static string
+  explicit TraceSpan(const char *name)
+      : m_name(name), m_enabled(Tracer::Instance().IsEnabled())
+  {
+    if(m_enabled)
+    {
+      m_start = Tracer::Clock::now();
+    }
+  }
+
+  ~TraceSpan()
+  {
+    if(m_enabled)
+    {
+      Tracer::Instance().AddSpan(m_name, m_start, Tracer::Clock::now());
+    }
+  }
+
+  TraceSpan(const TraceSpan &)            = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+  const char *m_name;
+  bool m_enabled;
+  Tracer::Clock::time_point m_start;
+};
@@ -0,0 +1,1505 @@
+#include "FakeIgor.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// Located at the start of the wave block, followed by the numeric data
+struct IgorWaveHeader
+{
+  struct IgorWave *wave;
+};
+
+namespace
+{
+
+/// Offset of the numeric data in the wave block
+constexpr BCInt DATA_OFFSET = 16;
+static_assert(sizeof(IgorWaveHeader) <= DATA_OFFSET, "Invalid data offset");
+
+/// Seconds between the Igor Pro (1904) and the unix (1970) epoch
+constexpr TickCountInt IGOR_EPOCH_OFFSET = 2082844800;
+
+struct HandleBlock
+{
+  char *data;
+  BCInt size;
+};
+
+TickCountInt GetIgorDateNow()
+{
+  const auto now = std::chrono::system_clock::now().time_since_epoch();
+
+  return static_cast<TickCountInt>(
+             std::chrono::duration_cast<std::chrono::seconds>(now).count()) +
+         IGOR_EPOCH_OFFSET;
+}
+
+std::string ToLower(std::string str)
+{
+  std::transform(str.begin(), str.end(), str.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+
+  return str;
+}
+
+size_t GetElementSize(int type)
+{
+  size_t size = 0;
+
+  switch(type & ~(NT_CMPLX | NT_UNSIGNED))
+  {
+  case NT_FP32:
+  case NT_I32:
+    size = 4;
+    break;
+  case NT_FP64:
+  case NT_I64:
+    size = 8;
+    break;
+  case NT_I8:
+    size = 1;
+    break;
+  case NT_I16:
+    size = 2;
+    break;
+  case WAVE_TYPE:
+    return sizeof(waveHndl);
+  case DATAFOLDER_TYPE:
+    return sizeof(DataFolderHandle);
+  default:
+    return 0;
+  }
+
+  return (type & NT_CMPLX) ? 2 * size : size;
+}
+
+/// Call `func` with a pointer of the C++ type of the numeric wave type
+template <typename F>
+bool VisitNumeric(int type, void *data, F func)
+{
+  switch(type & ~NT_CMPLX)
+  {
+  case NT_FP32:
+    func(static_cast<float *>(data));
+    return true;
+  case NT_FP64:
+    func(static_cast<double *>(data));
+    return true;
+  case NT_I8:
+    func(static_cast<int8_t *>(data));
+    return true;
+  case NT_I16:
+    func(static_cast<int16_t *>(data));
+    return true;
+  case NT_I32:
+    func(static_cast<int32_t *>(data));
+    return true;
+  case NT_I64:
+    func(static_cast<int64_t *>(data));
+    return true;
+  case NT_I8 | NT_UNSIGNED:
+    func(static_cast<uint8_t *>(data));
+    return true;
+  case NT_I16 | NT_UNSIGNED:
+    func(static_cast<uint16_t *>(data));
+    return true;
+  case NT_I32 | NT_UNSIGNED:
+    func(static_cast<uint32_t *>(data));
+    return true;
+  case NT_I64 | NT_UNSIGNED:
+    func(static_cast<uint64_t *>(data));
+    return true;
+  default:
+    return false;
+  }
+}
+
+struct UserFunctionEntry
+{
+  std::string name;
+  int returnType;
+  std::vector<int> paramTypes;
+  FakeIgor::UserFunction func;
+};
+
+} // anonymous namespace
+
+struct IgorWave
+{
+  std::string name;
+  IgorDataFolder *folder{};
+  int type{};
+  std::array<CountInt, MAX_DIMENSIONS + 1> dimensionSizes{};
+  std::array<double, MAX_DIMENSIONS> delta{1.0, 1.0, 1.0, 1.0};
+  std::array<double, MAX_DIMENSIONS> offset{};
+  double fullScaleTop{};
+  double fullScaleBottom{};
+  // data units followed by the dimension units
+  std::array<std::string, MAX_DIMENSIONS + 1> units;
+  std::map<std::pair<int, IndexInt>, std::string> labels;
+  std::string note;
+  TickCountInt modDate{GetIgorDateNow()};
+  int refCount{};
+  std::vector<std::string> text;
+  char *block{};
+
+  IgorWave()                            = default;
+  IgorWave(const IgorWave &)            = delete;
+  IgorWave &operator=(const IgorWave &) = delete;
+
+  ~IgorWave()
+  {
+    std::free(block);
+  }
+
+  waveHndl GetHandle()
+  {
+    return reinterpret_cast<waveHndl>(&block);
+  }
+
+  char *GetData() const
+  {
+    return block + DATA_OFFSET;
+  }
+
+  int GetNumDimensions() const
+  {
+    int numDims = 0;
+    while(numDims < MAX_DIMENSIONS && dimensionSizes[numDims] > 0)
+    {
+      numDims++;
+    }
+
+    return numDims;
+  }
+
+  CountInt GetNumPoints() const
+  {
+    if(dimensionSizes[0] == 0)
+    {
+      return 0;
+    }
+
+    CountInt numPoints = 1;
+    for(int i = 0; i < GetNumDimensions(); i++)
+    {
+      numPoints *= dimensionSizes[i];
+    }
+
+    return numPoints;
+  }
+
+  /// Return the linear index or -1 if out of range
+  CountInt GetLinearIndex(const IndexInt indices[MAX_DIMENSIONS]) const
+  {
+    CountInt index  = 0;
+    CountInt stride = 1;
+
+    for(int i = 0; i < GetNumDimensions(); i++)
+    {
+      if(indices[i] < 0 || indices[i] >= dimensionSizes[i])
+      {
+        return -1;
+      }
+
+      index += indices[i] * stride;
+      stride *= dimensionSizes[i];
+    }
+
+    return GetNumPoints() > 0 ? index : -1;
+  }
+
+  /// Allocate the block for the current dimensions, the data is zeroed
+  void Allocate()
+  {
+    const auto numBytes =
+        static_cast<size_t>(GetNumPoints()) * GetElementSize(type);
+
+    std::free(block);
+    block = static_cast<char *>(std::calloc(1, DATA_OFFSET + numBytes));
+    new(block) IgorWaveHeader{this};
+
+    text.assign(type == TEXT_WAVE_TYPE ? GetNumPoints() : 0, std::string());
+  }
+};
+
+namespace
+{
+
+IgorWave *GetWave(waveHndl waveH)
+{
+  return (*waveH)->wave;
+}
+
+} // anonymous namespace
+
+struct IgorDataFolder
+{
+  std::string name;
+  IgorDataFolder *parent{};
+  std::vector<std::unique_ptr<IgorDataFolder>> children;
+  std::vector<std::unique_ptr<IgorWave>> waves;
+
+  IgorDataFolder *FindChild(const std::string &childName) const
+  {
+    for(const auto &child : children)
+    {
+      if(ToLower(child->name) == ToLower(childName))
+      {
+        return child.get();
+      }
+    }
+
+    return nullptr;
+  }
+
+  std::string GetPath() const
+  {
+    const auto quotedName =
+        std::all_of(name.begin(), name.end(),
+                    [](unsigned char c) { return std::isalnum(c) || c == '_'; })
+            ? name
+            : "'" + name + "'";
+
+    return parent ? parent->GetPath() + quotedName + ":" : name + ":";
+  }
+};
+
+namespace
+{
+
+struct State
+{
+  std::recursive_mutex mutex;
+  std::unique_ptr<IgorDataFolder> root;
+  std::map<std::string, UserFunctionEntry> functions;
+  bool compiled{true};
+  bool abortRequested{};
+  std::function<void()> idleHandler;
+  std::vector<std::string> history{""};
+  std::thread::id mainThread{std::this_thread::get_id()};
+
+  State()
+  {
+    root       = std::make_unique<IgorDataFolder>();
+    root->name = "root";
+  }
+};
+
+State &GetState()
+{
+  static State state;
+  return state;
+}
+
+using Lock = std::lock_guard<std::recursive_mutex>;
+
+/// Split a data folder path at `:` and remove quotes of liberal names
+std::vector<std::string> SplitPath(const std::string &path)
+{
+  std::vector<std::string> elements;
+  std::string current;
+  bool quoted = false;
+
+  for(auto c : path)
+  {
+    if(c == '\'')
+    {
+      quoted = !quoted;
+    }
+    else if(c == ':' && !quoted)
+    {
+      elements.push_back(current);
+      current.clear();
+    }
+    else
+    {
+      current += c;
+    }
+  }
+
+  elements.push_back(current);
+
+  return elements;
+}
+
+template <typename T>
+int GetPointValue(waveHndl waveH, IndexInt indices[MAX_DIMENSIONS], T value[2])
+{
+  auto *wave = GetWave(waveH);
+
+  if(wave->type == TEXT_WAVE_TYPE)
+  {
+    return NUMERIC_ACCESS_ON_TEXT_WAVE;
+  }
+
+  const auto index = wave->GetLinearIndex(indices);
+
+  if(index < 0)
+  {
+    return INDEX_OUT_OF_RANGE;
+  }
+
+  const auto isComplex = (wave->type & NT_CMPLX) != 0;
+  const auto found = VisitNumeric(wave->type, wave->GetData(), [&](auto *data) {
+    const auto offset = isComplex ? 2 * index : index;
+    value[0]          = static_cast<T>(data[offset]);
+    value[1]          = isComplex ? static_cast<T>(data[offset + 1]) : T{};
+  });
+
+  return found ? 0 : NUMERIC_ACCESS_ON_TEXT_WAVE;
+}
+
+template <typename T>
+int SetPointValue(waveHndl waveH, IndexInt indices[MAX_DIMENSIONS], T value[2])
+{
+  auto *wave = GetWave(waveH);
+
+  if(wave->type == TEXT_WAVE_TYPE)
+  {
+    return NUMERIC_ACCESS_ON_TEXT_WAVE;
+  }
+
+  const auto index = wave->GetLinearIndex(indices);
+
+  if(index < 0)
+  {
+    return INDEX_OUT_OF_RANGE;
+  }
+
+  const auto isComplex = (wave->type & NT_CMPLX) != 0;
+  const auto found = VisitNumeric(wave->type, wave->GetData(), [&](auto *data) {
+    using ElementType = std::remove_pointer_t<decltype(data)>;
+
+    const auto offset = isComplex ? 2 * index : index;
+    data[offset]      = static_cast<ElementType>(value[0]);
+
+    if(isComplex)
+    {
+      data[offset + 1] = static_cast<ElementType>(value[1]);
+    }
+  });
+
+  wave->modDate = GetIgorDateNow();
+
+  return found ? 0 : NUMERIC_ACCESS_ON_TEXT_WAVE;
+}
+
+} // anonymous namespace
+
+// FakeIgor
+
+void FakeIgor::Reset()
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  state.root->children.clear();
+  state.root->waves.clear();
+  state.functions.clear();
+  state.compiled       = true;
+  state.abortRequested = false;
+  state.idleHandler    = nullptr;
+  state.history        = {""};
+  state.mainThread     = std::this_thread::get_id();
+}
+
+void FakeIgor::AddFunction(const std::string &name, int returnType,
+                           const std::vector<int> &paramTypes,
+                           UserFunction func)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  state.functions[ToLower(name)] = {name, returnType, paramTypes,
+                                    std::move(func)};
+}
+
+void FakeIgor::SetCompiled(bool compiled)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  state.compiled = compiled;
+}
+
+void FakeIgor::SetIdleHandler(std::function<void()> handler)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  state.idleHandler = std::move(handler);
+}
+
+DataFolderHandle FakeIgor::MakeDataFolder(const std::string &path)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  const auto elements = SplitPath(path);
+
+  if(elements.empty() || ToLower(elements.front()) != "root")
+  {
+    return nullptr;
+  }
+
+  auto *folder = state.root.get();
+
+  for(size_t i = 1; i < elements.size(); i++)
+  {
+    if(elements[i].empty())
+    {
+      continue;
+    }
+
+    auto *child = folder->FindChild(elements[i]);
+
+    if(child == nullptr)
+    {
+      auto newFolder    = std::make_unique<IgorDataFolder>();
+      newFolder->name   = elements[i];
+      newFolder->parent = folder;
+      child             = newFolder.get();
+      folder->children.push_back(std::move(newFolder));
+    }
+
+    folder = child;
+  }
+
+  return folder;
+}
+
+waveHndl FakeIgor::MakeWave(const std::string &name,
+                            DataFolderHandle dataFolder,
+                            std::vector<CountInt> dimensionSizes, int type)
+{
+  dimensionSizes.resize(MAX_DIMENSIONS + 1, 0);
+
+  if(dataFolder == nullptr)
+  {
+    dataFolder = reinterpret_cast<DataFolderHandle>(-1);
+  }
+
+  waveHndl waveH = nullptr;
+  auto rc = MDMakeWave(&waveH, name.c_str(), dataFolder,
+                       dimensionSizes.data(), type, 1);
+
+  return rc == 0 ? waveH : nullptr;
+}
+
+void FakeIgor::SetWaveNote(waveHndl waveH, const std::string &note)
+{
+  GetWave(waveH)->note = note;
+}
+
+void FakeIgor::SetWaveUnits(waveHndl waveH, int dimension,
+                            const std::string &units)
+{
+  GetWave(waveH)->units.at(static_cast<size_t>(dimension + 1)) = units;
+}
+
+void FakeIgor::SetWaveScaling(waveHndl waveH, int dimension, double sfA,
+                              double sfB)
+{
+  auto *wave = GetWave(waveH);
+
+  if(dimension < 0)
+  {
+    wave->fullScaleTop    = sfA;
+    wave->fullScaleBottom = sfB;
+    return;
+  }
+
+  wave->delta.at(static_cast<size_t>(dimension))  = sfA;
+  wave->offset.at(static_cast<size_t>(dimension)) = sfB;
+}
+
+std::vector<std::string> FakeIgor::GetHistory()
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  return state.history;
+}
+
+// memory
+
+Handle WMNewHandle(BCInt size)
+{
+  const auto numBytes = static_cast<size_t>(std::max<BCInt>(size, 1));
+  auto *block         = new HandleBlock{
+      static_cast<char *>(std::malloc(numBytes)), size};
+
+  if(block->data == nullptr)
+  {
+    delete block;
+    return nullptr;
+  }
+
+  return &block->data;
+}
+
+void WMDisposeHandle(Handle h)
+{
+  if(h == nullptr)
+  {
+    return;
+  }
+
+  auto *block = reinterpret_cast<HandleBlock *>(h);
+  std::free(block->data);
+  delete block;
+}
+
+BCInt WMGetHandleSize(Handle h)
+{
+  return reinterpret_cast<HandleBlock *>(h)->size;
+}
+
+int WMSetHandleSize(Handle h, BCInt newSize)
+{
+  auto *block = reinterpret_cast<HandleBlock *>(h);
+  const auto numBytes = static_cast<size_t>(std::max<BCInt>(newSize, 1));
+  auto *data = static_cast<char *>(std::realloc(block->data, numBytes));
+
+  if(data == nullptr)
+  {
+    return NOMEM;
+  }
+
+  block->data = data;
+  block->size = newSize;
+
+  return 0;
+}
+
+int PutCStringInHandle(const char *str, Handle h)
+{
+  const auto length = static_cast<BCInt>(strlen(str));
+
+  if(auto rc = WMSetHandleSize(h, length))
+  {
+    return rc;
+  }
+
+  memcpy(*h, str, static_cast<size_t>(length));
+
+  return 0;
+}
+
+void MemClear(void *p, BCInt numBytes)
+{
+  memset(p, 0, static_cast<size_t>(numBytes));
+}
+
+// waves
+
+int WaveType(waveHndl waveH)
+{
+  return GetWave(waveH)->type;
+}
+
+CountInt WavePoints(waveHndl waveH)
+{
+  return GetWave(waveH)->GetNumPoints();
+}
+
+void *WaveData(waveHndl waveH)
+{
+  return GetWave(waveH)->GetData();
+}
+
+TickCountInt WaveModDate(waveHndl waveH)
+{
+  auto *wave = GetWave(waveH);
+
+  // free waves have no modification date
+  return wave->folder ? wave->modDate : 0;
+}
+
+Handle WaveNoteCopy(waveHndl waveH)
+{
+  const auto &note = GetWave(waveH)->note;
+
+  if(note.empty())
+  {
+    return nullptr;
+  }
+
+  auto h = WMNewHandle(static_cast<BCInt>(note.size()));
+
+  if(h != nullptr)
+  {
+    memcpy(*h, note.data(), note.size());
+  }
+
+  return h;
+}
+
+int HoldWave(waveHndl waveH)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  GetWave(waveH)->refCount++;
+
+  return 0;
+}
+
+int ReleaseWave(waveHndl *waveRefPtr)
+{
+  if(*waveRefPtr == nullptr)
+  {
+    return 0;
+  }
+
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  auto *wave = GetWave(*waveRefPtr);
+  *waveRefPtr = nullptr;
+
+  if(--wave->refCount <= 0 && wave->folder == nullptr)
+  {
+    delete wave;
+  }
+
+  return 0;
+}
+
+waveHndl FetchWaveFromDataFolder(DataFolderHandle dataFolderH,
+                                 const char *name)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  // the current data folder is always root
+  auto *folder = dataFolderH ? dataFolderH : state.root.get();
+
+  for(const auto &wave : folder->waves)
+  {
+    if(ToLower(wave->name) == ToLower(name))
+    {
+      return wave->GetHandle();
+    }
+  }
+
+  return nullptr;
+}
+
+void WaveHandleModified(waveHndl waveH)
+{
+  GetWave(waveH)->modDate = GetIgorDateNow();
+}
+
+int MDMakeWave(waveHndl *waveHPtr, const char *waveName,
+               DataFolderHandle dataFolderH,
+               CountInt dimensionSizes[MAX_DIMENSIONS + 1], int type,
+               int overwrite)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  const auto isFree = dataFolderH == reinterpret_cast<DataFolderHandle>(-1);
+  auto *folder      = isFree ? nullptr
+                             : (dataFolderH ? dataFolderH : state.root.get());
+
+  if(GetElementSize(type) == 0 && type != TEXT_WAVE_TYPE)
+  {
+    return GENERAL_BAD_VIBS;
+  }
+
+  auto wave  = std::make_unique<IgorWave>();
+  wave->name = waveName;
+  wave->type = type;
+  std::copy(dimensionSizes, dimensionSizes + MAX_DIMENSIONS,
+            wave->dimensionSizes.begin());
+  wave->Allocate();
+
+  *waveHPtr = wave->GetHandle();
+
+  if(isFree)
+  {
+    // the caller owns the reference
+    wave->refCount = 1;
+    wave.release();
+    return 0;
+  }
+
+  wave->folder = folder;
+
+  auto &waves = folder->waves;
+  auto it     = std::find_if(waves.begin(), waves.end(), [&](const auto &elem) {
+    return ToLower(elem->name) == ToLower(waveName);
+  });
+
+  if(it == waves.end())
+  {
+    waves.push_back(std::move(wave));
+    return 0;
+  }
+
+  if(!overwrite)
+  {
+    *waveHPtr = nullptr;
+    return NAME_WAV_CONFLICT;
+  }
+
+  *it = std::move(wave);
+
+  return 0;
+}
+
+int MDChangeWave2(waveHndl waveH, int dataType,
+                  CountInt dimensionSizes[MAX_DIMENSIONS + 1], int mode)
+{
+  auto *wave = GetWave(waveH);
+
+  const auto changeType = dataType != -1 && dataType != wave->type;
+
+  // changing from or to text waves is not supported
+  if(changeType &&
+     (wave->type == TEXT_WAVE_TYPE || GetElementSize(dataType) == 0))
+  {
+    return GENERAL_BAD_VIBS;
+  }
+
+  auto oldDimensionSizes = wave->dimensionSizes;
+  auto oldText           = std::move(wave->text);
+  auto *oldBlock         = wave->block;
+  const auto oldPoints   = wave->GetNumPoints();
+
+  wave->block = nullptr;
+  std::copy(dimensionSizes, dimensionSizes + MAX_DIMENSIONS,
+            wave->dimensionSizes.begin());
+
+  // unlike Igor Pro the data is not converted but zeroed
+  if(changeType)
+  {
+    wave->type = dataType;
+    wave->Allocate();
+    std::free(oldBlock);
+    wave->modDate = GetIgorDateNow();
+
+    return 0;
+  }
+
+  wave->Allocate();
+
+  const auto elementSize = GetElementSize(wave->type);
+  const auto newPoints   = wave->GetNumPoints();
+
+  for(CountInt i = 0; i < newPoints; i++)
+  {
+    CountInt source = i;
+
+    // keep the data at the same indices
+    if(mode == 0)
+    {
+      CountInt rest         = i;
+      CountInt oldStride    = 1;
+      source                = 0;
+      bool outOfRange       = false;
+
+      for(int dim = 0; dim < MAX_DIMENSIONS && wave->dimensionSizes[dim] > 0;
+          dim++)
+      {
+        const auto index = rest % wave->dimensionSizes[dim];
+        rest /= wave->dimensionSizes[dim];
+
+        const auto oldSize = std::max<CountInt>(oldDimensionSizes[dim], 1);
+        outOfRange |= index >= oldSize;
+        source += index * oldStride;
+        oldStride *= oldSize;
+      }
+
+      if(outOfRange)
+      {
+        continue;
+      }
+    }
+
+    if(source >= oldPoints)
+    {
+      continue;
+    }
+
+    if(wave->type == TEXT_WAVE_TYPE)
+    {
+      wave->text[static_cast<size_t>(i)] =
+          std::move(oldText[static_cast<size_t>(source)]);
+    }
+    else
+    {
+      memcpy(wave->GetData() + i * elementSize,
+             oldBlock + DATA_OFFSET + source * elementSize, elementSize);
+    }
+  }
+
+  std::free(oldBlock);
+  wave->modDate = GetIgorDateNow();
+
+  return 0;
+}
+
+int MDGetWaveDimensions(waveHndl waveH, int *numDimensionsPtr,
+                        CountInt dimensionSizes[MAX_DIMENSIONS + 1])
+{
+  auto *wave = GetWave(waveH);
+
+  *numDimensionsPtr = wave->GetNumDimensions();
+  std::copy(wave->dimensionSizes.begin(), wave->dimensionSizes.end(),
+            dimensionSizes);
+
+  return 0;
+}
+
+int MDGetWaveScaling(waveHndl waveH, int dimension, double *sfA, double *sfB)
+{
+  auto *wave = GetWave(waveH);
+
+  if(dimension < -1 || dimension >= MAX_DIMENSIONS)
+  {
+    return INDEX_OUT_OF_RANGE;
+  }
+
+  if(dimension == -1)
+  {
+    *sfA = wave->fullScaleTop;
+    *sfB = wave->fullScaleBottom;
+    return 0;
+  }
+
+  *sfA = wave->delta[static_cast<size_t>(dimension)];
+  *sfB = wave->offset[static_cast<size_t>(dimension)];
+
+  return 0;
+}
+
+int MDGetWaveUnits(waveHndl waveH, int dimension,
+                   char units[MAX_UNIT_CHARS + 1])
+{
+  if(dimension < -1 || dimension >= MAX_DIMENSIONS)
+  {
+    return INDEX_OUT_OF_RANGE;
+  }
+
+  const auto &str = GetWave(waveH)->units[static_cast<size_t>(dimension + 1)];
+  snprintf(units, MAX_UNIT_CHARS + 1, "%s", str.c_str());
+
+  return 0;
+}
+
+int MDGetDimensionLabel(waveHndl waveH, int dimension, IndexInt element,
+                        char label[MAX_DIM_LABEL_BYTES + 1])
+{
+  const auto &labels = GetWave(waveH)->labels;
+  const auto it      = labels.find({dimension, element});
+
+  snprintf(label, MAX_DIM_LABEL_BYTES + 1, "%s",
+           it == labels.end() ? "" : it->second.c_str());
+
+  return 0;
+}
+
+int MDSetDimensionLabel(waveHndl waveH, int dimension, IndexInt element,
+                        const char label[MAX_DIM_LABEL_BYTES + 1])
+{
+  auto *wave = GetWave(waveH);
+
+  if(dimension < 0 || dimension >= MAX_DIMENSIONS || element < -1 ||
+     element >= wave->dimensionSizes[static_cast<size_t>(dimension)])
+  {
+    return INDEX_OUT_OF_RANGE;
+  }
+
+  wave->labels[{dimension, element}] = label;
+
+  return 0;
+}
+
+int MDAccessNumericWaveData(waveHndl waveH, int accessMode,
+                            BCInt *dataOffsetPtr)
+{
+  if(accessMode != kMDWaveAccessMode0)
+  {
+    return GENERAL_BAD_VIBS;
+  }
+
+  if(WaveType(waveH) == TEXT_WAVE_TYPE)
+  {
+    return NUMERIC_ACCESS_ON_TEXT_WAVE;
+  }
+
+  *dataOffsetPtr = DATA_OFFSET;
+
+  return 0;
+}
+
+int MDStoreDPDataInNumericWave(waveHndl waveH, double *dPtr)
+{
+  auto *wave = GetWave(waveH);
+
+  const auto numValues = static_cast<size_t>(wave->GetNumPoints()) *
+                         ((wave->type & NT_CMPLX) ? 2 : 1);
+
+  const auto found = VisitNumeric(wave->type, wave->GetData(), [&](auto *data) {
+    using ElementType = std::remove_pointer_t<decltype(data)>;
+
+    for(size_t i = 0; i < numValues; i++)
+    {
+      data[i] = static_cast<ElementType>(dPtr[i]);
+    }
+  });
+
+  return found ? 0 : NUMERIC_ACCESS_ON_TEXT_WAVE;
+}
+
+int MDGetNumericWavePointValue(waveHndl waveH,
+                               IndexInt indices[MAX_DIMENSIONS],
+                               double value[2])
+{
+  return GetPointValue(waveH, indices, value);
+}
+
+int MDSetNumericWavePointValue(waveHndl waveH,
+                               IndexInt indices[MAX_DIMENSIONS],
+                               double value[2])
+{
+  return SetPointValue(waveH, indices, value);
+}
+
+int MDGetNumericWavePointValueSInt64(waveHndl waveH,
+                                     IndexInt indices[MAX_DIMENSIONS],
+                                     SInt64 value[2])
+{
+  return GetPointValue(waveH, indices, value);
+}
+
+int MDSetNumericWavePointValueSInt64(waveHndl waveH,
+                                     IndexInt indices[MAX_DIMENSIONS],
+                                     SInt64 value[2])
+{
+  return SetPointValue(waveH, indices, value);
+}
+
+int MDGetNumericWavePointValueUInt64(waveHndl waveH,
+                                     IndexInt indices[MAX_DIMENSIONS],
+                                     UInt64 value[2])
+{
+  return GetPointValue(waveH, indices, value);
+}
+
+int MDSetNumericWavePointValueUInt64(waveHndl waveH,
+                                     IndexInt indices[MAX_DIMENSIONS],
+                                     UInt64 value[2])
+{
+  return SetPointValue(waveH, indices, value);
+}
+
+int MDGetTextWavePointValue(waveHndl waveH, IndexInt indices[MAX_DIMENSIONS],
+                            Handle textH)
+{
+  auto *wave = GetWave(waveH);
+
+  if(wave->type != TEXT_WAVE_TYPE)
+  {
+    return TEXT_ACCESS_ON_NUMERIC_WAVE;
+  }
+
+  const auto index = wave->GetLinearIndex(indices);
+
+  if(index < 0)
+  {
+    return INDEX_OUT_OF_RANGE;
+  }
+
+  const auto &str = wave->text[static_cast<size_t>(index)];
+
+  if(auto rc = WMSetHandleSize(textH, static_cast<BCInt>(str.size())))
+  {
+    return rc;
+  }
+
+  memcpy(*textH, str.data(), str.size());
+
+  return 0;
+}
+
+int MDSetTextWavePointValue(waveHndl waveH, IndexInt indices[MAX_DIMENSIONS],
+                            Handle textH)
+{
+  auto *wave = GetWave(waveH);
+
+  if(wave->type != TEXT_WAVE_TYPE)
+  {
+    return TEXT_ACCESS_ON_NUMERIC_WAVE;
+  }
+
+  const auto index = wave->GetLinearIndex(indices);
+
+  if(index < 0)
+  {
+    return INDEX_OUT_OF_RANGE;
+  }
+
+  wave->text[static_cast<size_t>(index)] =
+      std::string(*textH, static_cast<size_t>(WMGetHandleSize(textH)));
+  wave->modDate = GetIgorDateNow();
+
+  return 0;
+}
+
+int GetTextWaveData(waveHndl waveH, int mode, Handle *textDataHPtr)
+{
+  auto *wave = GetWave(waveH);
+
+  // only null terminated strings are supported
+  if(mode != 0)
+  {
+    return GENERAL_BAD_VIBS;
+  }
+
+  if(wave->type != TEXT_WAVE_TYPE)
+  {
+    return TEXT_ACCESS_ON_NUMERIC_WAVE;
+  }
+
+  BCInt size = 0;
+  for(const auto &str : wave->text)
+  {
+    size += static_cast<BCInt>(str.size()) + 1;
+  }
+
+  if(auto rc = WMSetHandleSize(*textDataHPtr, size))
+  {
+    return rc;
+  }
+
+  char *dest = **textDataHPtr;
+  for(const auto &str : wave->text)
+  {
+    memcpy(dest, str.c_str(), str.size() + 1);
+    dest += str.size() + 1;
+  }
+
+  return 0;
+}
+
+// data folders
+
+int GetRootDataFolder(int /* refNum */, DataFolderHandle *rootFolderHPtr)
+{
+  *rootFolderHPtr = GetState().root.get();
+
+  return 0;
+}
+
+int GetParentDataFolder(DataFolderHandle dataFolderH,
+                        DataFolderHandle *parentFolderHPtr)
+{
+  *parentFolderHPtr = dataFolderH->parent;
+
+  return *parentFolderHPtr ? 0 : NO_PARENT_DATAFOLDER;
+}
+
+int GetNamedDataFolder(DataFolderHandle startingDataFolderH,
+                       const char dataFolderPath[MAXCMDLEN + 1],
+                       DataFolderHandle *dataFolderHPtr)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  *dataFolderHPtr = nullptr;
+
+  auto elements = SplitPath(dataFolderPath);
+  auto *folder  = startingDataFolderH ? startingDataFolderH : state.root.get();
+
+  if(!elements.empty() && ToLower(elements.front()) == "root")
+  {
+    folder = state.root.get();
+    elements.erase(elements.begin());
+  }
+  else if(!elements.empty() && elements.front().empty())
+  {
+    // relative path
+    elements.erase(elements.begin());
+  }
+  else
+  {
+    return 0;
+  }
+
+  for(const auto &elem : elements)
+  {
+    if(elem.empty())
+    {
+      continue;
+    }
+
+    folder = folder->FindChild(elem);
+
+    if(folder == nullptr)
+    {
+      return 0;
+    }
+  }
+
+  *dataFolderHPtr = folder;
+
+  return 0;
+}
+
+int GetDataFolderNameOrPath(DataFolderHandle dataFolderH, int flags,
+                            char dataFolderPathOrName[MAXCMDLEN + 1])
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  const auto str = (flags & 0x1) ? dataFolderH->GetPath() : dataFolderH->name;
+  snprintf(dataFolderPathOrName, MAXCMDLEN + 1, "%s", str.c_str());
+
+  return 0;
+}
+
+int GetWavesDataFolder(waveHndl waveH, DataFolderHandle *dataFolderHPtr)
+{
+  *dataFolderHPtr = GetWave(waveH)->folder;
+
+  return 0;
+}
+
+int GetNumChildDataFolders(DataFolderHandle parentDataFolderH,
+                           int *numChildDataFolderPtr)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  auto *folder = parentDataFolderH ? parentDataFolderH : state.root.get();
+  *numChildDataFolderPtr = static_cast<int>(folder->children.size());
+
+  return 0;
+}
+
+int GetIndexedChildDataFolder(DataFolderHandle parentDataFolderH, int index,
+                              DataFolderHandle *childDataFolderHPtr)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  auto *folder = parentDataFolderH ? parentDataFolderH : state.root.get();
+
+  if(index < 0 || static_cast<size_t>(index) >= folder->children.size())
+  {
+    return INDEX_OUT_OF_RANGE;
+  }
+
+  *childDataFolderHPtr = folder->children[static_cast<size_t>(index)].get();
+
+  return 0;
+}
+
+int GetNumDataFolderObjects(DataFolderHandle dataFolderH, int objectType,
+                            int *numObjectsPtr)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  auto *folder = dataFolderH ? dataFolderH : state.root.get();
+
+  // there are no global variables
+  *numObjectsPtr =
+      objectType == WAVE_OBJECT ? static_cast<int>(folder->waves.size()) : 0;
+
+  return 0;
+}
+
+int GetIndexedDataFolderObject(DataFolderHandle dataFolderH, int objectType,
+                               int index, char objectName[MAX_OBJ_NAME + 1],
+                               DataObjectValuePtr /* objectValuePtr */)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  auto *folder = dataFolderH ? dataFolderH : state.root.get();
+
+  if(objectType != WAVE_OBJECT || index < 0 ||
+     static_cast<size_t>(index) >= folder->waves.size())
+  {
+    return INDEX_OUT_OF_RANGE;
+  }
+
+  snprintf(objectName, MAX_OBJ_NAME + 1, "%s",
+           folder->waves[static_cast<size_t>(index)]->name.c_str());
+
+  return 0;
+}
+
+int ReleaseDataFolder(DataFolderHandle *dataFolderHPtr)
+{
+  *dataFolderHPtr = nullptr;
+
+  return 0;
+}
+
+// user functions
+
+int GetFunctionInfo(const char *name, FunctionInfoPtr fip)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  if(!state.compiled)
+  {
+    return NEED_COMPILE;
+  }
+
+  const auto it = state.functions.find(ToLower(name));
+
+  if(it == state.functions.end())
+  {
+    return EXPECTED_FUNCTION_NAME;
+  }
+
+  const auto &entry = it->second;
+
+  *fip = FunctionInfo{};
+  snprintf(fip->name, sizeof(fip->name), "%s", entry.name.c_str());
+  fip->functionID            = static_cast<int>(
+      std::distance(state.functions.begin(), it));
+  fip->returnType            = entry.returnType;
+  fip->numRequiredParameters = static_cast<int>(entry.paramTypes.size());
+  fip->totalNumParameters    = fip->numRequiredParameters;
+  std::copy(entry.paramTypes.begin(), entry.paramTypes.end(),
+            fip->parameterTypes);
+
+  return 0;
+}
+
+int CallFunction(FunctionInfoPtr fip, void *parameters, void *resultPtr)
+{
+  UserFunctionEntry entry;
+
+  {
+    auto &state = GetState();
+    Lock lock(state.mutex);
+
+    const auto it = state.functions.find(ToLower(fip->name));
+
+    if(it == state.functions.end())
+    {
+      return EXPECTED_FUNCTION_NAME;
+    }
+
+    entry = it->second;
+  }
+
+  auto *params = static_cast<unsigned char *>(parameters);
+
+  if(entry.func(params, resultPtr))
+  {
+    auto &state = GetState();
+    Lock lock(state.mutex);
+    state.abortRequested = true;
+  }
+
+  // Igor Pro owns string input parameters
+  for(auto type : entry.paramTypes)
+  {
+    if(type == HSTRING_TYPE)
+    {
+      Handle h = nullptr;
+      memcpy(&h, params, sizeof(Handle));
+      WMDisposeHandle(h);
+    }
+
+    params += (type & ~FV_REF_TYPE) == NT_FP64 ? sizeof(double)
+                                                 : sizeof(void *);
+  }
+
+  return 0;
+}
+
+// history and main thread
+
+void XOPNotice(const char *noticePtr)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  for(const auto *c = noticePtr; *c != '\0'; c++)
+  {
+    if(*c == '\r' || *c == '\n')
+    {
+      state.history.emplace_back();
+      continue;
+    }
+
+    state.history.back() += *c;
+  }
+}
+
+void XOPNotice2(const char *noticePtr, UInt32 /* options */)
+{
+  XOPNotice(noticePtr);
+}
+
+SInt32 HistoryLines()
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  return static_cast<SInt32>(state.history.size());
+}
+
+int HistoryFetchText(TULoc *startLocPtr, TULoc *endLocPtr, Handle *textHPtr)
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  const auto numLines = static_cast<SInt32>(state.history.size());
+
+  if(startLocPtr->paragraph < 0 || endLocPtr->paragraph >= numLines ||
+     startLocPtr->paragraph > endLocPtr->paragraph)
+  {
+    return INDEX_OUT_OF_RANGE;
+  }
+
+  std::string text;
+  for(auto i = startLocPtr->paragraph; i <= endLocPtr->paragraph; i++)
+  {
+    const auto &line  = state.history[static_cast<size_t>(i)];
+    const auto first  = i == startLocPtr->paragraph ? startLocPtr->pos : 0;
+    const auto endPos = static_cast<size_t>(endLocPtr->pos);
+    const auto last   = i == endLocPtr->paragraph
+                            ? std::min<size_t>(line.size(), endPos)
+                            : line.size();
+
+    if(static_cast<size_t>(first) < last)
+    {
+      text += line.substr(static_cast<size_t>(first), last - first);
+    }
+
+    if(i != endLocPtr->paragraph)
+    {
+      text += CR_STR;
+    }
+  }
+
+  return PutCStringInHandle(text.c_str(), *textHPtr);
+}
+
+int XOPSilentCommand(const char *cmdPtr)
+{
+  std::function<void()> handler;
+
+  {
+    auto &state = GetState();
+    Lock lock(state.mutex);
+    handler = state.idleHandler;
+  }
+
+  if(strcmp(cmdPtr, "DoXOPIdle") == 0 && handler)
+  {
+    handler();
+  }
+
+  return 0;
+}
+
+int SpinProcess()
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  return std::exchange(state.abortRequested, false) ? 1 : 0;
+}
+
+int RunningInMainThread()
+{
+  auto &state = GetState();
+  Lock lock(state.mutex);
+
+  return state.mainThread == std::this_thread::get_id();
+}
+
+// files and dates
+
+int SpecialDirPath(const char * /* pathID */, int /* domain */,
+                   int /* flags */, int createDir,
+                   char pathOut[MAX_PATH_LEN + 1])
+{
+  const auto path =
+      std::filesystem::temp_directory_path() / "ZeroMQ-XOP-stub";
+
+  if(createDir)
+  {
+    std::error_code ec;
+    std::filesystem::create_directories(path, ec);
+  }
+
+  snprintf(pathOut, MAX_PATH_LEN + 1, "%s/", path.string().c_str());
+
+  return 0;
+}
+
+int FullPathPointsToFolder(const char *fullPath)
+{
+  std::error_code ec;
+
+  return std::filesystem::is_directory(fullPath, ec) ? 1 : 0;
+}
+
+int XOPWriteFile64(XOP_FILE_REF fileRef, SInt64 count, const void *buffer,
+                   SInt64 *numBytesWrittenPtr)
+{
+  const auto written =
+      fwrite(buffer, 1, static_cast<size_t>(count), fileRef);
+
+  if(numBytesWrittenPtr != nullptr)
+  {
+    *numBytesWrittenPtr = static_cast<SInt64>(written);
+  }
+
+  return written == static_cast<size_t>(count) ? 0 : FILE_WRITE_ERROR;
+}
+
+int XOPCloseFile(XOP_FILE_REF fileRef)
+{
+  return fclose(fileRef) == 0 ? 0 : FILE_CLOSE_ERROR;
+}
+
+int DateToIgorDateInSeconds(int numValues, short *year, short *month,
+                            short *dayOfMonth, double *secs)
+{
+  // days since 1970-01-01 of the proleptic gregorian calendar
+  auto DaysFromCivil = [](int y, int m, int d) {
+    y -= m <= 2;
+    const int era  = (y >= 0 ? y : y - 399) / 400;
+    const int yoe  = y - era * 400;
+    const int doy  = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const int doe  = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+  };
+
+  for(int i = 0; i < numValues; i++)
+  {
+    // the stub uses UTC instead of the local time zone
+    secs[i] = static_cast<double>(DaysFromCivil(year[i], month[i],
+                                                dayOfMonth[i])) *
+                  86400.0 +
+              static_cast<double>(IGOR_EPOCH_OFFSET);
+  }
+
+  return 0;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "XOPStandardHeaders.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// @brief In-memory Igor Pro behind the XOPSupport stub
+///
+/// Holds waves, data folders, user functions and the history so that the core
+/// library can be benchmarked and tested without Igor Pro. Functions are
+/// called with the parameters packed as CallFunction does it, one after
+/// another without padding.
+namespace FakeIgor
+{
+
+/// @brief User function implementation
+///
+/// @param params packed parameters, pass-by-ref parameters are written back
+///               into it
+/// @param result return value storage, nullptr for functions without one
+///
+/// @return zero on success, non-zero to flag an abort
+using UserFunction = std::function<int(unsigned char *params, void *result)>;
+
+/// @brief Remove all waves, data folders, functions and history lines
+///
+/// The calling thread becomes the main thread.
+void Reset();
+
+/// @brief Register a user function, existing functions with the same name
+/// are replaced
+///
+/// @param returnType  igor type of the return value, or FV_NORETURN_TYPE
+/// @param paramTypes  igor types of the parameters including FV_REF_TYPE
+void AddFunction(const std::string &name, int returnType,
+                 const std::vector<int> &paramTypes, UserFunction func);
+
+/// @brief Mark the procedures as uncompiled, GetFunctionInfo then fails with
+/// NEED_COMPILE
+void SetCompiled(bool compiled);
+
+/// @brief Set the handler called for `DoXOPIdle`, this is where the IDLE
+/// event of the XOP is processed
+void SetIdleHandler(std::function<void()> handler);
+
+/// @brief Make a new data folder, intermediate folders are created as well
+///
+/// @param path absolute path like `root:a:b`
+DataFolderHandle MakeDataFolder(const std::string &path);
+
+/// @brief Make a wave, free if `dataFolder` is nullptr
+waveHndl MakeWave(const std::string &name, DataFolderHandle dataFolder,
+                  std::vector<CountInt> dimensionSizes, int type);
+
+/// @brief Set the note of a wave
+void SetWaveNote(waveHndl waveH, const std::string &note);
+
+/// @brief Set the data (dimension -1) or dimension units of a wave
+void SetWaveUnits(waveHndl waveH, int dimension, const std::string &units);
+
+/// @brief Set the data full scale (dimension -1) or the dimension scaling of
+/// a wave
+void SetWaveScaling(waveHndl waveH, int dimension, double sfA, double sfB);
+
+/// @brief Return all history lines
+std::vector<std::string> GetHistory();
+
+} // namespace FakeIgor
@@ -0,0 +1,236 @@
+#pragma once
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+/// @file
+/// @brief Stub for the subset of the XOP Toolkit used by the core library
+///
+/// Replaces the XOPSupport headers for host-independent builds, see
+/// FakeIgor.h for the in-memory Igor Pro behind it. Types and signatures
+/// follow the XOP Toolkit 8, error code values are only unique but do not
+/// match IgorErrors.h.
+
+#include <ctype.h>
+#include <cstdint>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using UInt32 = std::uint32_t;
+using SInt32 = std::int32_t;
+using UInt64 = std::uint64_t;
+using SInt64 = std::int64_t;
+
+using PSInt        = std::intptr_t;
+using BCInt        = std::int64_t;
+using CountInt     = std::int64_t;
+using IndexInt     = std::int64_t;
+using TickCountInt = std::uint64_t;
+
+using Handle = char **;
+
+struct IgorWaveHeader;
+using waveHndl = IgorWaveHeader **;
+
+struct IgorDataFolder;
+using DataFolderHandle = IgorDataFolder *;
+
+union DataObjectValue;
+using DataObjectValuePtr = DataObjectValue *;
+
+struct UserFunctionThreadInfo;
+using UserFunctionThreadInfoPtr = UserFunctionThreadInfo *;
+
+struct IORec;
+using IORecHandle = IORec **;
+
+using XOPIORecResult = std::intptr_t;
+using XOP_FILE_REF   = FILE *;
+
+#define CR_STR "\r"
+#define HOST_IMPORT extern "C"
+
+// limits
+#define MAX_DIMENSIONS 4
+#define MAX_OBJ_NAME 255
+#define MAX_UNIT_CHARS 49
+#define MAX_DIM_LABEL_BYTES 255
+#define MAXCMDLEN 2500
+#define MAX_PATH_LEN 1023
+
+// number types
+#define NT_CMPLX 1
+#define NT_FP32 2
+#define NT_FP64 4
+#define NT_I8 8
+#define NT_I16 0x10
+#define NT_I32 0x20
+#define NT_UNSIGNED 0x40
+#define NT_I64 0x80
+#define TEXT_WAVE_TYPE 0
+#define DATAFOLDER_TYPE 0x100
+#define HSTRING_TYPE 0x2000
+#define WAVE_TYPE 0x4000
+
+// function parameter types
+#define FV_REF_TYPE 0x1000
+#define FV_NORETURN_TYPE 0x00020000
+
+#define kMDWaveAccessMode0 0
+
+// data folder object types
+#define WAVE_OBJECT 1
+#define VAR_OBJECT 2
+#define STR_OBJECT 3
+
+// errors
+#define NOMEM 1
+#define NOWAV 2
+#define NEED_COMPILE 3
+#define EXPECTED_FUNCTION_NAME 4
+#define NO_PARENT_DATAFOLDER 5
+#define USING_NULL_REFVAR 6
+#define GENERAL_BAD_VIBS 7
+#define NUMERIC_ACCESS_ON_TEXT_WAVE 8
+#define TEXT_ACCESS_ON_NUMERIC_WAVE 9
+#define INDEX_OUT_OF_RANGE 10
+#define NAME_WAV_CONFLICT 11
+#define FOLDER_EXISTS_NO_OVERWRITE 12
+#define CANT_OPEN_FOLDER 13
+#define FILE_WRITE_ERROR 14
+#define FILE_CLOSE_ERROR 15
+#define PNTS_INCOMPATIBLE 16
+#define NULL_WAVE_OP 17
+#define kDoesNotSupportNaNorINF 18
+#define kParameterOutOfRange 19
+#define FIRST_XOP_ERR 10000
+
+struct TULoc
+{
+  SInt32 paragraph;
+  SInt32 pos;
+};
+
+struct FunctionInfo
+{
+  char name[MAX_OBJ_NAME + 1];
+  int compilationIndex;
+  int functionID;
+  int subType;
+  int isExternalFunction;
+  int returnType;
+  int reserved[25];
+  int numOptionalParameters;
+  int numRequiredParameters;
+  int totalNumParameters;
+  int parameterTypes[100];
+};
+using FunctionInfoPtr = FunctionInfo *;
+
+// memory
+Handle WMNewHandle(BCInt size);
+void WMDisposeHandle(Handle h);
+BCInt WMGetHandleSize(Handle h);
+int WMSetHandleSize(Handle h, BCInt newSize);
+int PutCStringInHandle(const char *str, Handle h);
+void MemClear(void *p, BCInt numBytes);
+
+// waves
+int WaveType(waveHndl waveH);
+CountInt WavePoints(waveHndl waveH);
+void *WaveData(waveHndl waveH);
+TickCountInt WaveModDate(waveHndl waveH);
+Handle WaveNoteCopy(waveHndl waveH);
+int HoldWave(waveHndl waveH);
+int ReleaseWave(waveHndl *waveRefPtr);
+waveHndl FetchWaveFromDataFolder(DataFolderHandle dataFolderH,
+                                 const char *name);
+void WaveHandleModified(waveHndl waveH);
+int MDMakeWave(waveHndl *waveHPtr, const char *waveName,
+               DataFolderHandle dataFolderH,
+               CountInt dimensionSizes[MAX_DIMENSIONS + 1], int type,
+               int overwrite);
+int MDChangeWave2(waveHndl waveH, int dataType,
+                  CountInt dimensionSizes[MAX_DIMENSIONS + 1], int mode);
+int MDGetWaveDimensions(waveHndl waveH, int *numDimensionsPtr,
+                        CountInt dimensionSizes[MAX_DIMENSIONS + 1]);
+int MDGetWaveScaling(waveHndl waveH, int dimension, double *sfA,
+                     double *sfB);
+int MDGetWaveUnits(waveHndl waveH, int dimension,
+                   char units[MAX_UNIT_CHARS + 1]);
+int MDGetDimensionLabel(waveHndl waveH, int dimension, IndexInt element,
+                        char label[MAX_DIM_LABEL_BYTES + 1]);
+int MDSetDimensionLabel(waveHndl waveH, int dimension, IndexInt element,
+                        const char label[MAX_DIM_LABEL_BYTES + 1]);
+int MDAccessNumericWaveData(waveHndl waveH, int accessMode,
+                            BCInt *dataOffsetPtr);
+int MDStoreDPDataInNumericWave(waveHndl waveH, double *dPtr);
+int MDGetNumericWavePointValue(waveHndl waveH,
+                               IndexInt indices[MAX_DIMENSIONS],
+                               double value[2]);
+int MDSetNumericWavePointValue(waveHndl waveH,
+                               IndexInt indices[MAX_DIMENSIONS],
+                               double value[2]);
+int MDGetNumericWavePointValueSInt64(waveHndl waveH,
+                                     IndexInt indices[MAX_DIMENSIONS],
+                                     SInt64 value[2]);
+int MDSetNumericWavePointValueSInt64(waveHndl waveH,
+                                     IndexInt indices[MAX_DIMENSIONS],
+                                     SInt64 value[2]);
+int MDGetNumericWavePointValueUInt64(waveHndl waveH,
+                                     IndexInt indices[MAX_DIMENSIONS],
+                                     UInt64 value[2]);
+int MDSetNumericWavePointValueUInt64(waveHndl waveH,
+                                     IndexInt indices[MAX_DIMENSIONS],
+                                     UInt64 value[2]);
+int MDGetTextWavePointValue(waveHndl waveH, IndexInt indices[MAX_DIMENSIONS],
+                            Handle textH);
+int MDSetTextWavePointValue(waveHndl waveH, IndexInt indices[MAX_DIMENSIONS],
+                            Handle textH);
+int GetTextWaveData(waveHndl waveH, int mode, Handle *textDataHPtr);
+
+// data folders
+int GetRootDataFolder(int refNum, DataFolderHandle *rootFolderHPtr);
+int GetParentDataFolder(DataFolderHandle dataFolderH,
+                        DataFolderHandle *parentFolderHPtr);
+int GetNamedDataFolder(DataFolderHandle startingDataFolderH,
+                       const char dataFolderPath[MAXCMDLEN + 1],
+                       DataFolderHandle *dataFolderHPtr);
+int GetDataFolderNameOrPath(DataFolderHandle dataFolderH, int flags,
+                            char dataFolderPathOrName[MAXCMDLEN + 1]);
+int GetWavesDataFolder(waveHndl waveH, DataFolderHandle *dataFolderHPtr);
+int GetNumChildDataFolders(DataFolderHandle parentDataFolderH,
+                           int *numChildDataFolderPtr);
+int GetIndexedChildDataFolder(DataFolderHandle parentDataFolderH, int index,
+                              DataFolderHandle *childDataFolderHPtr);
+int GetNumDataFolderObjects(DataFolderHandle dataFolderH, int objectType,
+                            int *numObjectsPtr);
+int GetIndexedDataFolderObject(DataFolderHandle dataFolderH, int objectType,
+                               int index, char objectName[MAX_OBJ_NAME + 1],
+                               DataObjectValuePtr objectValuePtr);
+int ReleaseDataFolder(DataFolderHandle *dataFolderHPtr);
+
+// user functions
+int GetFunctionInfo(const char *name, FunctionInfoPtr fip);
+int CallFunction(FunctionInfoPtr fip, void *parameters, void *resultPtr);
+
+// history and main thread
+void XOPNotice(const char *noticePtr);
+void XOPNotice2(const char *noticePtr, UInt32 options);
+SInt32 HistoryLines();
+int HistoryFetchText(TULoc *startLocPtr, TULoc *endLocPtr, Handle *textHPtr);
+int XOPSilentCommand(const char *cmdPtr);
+int SpinProcess();
+int RunningInMainThread();
+
+// files and dates
+int SpecialDirPath(const char *pathID, int domain, int flags, int createDir,
+                   char pathOut[MAX_PATH_LEN + 1]);
+int FullPathPointsToFolder(const char *fullPath);
+int XOPWriteFile64(XOP_FILE_REF fileRef, SInt64 count, const void *buffer,
+                   SInt64 *numBytesWrittenPtr);
+int XOPCloseFile(XOP_FILE_REF fileRef);
+int DateToIgorDateInSeconds(int numValues, short *year, short *month,
+                            short *dayOfMonth, double *secs);
@@ -1,5 +1,8 @@
 #include "ZeroMQ.h"
 #include "MessageHandler.h"
+#include "PublisherFanIn.h"
+#include "PublisherSender.h"
+#include "SubscriberReceiver.h"
 
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
@@ -32,13 +35,17 @@ extern "C" void XOPEntry()
       {
         idleInProgress = true;
         MessageHandler::Instance().HandleAllQueuedMessages();
+        SubscriberReceiver::Instance().DispatchCallbacks();
         OutputQueuedNotices();
         idleInProgress = false;
       }
       break;
     case CLEANUP:
-      MessageHandler::Instance().Stop();
+      MessageHandler::Instance().StopAll();
       HeartbeatPublisher::Instance().Stop();
+      PublisherSender::Instance().StopAll();
+      PublisherFanIn::Instance().StopAll();
+      SubscriberReceiver::Instance().Stop();
       GlobalData::Instance().CloseConnections();
       break;
     }
@@ -79,6 +86,8 @@ HOST_IMPORT int XOPMain(IORecHandle ioRecHandle)
     // GlobalData, as we need to be able to output debug messages for that
     GlobalData::Instance().InitLogging();
 
+    Tracer::Instance().SetThreadName("Igor main thread");
+
     HeartbeatPublisher::Instance().Start();
 
 #ifdef _DEBUG
@@ -61,8 +61,8 @@ using json = nlohmann::json;
 #pragma clang diagnostic pop
 #endif
 
-class CallFunctionOperation;
-using CallFunctionOperationPtr = std::shared_ptr<CallFunctionOperation>;
+class Operation;
+using OperationPtr = std::shared_ptr<Operation>;
 
 class RequestInterface;
 using RequestInterfacePtr = std::shared_ptr<RequestInterface>;
@@ -119,6 +119,8 @@ using ZeroMQMessageSharedPtrVec = std::vector<std::shared_ptr<ZeroMQMessage>>;
 #include "HelperFunctions.h"
 #include "ConcurrentXOPNotice.h"
 #include "Logging.h"
+#include "Metrics.h"
+#include "Tracing.h"
 #include "SocketWithMutex.h"
 #include "Errors.h"
 #include "git_version.h"
@@ -21,62 +21,142 @@ XOPIORecResult RegisterFunction()
     returnValue = reinterpret_cast<XOPIORecResult>(zeromq_client_recv);
     break;
   case 2:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_client_send);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_client_scatter);
     break;
   case 3:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_handler_start);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_client_send);
     break;
   case 4:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_handler_stop);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_handler_start);
     break;
   case 5:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_bind);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_handler_stop);
     break;
   case 6:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_send);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_metrics_get);
     break;
   case 7:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_send_multi);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_metrics_reset);
     break;
   case 8:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_server_bind);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_bind);
     break;
   case 9:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_server_recv);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_channel_bind);
     break;
   case 10:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_server_send);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_channel_close);
     break;
   case 11:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_set);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_channel_create);
     break;
   case 12:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_set_logging_template);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_channel_send);
     break;
   case 13:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_stop);
+    returnValue =
+        reinterpret_cast<XOPIORecResult>(zeromq_pub_channel_send_multi);
     break;
   case 14:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_add_filter);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_get_queue_stats);
     break;
   case 15:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_connect);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_send);
     break;
   case 16:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_recv);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_send_multi);
     break;
   case 17:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_recv_multi);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_set_compression);
     break;
   case 18:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_remove_filter);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_set_heartbeat);
     break;
   case 19:
-    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_test_callfunction);
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_pub_set_queue);
     break;
   case 20:
+    returnValue =
+        reinterpret_cast<XOPIORecResult>(zeromq_pub_set_thread_sockets);
+    break;
+  case 21:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_server_bind);
+    break;
+  case 22:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_server_instance_bind);
+    break;
+  case 23:
+    returnValue =
+        reinterpret_cast<XOPIORecResult>(zeromq_server_instance_close);
+    break;
+  case 24:
+    returnValue =
+        reinterpret_cast<XOPIORecResult>(zeromq_server_instance_create);
+    break;
+  case 25:
+    returnValue =
+        reinterpret_cast<XOPIORecResult>(zeromq_server_instance_start);
+    break;
+  case 26:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_server_recv);
+    break;
+  case 27:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_server_send);
+    break;
+  case 28:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_set);
+    break;
+  case 29:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_set_context_option);
+    break;
+  case 30:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_set_logging_template);
+    break;
+  case 31:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_set_option);
+    break;
+  case 32:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_stop);
+    break;
+  case 33:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_add_filter);
+    break;
+  case 34:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_connect);
+    break;
+  case 35:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_get_buffer_stats);
+    break;
+  case 36:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_recv);
+    break;
+  case 37:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_recv_multi);
+    break;
+  case 38:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_remove_filter);
+    break;
+  case 39:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_set_buffer);
+    break;
+  case 40:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_set_callback);
+    break;
+  case 41:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_set_compression);
+    break;
+  case 42:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_sub_set_conflate);
+    break;
+  case 43:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_test_callfunction);
+    break;
+  case 44:
     returnValue = reinterpret_cast<XOPIORecResult>(zeromq_test_serializeWave);
     break;
+  case 45:
+    returnValue = reinterpret_cast<XOPIORecResult>(zeromq_trace_dump);
+    break;
   }
   return returnValue;
 }
@@ -31,6 +31,18 @@ struct zeromq_client_recvParams
 typedef struct zeromq_client_recvParams zeromq_client_recvParams;
 #pragma pack()
 
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_client_scatterParams
+{
+  double timeout;
+  Handle msg;
+  waveHndl endpoints;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  Handle result;
+};
+typedef struct zeromq_client_scatterParams zeromq_client_scatterParams;
+#pragma pack()
+
 #pragma pack(2) // All structures passed to Igor are two-byte aligned.
 struct zeromq_client_sendParams
 {
@@ -57,6 +69,24 @@ struct zeromq_handler_stopParams
 typedef struct zeromq_handler_stopParams zeromq_handler_stopParams;
 #pragma pack()
 
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_metrics_getParams
+{
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  Handle result;
+};
+typedef struct zeromq_metrics_getParams zeromq_metrics_getParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_metrics_resetParams
+{
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_metrics_resetParams zeromq_metrics_resetParams;
+#pragma pack()
+
 #pragma pack(2) // All structures passed to Igor are two-byte aligned.
 struct zeromq_pub_bindParams
 {
@@ -67,6 +97,74 @@ struct zeromq_pub_bindParams
 typedef struct zeromq_pub_bindParams zeromq_pub_bindParams;
 #pragma pack()
 
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_pub_channel_bindParams
+{
+  Handle localPoint;
+  Handle name;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_pub_channel_bindParams zeromq_pub_channel_bindParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_pub_channel_closeParams
+{
+  Handle name;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_pub_channel_closeParams zeromq_pub_channel_closeParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_pub_channel_createParams
+{
+  double sendThread;
+  double highWaterMark;
+  Handle name;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_pub_channel_createParams zeromq_pub_channel_createParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_pub_channel_sendParams
+{
+  Handle msg;
+  Handle filter;
+  Handle name;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_pub_channel_sendParams zeromq_pub_channel_sendParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_pub_channel_send_multiParams
+{
+  waveHndl payload;
+  Handle name;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_pub_channel_send_multiParams
+    zeromq_pub_channel_send_multiParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_pub_get_queue_statsParams
+{
+  Handle channel;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  Handle result;
+};
+typedef struct zeromq_pub_get_queue_statsParams
+    zeromq_pub_get_queue_statsParams;
+#pragma pack()
+
 #pragma pack(2) // All structures passed to Igor are two-byte aligned.
 struct zeromq_pub_sendParams
 {
@@ -88,6 +186,53 @@ struct zeromq_pub_send_multiParams
 typedef struct zeromq_pub_send_multiParams zeromq_pub_send_multiParams;
 #pragma pack()
 
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_pub_set_compressionParams
+{
+  double threshold;
+  Handle method;
+  Handle filter;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_pub_set_compressionParams
+    zeromq_pub_set_compressionParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_pub_set_heartbeatParams
+{
+  double interval;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_pub_set_heartbeatParams zeromq_pub_set_heartbeatParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_pub_set_queueParams
+{
+  Handle dropPolicy;
+  double capacity;
+  Handle channel;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_pub_set_queueParams zeromq_pub_set_queueParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_pub_set_thread_socketsParams
+{
+  double enable;
+  Handle channel;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_pub_set_thread_socketsParams
+    zeromq_pub_set_thread_socketsParams;
+#pragma pack()
+
 #pragma pack(2) // All structures passed to Igor are two-byte aligned.
 struct zeromq_server_bindParams
 {
@@ -98,6 +243,52 @@ struct zeromq_server_bindParams
 typedef struct zeromq_server_bindParams zeromq_server_bindParams;
 #pragma pack()
 
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_server_instance_bindParams
+{
+  Handle localPoint;
+  Handle name;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_server_instance_bindParams
+    zeromq_server_instance_bindParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_server_instance_closeParams
+{
+  Handle name;
+  double result;
+};
+typedef struct zeromq_server_instance_closeParams
+    zeromq_server_instance_closeParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_server_instance_createParams
+{
+  double requestsPerIdle;
+  double priority;
+  double maxMessageSize;
+  Handle name;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_server_instance_createParams
+    zeromq_server_instance_createParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_server_instance_startParams
+{
+  Handle name;
+  double result;
+};
+typedef struct zeromq_server_instance_startParams
+    zeromq_server_instance_startParams;
+#pragma pack()
+
 #pragma pack(2) // All structures passed to Igor are two-byte aligned.
 struct zeromq_server_recvParams
 {
@@ -129,6 +320,17 @@ struct zeromq_setParams
 typedef struct zeromq_setParams zeromq_setParams;
 #pragma pack()
 
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_set_context_optionParams
+{
+  double value;
+  Handle option;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_set_context_optionParams zeromq_set_context_optionParams;
+#pragma pack()
+
 #pragma pack(2) // All structures passed to Igor are two-byte aligned.
 struct zeromq_set_logging_templateParams
 {
@@ -140,6 +342,18 @@ typedef struct zeromq_set_logging_templateParams
     zeromq_set_logging_templateParams;
 #pragma pack()
 
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_set_optionParams
+{
+  double value;
+  Handle option;
+  Handle socketType;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_set_optionParams zeromq_set_optionParams;
+#pragma pack()
+
 #pragma pack(2) // All structures passed to Igor are two-byte aligned.
 struct zeromq_stopParams
 {
@@ -169,6 +383,16 @@ struct zeromq_sub_connectParams
 typedef struct zeromq_sub_connectParams zeromq_sub_connectParams;
 #pragma pack()
 
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_sub_get_buffer_statsParams
+{
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  Handle result;
+};
+typedef struct zeromq_sub_get_buffer_statsParams
+    zeromq_sub_get_buffer_statsParams;
+#pragma pack()
+
 #pragma pack(2) // All structures passed to Igor are two-byte aligned.
 struct zeromq_sub_recvParams
 {
@@ -199,6 +423,50 @@ struct zeromq_sub_remove_filterParams
 typedef struct zeromq_sub_remove_filterParams zeromq_sub_remove_filterParams;
 #pragma pack()
 
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_sub_set_bufferParams
+{
+  double capacity;
+  Handle filter;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_sub_set_bufferParams zeromq_sub_set_bufferParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_sub_set_callbackParams
+{
+  Handle callback;
+  Handle filter;
+  double result;
+};
+typedef struct zeromq_sub_set_callbackParams zeromq_sub_set_callbackParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_sub_set_compressionParams
+{
+  double enable;
+  Handle filter;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_sub_set_compressionParams
+    zeromq_sub_set_compressionParams;
+#pragma pack()
+
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_sub_set_conflateParams
+{
+  double conflate;
+  Handle filter;
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  double result;
+};
+typedef struct zeromq_sub_set_conflateParams zeromq_sub_set_conflateParams;
+#pragma pack()
+
 #pragma pack(2) // All structures passed to Igor are two-byte aligned.
 struct zeromq_test_callfunctionParams
 {
@@ -219,12 +487,24 @@ struct zeromq_test_serializeWaveParams
 typedef struct zeromq_test_serializeWaveParams zeromq_test_serializeWaveParams;
 #pragma pack()
 
+#pragma pack(2) // All structures passed to Igor are two-byte aligned.
+struct zeromq_trace_dumpParams
+{
+  UserFunctionThreadInfoPtr tp; // needed for thread safe functions
+  Handle result;
+};
+typedef struct zeromq_trace_dumpParams zeromq_trace_dumpParams;
+#pragma pack()
+
 // variable zeromq_client_connect(string remotePoint)
 extern "C" int zeromq_client_connect(zeromq_client_connectParams *p);
 
 // string zeromq_client_recv()
 extern "C" int zeromq_client_recv(zeromq_client_recvParams *p);
 
+// string zeromq_client_scatter(WAVE endpoints, string msg, variable timeout)
+extern "C" int zeromq_client_scatter(zeromq_client_scatterParams *p);
+
 // variable zeromq_client_send(string msg)
 extern "C" int zeromq_client_send(zeromq_client_sendParams *p);
 
@@ -234,18 +514,76 @@ extern "C" int zeromq_handler_start(zeromq_handler_startParams *p);
 // variable zeromq_handler_stop()
 extern "C" int zeromq_handler_stop(zeromq_handler_stopParams *p);
 
+// string zeromq_metrics_get()
+extern "C" int zeromq_metrics_get(zeromq_metrics_getParams *p);
+
+// variable zeromq_metrics_reset()
+extern "C" int zeromq_metrics_reset(zeromq_metrics_resetParams *p);
+
 // variable zeromq_pub_bind(string localPoint)
 extern "C" int zeromq_pub_bind(zeromq_pub_bindParams *p);
 
+// variable zeromq_pub_channel_bind(string name, string localPoint)
+extern "C" int zeromq_pub_channel_bind(zeromq_pub_channel_bindParams *p);
+
+// variable zeromq_pub_channel_close(string name)
+extern "C" int zeromq_pub_channel_close(zeromq_pub_channel_closeParams *p);
+
+// variable zeromq_pub_channel_create(string name, variable highWaterMark,
+// variable sendThread)
+extern "C" int zeromq_pub_channel_create(zeromq_pub_channel_createParams *p);
+
+// variable zeromq_pub_channel_send(string name, string filter, string msg)
+extern "C" int zeromq_pub_channel_send(zeromq_pub_channel_sendParams *p);
+
+// variable zeromq_pub_channel_send_multi(string name, WAVEWAVE payload)
+extern "C" int
+zeromq_pub_channel_send_multi(zeromq_pub_channel_send_multiParams *p);
+
+// string zeromq_pub_get_queue_stats(string channel)
+extern "C" int zeromq_pub_get_queue_stats(zeromq_pub_get_queue_statsParams *p);
+
 // variable zeromq_pub_send(string filter, string msg)
 extern "C" int zeromq_pub_send(zeromq_pub_sendParams *p);
 
 // variable zeromq_pub_send_multi(WAVEWAVE payload)
 extern "C" int zeromq_pub_send_multi(zeromq_pub_send_multiParams *p);
 
+// variable zeromq_pub_set_compression(string filter, string method, variable
+// threshold)
+extern "C" int zeromq_pub_set_compression(zeromq_pub_set_compressionParams *p);
+
+// variable zeromq_pub_set_heartbeat(variable interval)
+extern "C" int zeromq_pub_set_heartbeat(zeromq_pub_set_heartbeatParams *p);
+
+// variable zeromq_pub_set_queue(string channel, variable capacity, string
+// dropPolicy)
+extern "C" int zeromq_pub_set_queue(zeromq_pub_set_queueParams *p);
+
+// variable zeromq_pub_set_thread_sockets(string channel, variable enable)
+extern "C" int
+zeromq_pub_set_thread_sockets(zeromq_pub_set_thread_socketsParams *p);
+
 // variable zeromq_server_bind(string localPoint)
 extern "C" int zeromq_server_bind(zeromq_server_bindParams *p);
 
+// variable zeromq_server_instance_bind(string name, string localPoint)
+extern "C" int
+zeromq_server_instance_bind(zeromq_server_instance_bindParams *p);
+
+// variable zeromq_server_instance_close(string name)
+extern "C" int
+zeromq_server_instance_close(zeromq_server_instance_closeParams *p);
+
+// variable zeromq_server_instance_create(string name, variable maxMessageSize,
+// variable priority, variable requestsPerIdle)
+extern "C" int
+zeromq_server_instance_create(zeromq_server_instance_createParams *p);
+
+// variable zeromq_server_instance_start(string name)
+extern "C" int
+zeromq_server_instance_start(zeromq_server_instance_startParams *p);
+
 // string zeromq_server_recv(string *identity)
 extern "C" int zeromq_server_recv(zeromq_server_recvParams *p);
 
@@ -255,10 +593,16 @@ extern "C" int zeromq_server_send(zeromq_server_sendParams *p);
 // variable zeromq_set(variable flags)
 extern "C" int zeromq_set(zeromq_setParams *p);
 
+// variable zeromq_set_context_option(string option, variable value)
+extern "C" int zeromq_set_context_option(zeromq_set_context_optionParams *p);
+
 // variable zeromq_set_logging_template(string jsonString)
 extern "C" int
 zeromq_set_logging_template(zeromq_set_logging_templateParams *p);
 
+// variable zeromq_set_option(string socketType, string option, variable value)
+extern "C" int zeromq_set_option(zeromq_set_optionParams *p);
+
 // variable zeromq_stop()
 extern "C" int zeromq_stop(zeromq_stopParams *p);
 
@@ -268,6 +612,10 @@ extern "C" int zeromq_sub_add_filter(zeromq_sub_add_filterParams *p);
 // variable zeromq_sub_connect(string remotePoint)
 extern "C" int zeromq_sub_connect(zeromq_sub_connectParams *p);
 
+// string zeromq_sub_get_buffer_stats()
+extern "C" int
+zeromq_sub_get_buffer_stats(zeromq_sub_get_buffer_statsParams *p);
+
 // string zeromq_sub_recv(string *filter)
 extern "C" int zeromq_sub_recv(zeromq_sub_recvParams *p);
 
@@ -277,8 +625,23 @@ extern "C" int zeromq_sub_recv_multi(zeromq_sub_recv_multiParams *p);
 // variable zeromq_sub_remove_filter(string filter)
 extern "C" int zeromq_sub_remove_filter(zeromq_sub_remove_filterParams *p);
 
+// variable zeromq_sub_set_buffer(string filter, variable capacity)
+extern "C" int zeromq_sub_set_buffer(zeromq_sub_set_bufferParams *p);
+
+// variable zeromq_sub_set_callback(string filter, string callback)
+extern "C" int zeromq_sub_set_callback(zeromq_sub_set_callbackParams *p);
+
+// variable zeromq_sub_set_compression(string filter, variable enable)
+extern "C" int zeromq_sub_set_compression(zeromq_sub_set_compressionParams *p);
+
+// variable zeromq_sub_set_conflate(string filter, variable conflate)
+extern "C" int zeromq_sub_set_conflate(zeromq_sub_set_conflateParams *p);
+
 // string zeromq_test_callfunction(string msg)
 extern "C" int zeromq_test_callfunction(zeromq_test_callfunctionParams *p);
 
 // string zeromq_test_serializeWave(WAVE wv)
 extern "C" int zeromq_test_serializeWave(zeromq_test_serializeWaveParams *p);
+
+// string zeromq_trace_dump()
+extern "C" int zeromq_trace_dump(zeromq_trace_dumpParams *p);
@@ -21,6 +21,16 @@ resource 'XOPF' (1100) {   // Describes functions added by XOP to IGOR.
 
   },
 
+  // string zeromq_client_scatter(WAVE endpoints, string msg, variable timeout)
+  "zeromq_client_scatter",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  HSTRING_TYPE,          // Return value type
+  {
+  WAVE_TYPE,      // parameter 1
+  HSTRING_TYPE,      // parameter 2
+  NT_FP64,      // parameter 3
+  },
+
   // variable zeromq_client_send(string msg)
   "zeromq_client_send",
   F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
@@ -45,6 +55,22 @@ resource 'XOPF' (1100) {   // Describes functions added by XOP to IGOR.
 
   },
 
+  // string zeromq_metrics_get()
+  "zeromq_metrics_get",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  HSTRING_TYPE,          // Return value type
+  {
+
+  },
+
+  // variable zeromq_metrics_reset()
+  "zeromq_metrics_reset",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+
+  },
+
   // variable zeromq_pub_bind(string localPoint)
   "zeromq_pub_bind",
   F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
@@ -53,6 +79,60 @@ resource 'XOPF' (1100) {   // Describes functions added by XOP to IGOR.
   HSTRING_TYPE,      // parameter 1
   },
 
+  // variable zeromq_pub_channel_bind(string name, string localPoint)
+  "zeromq_pub_channel_bind",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  HSTRING_TYPE,      // parameter 2
+  },
+
+  // variable zeromq_pub_channel_close(string name)
+  "zeromq_pub_channel_close",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  },
+
+  // variable zeromq_pub_channel_create(string name, variable highWaterMark, variable sendThread)
+  "zeromq_pub_channel_create",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  NT_FP64,      // parameter 2
+  NT_FP64,      // parameter 3
+  },
+
+  // variable zeromq_pub_channel_send(string name, string filter, string msg)
+  "zeromq_pub_channel_send",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  HSTRING_TYPE,      // parameter 2
+  HSTRING_TYPE,      // parameter 3
+  },
+
+  // variable zeromq_pub_channel_send_multi(string name, WAVEWAVE payload)
+  "zeromq_pub_channel_send_multi",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  WAVE_TYPE,      // parameter 2
+  },
+
+  // string zeromq_pub_get_queue_stats(string channel)
+  "zeromq_pub_get_queue_stats",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  HSTRING_TYPE,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  },
+
   // variable zeromq_pub_send(string filter, string msg)
   "zeromq_pub_send",
   F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
@@ -70,6 +150,43 @@ resource 'XOPF' (1100) {   // Describes functions added by XOP to IGOR.
   WAVE_TYPE,      // parameter 1
   },
 
+  // variable zeromq_pub_set_compression(string filter, string method, variable threshold)
+  "zeromq_pub_set_compression",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  HSTRING_TYPE,      // parameter 2
+  NT_FP64,      // parameter 3
+  },
+
+  // variable zeromq_pub_set_heartbeat(variable interval)
+  "zeromq_pub_set_heartbeat",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  NT_FP64,      // parameter 1
+  },
+
+  // variable zeromq_pub_set_queue(string channel, variable capacity, string dropPolicy)
+  "zeromq_pub_set_queue",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  NT_FP64,      // parameter 2
+  HSTRING_TYPE,      // parameter 3
+  },
+
+  // variable zeromq_pub_set_thread_sockets(string channel, variable enable)
+  "zeromq_pub_set_thread_sockets",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  NT_FP64,      // parameter 2
+  },
+
   // variable zeromq_server_bind(string localPoint)
   "zeromq_server_bind",
   F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
@@ -78,6 +195,42 @@ resource 'XOPF' (1100) {   // Describes functions added by XOP to IGOR.
   HSTRING_TYPE,      // parameter 1
   },
 
+  // variable zeromq_server_instance_bind(string name, string localPoint)
+  "zeromq_server_instance_bind",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  HSTRING_TYPE,      // parameter 2
+  },
+
+  // variable zeromq_server_instance_close(string name)
+  "zeromq_server_instance_close",
+  F_UTIL | F_EXTERNAL,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  },
+
+  // variable zeromq_server_instance_create(string name, variable maxMessageSize, variable priority, variable requestsPerIdle)
+  "zeromq_server_instance_create",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  NT_FP64,      // parameter 2
+  NT_FP64,      // parameter 3
+  NT_FP64,      // parameter 4
+  },
+
+  // variable zeromq_server_instance_start(string name)
+  "zeromq_server_instance_start",
+  F_UTIL | F_EXTERNAL,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  },
+
   // string zeromq_server_recv(string *identity)
   "zeromq_server_recv",
   F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
@@ -103,6 +256,15 @@ resource 'XOPF' (1100) {   // Describes functions added by XOP to IGOR.
   NT_FP64,      // parameter 1
   },
 
+  // variable zeromq_set_context_option(string option, variable value)
+  "zeromq_set_context_option",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  NT_FP64,      // parameter 2
+  },
+
   // variable zeromq_set_logging_template(string jsonString)
   "zeromq_set_logging_template",
   F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
@@ -111,6 +273,16 @@ resource 'XOPF' (1100) {   // Describes functions added by XOP to IGOR.
   HSTRING_TYPE,      // parameter 1
   },
 
+  // variable zeromq_set_option(string socketType, string option, variable value)
+  "zeromq_set_option",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  HSTRING_TYPE,      // parameter 2
+  NT_FP64,      // parameter 3
+  },
+
   // variable zeromq_stop()
   "zeromq_stop",
   F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
@@ -135,6 +307,14 @@ resource 'XOPF' (1100) {   // Describes functions added by XOP to IGOR.
   HSTRING_TYPE,      // parameter 1
   },
 
+  // string zeromq_sub_get_buffer_stats()
+  "zeromq_sub_get_buffer_stats",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  HSTRING_TYPE,          // Return value type
+  {
+
+  },
+
   // string zeromq_sub_recv(string *filter)
   "zeromq_sub_recv",
   F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
@@ -159,6 +339,42 @@ resource 'XOPF' (1100) {   // Describes functions added by XOP to IGOR.
   HSTRING_TYPE,      // parameter 1
   },
 
+  // variable zeromq_sub_set_buffer(string filter, variable capacity)
+  "zeromq_sub_set_buffer",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  NT_FP64,      // parameter 2
+  },
+
+  // variable zeromq_sub_set_callback(string filter, string callback)
+  "zeromq_sub_set_callback",
+  F_UTIL | F_EXTERNAL,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  HSTRING_TYPE,      // parameter 2
+  },
+
+  // variable zeromq_sub_set_compression(string filter, variable enable)
+  "zeromq_sub_set_compression",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  NT_FP64,      // parameter 2
+  },
+
+  // variable zeromq_sub_set_conflate(string filter, variable conflate)
+  "zeromq_sub_set_conflate",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  NT_FP64,          // Return value type
+  {
+  HSTRING_TYPE,      // parameter 1
+  NT_FP64,      // parameter 2
+  },
+
   // string zeromq_test_callfunction(string msg)
   "zeromq_test_callfunction",
   F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
@@ -175,5 +391,13 @@ resource 'XOPF' (1100) {   // Describes functions added by XOP to IGOR.
   WAVE_TYPE,      // parameter 1
   },
 
+  // string zeromq_trace_dump()
+  "zeromq_trace_dump",
+  F_UTIL | F_EXTERNAL | F_THREADSAFE,    // Function category
+  HSTRING_TYPE,          // Return value type
+  {
+
+  },
+
   }
 };
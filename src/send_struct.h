@@ -17,7 +17,7 @@ public:
   {
   }
 
-  SendStorage(std::string str) : storage(str)
+  SendStorage(std::string str) : storage(std::move(str))
   {
   }
 
@@ -41,6 +41,24 @@ public:
     return len;
   }
 
+  /// Return true if the frame owns its data, instead of referencing external
+  /// memory
+  bool OwnsData() const
+  {
+    return storage.has_value();
+  }
+
+  /// Move the owned data out of the frame, e.g. into a ZeroMQ message
+  std::string ReleaseData()
+  {
+    ASSERT(storage.has_value());
+
+    auto str = std::move(*storage);
+    storage.reset();
+
+    return str;
+  }
+
 private:
   const void *ptr{nullptr};
   size_t len{0};
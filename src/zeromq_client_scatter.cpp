@@ -0,0 +1,58 @@
+#include "ZeroMQ.h"
+#include "ScatterGather.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// string zeromq_client_scatter(WAVE endpoints, string msg, variable timeout)
+extern "C" int zeromq_client_scatter(zeromq_client_scatterParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto msg = GetStringFromHandleWithDispose(p->msg);
+  p->msg         = nullptr;
+
+  if(p->endpoints == nullptr)
+  {
+    throw IgorException(NOWAV);
+  }
+
+  if(WaveType(p->endpoints) != TEXT_WAVE_TYPE)
+  {
+    throw IgorException(ERR_INVALID_TYPE);
+  }
+
+  const auto dimensions = GetWaveDimension(p->endpoints);
+
+  const auto numRows = dimensions[0];
+  const auto numCols = dimensions[1];
+
+  if(numRows == 0 || numCols > 0)
+  {
+    throw IgorException(ERR_INVALID_TYPE);
+  }
+
+  if(!(p->timeout > 0))
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  const std::chrono::milliseconds timeout(
+      lockToIntegerRange<int32_t>(p->timeout * 1000));
+
+  std::vector<std::string> endpoints;
+  std::vector<IndexInt> indices(MAX_DIMENSIONS, 0);
+
+  for(CountInt i = 0; i < numRows; i++)
+  {
+    indices[0] = i;
+    endpoints.push_back(GetWaveElement<std::string>(p->endpoints, indices));
+  }
+
+  const auto doc = ScatterGather(endpoints, msg, timeout);
+
+  p->result = GetHandleFromString(doc.dump(DEFAULT_INDENT));
+  ASSERT(p->result != nullptr);
+
+  END_OUTER_CATCH
+}
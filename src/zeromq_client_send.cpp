@@ -8,11 +8,11 @@ extern "C" int zeromq_client_send(zeromq_client_sendParams *p)
 {
   BEGIN_OUTER_CATCH
 
-  const auto msg = GetStringFromHandle(p->msg);
+  auto msg = GetStringFromHandle(p->msg);
   WMDisposeHandle(p->msg);
 
   GlobalData::Instance().AddLogEntry(msg, MessageDirection::Outgoing);
-  ZeroMQClientSend(msg);
+  ZeroMQClientSend(std::move(msg));
 
   END_OUTER_CATCH
 }
@@ -9,7 +9,7 @@ extern "C" int zeromq_handler_stop(zeromq_handler_stopParams *p)
 {
   BEGIN_OUTER_CATCH
 
-  MessageHandler::Instance().Stop();
+  MessageHandler::Instance().Stop(DEFAULT_SERVER_NAME);
 
   END_OUTER_CATCH
 }
@@ -0,0 +1,17 @@
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// string zeromq_metrics_get()
+extern "C" int zeromq_metrics_get(zeromq_metrics_getParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto doc = MetricsRegistry::Instance().ToJSON();
+
+  p->result = GetHandleFromString(doc.dump(DEFAULT_INDENT));
+  ASSERT(p->result != nullptr);
+
+  END_OUTER_CATCH
+}
@@ -0,0 +1,14 @@
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_metrics_reset()
+extern "C" int zeromq_metrics_reset(zeromq_metrics_resetParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  MetricsRegistry::Instance().Reset();
+
+  END_OUTER_CATCH
+}
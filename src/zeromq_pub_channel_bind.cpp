@@ -0,0 +1,32 @@
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_pub_channel_bind(string name, string localPoint)
+extern "C" int zeromq_pub_channel_bind(zeromq_pub_channel_bindParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto name = GetStringFromHandleWithDispose(p->name);
+  p->name         = nullptr;
+
+  const auto point = GetStringFromHandleWithDispose(p->localPoint);
+  p->localPoint    = nullptr;
+
+  if(name.empty())
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  GET_NAMED_SOCKET(socket, SocketTypes::Publisher, name);
+
+  const auto rc = zmq_bind(socket.get(), point.c_str());
+  ZEROMQ_ASSERT(rc == 0);
+
+  DEBUG_OUTPUT("channel={}, point={}, rc={}", name, point, rc);
+  GlobalData::Instance().AddToListOfBindsOrConnections(
+      GetLastEndPoint(socket.get()), SocketTypes::Publisher, name);
+
+  END_OUTER_CATCH
+}
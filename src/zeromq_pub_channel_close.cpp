@@ -0,0 +1,26 @@
+#include "ZeroMQ.h"
+#include "PublisherFanIn.h"
+#include "PublisherSender.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_pub_channel_close(string name)
+extern "C" int zeromq_pub_channel_close(zeromq_pub_channel_closeParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto name = GetStringFromHandleWithDispose(p->name);
+  p->name         = nullptr;
+
+  if(name.empty())
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  PublisherSender::Instance().Stop(name);
+  PublisherFanIn::Instance().Stop(name);
+  GlobalData::Instance().CloseNamedSocket(SocketTypes::Publisher, name);
+
+  END_OUTER_CATCH
+}
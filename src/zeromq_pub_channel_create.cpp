@@ -0,0 +1,32 @@
+#include "ZeroMQ.h"
+#include "PublisherSender.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_pub_channel_create(string name, variable highWaterMark,
+// variable sendThread)
+extern "C" int zeromq_pub_channel_create(zeromq_pub_channel_createParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto name = GetStringFromHandleWithDispose(p->name);
+  p->name         = nullptr;
+
+  if(!std::isfinite(p->highWaterMark) || p->highWaterMark < 0)
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  PublisherSettings settings;
+  settings.highWaterMark = lockToIntegerRange<int>(p->highWaterMark);
+
+  GlobalData::Instance().CreatePublisherChannel(name, settings);
+
+  if(lockToIntegerRange<bool>(p->sendThread))
+  {
+    PublisherSender::Instance().Start(name, PublisherQueueSettings());
+  }
+
+  END_OUTER_CATCH
+}
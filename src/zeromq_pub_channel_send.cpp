@@ -0,0 +1,35 @@
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_pub_channel_send(string name, string filter, string msg)
+extern "C" int zeromq_pub_channel_send(zeromq_pub_channel_sendParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto name = GetStringFromHandleWithDispose(p->name);
+  p->name         = nullptr;
+
+  auto msg = GetStringFromHandleWithDispose(p->msg);
+  p->msg   = nullptr;
+
+  const auto filter = GetStringFromHandleWithDispose(p->filter);
+  p->filter         = nullptr;
+
+  if(name.empty())
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  GlobalData::Instance().AddLogEntry(name + ":" + filter + ":" + msg,
+                                     MessageDirection::Outgoing);
+
+  SendStorageVec sendStorage;
+  sendStorage.emplace_back(SendStorage{filter});
+  sendStorage.emplace_back(SendStorage{std::move(msg)});
+
+  ZeroMQPublisherSend(name, std::move(sendStorage));
+
+  END_OUTER_CATCH
+}
@@ -0,0 +1,27 @@
+#include "ZeroMQ.h"
+#include "send_struct.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_pub_channel_send_multi(string name, WAVEWAVE payload)
+extern "C" int
+zeromq_pub_channel_send_multi(zeromq_pub_channel_send_multiParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto name = GetStringFromHandleWithDispose(p->name);
+  p->name         = nullptr;
+
+  if(name.empty())
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  auto sendStorage = GatherPubData(p->payload);
+
+  int rc = ZeroMQPublisherSend(name, std::move(sendStorage));
+  ASSERT(rc >= 0);
+
+  END_OUTER_CATCH
+}
@@ -0,0 +1,24 @@
+#include "ZeroMQ.h"
+#include "PublisherSender.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// string zeromq_pub_get_queue_stats(string channel)
+extern "C" int zeromq_pub_get_queue_stats(zeromq_pub_get_queue_statsParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto channel = GetStringFromHandleWithDispose(p->channel);
+  p->channel         = nullptr;
+
+  // throws for unknown channels
+  GlobalData::Instance().GetPublisherSettings(channel);
+
+  const auto doc = PublisherSender::Instance().GetStatistics(channel);
+
+  p->result = GetHandleFromString(doc.dump(DEFAULT_INDENT));
+  ASSERT(p->result != nullptr);
+
+  END_OUTER_CATCH
+}
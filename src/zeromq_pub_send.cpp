@@ -9,8 +9,8 @@ extern "C" int zeromq_pub_send(zeromq_pub_sendParams *p)
 {
   BEGIN_OUTER_CATCH
 
-  const auto msg = GetStringFromHandleWithDispose(p->msg);
-  p->msg         = nullptr;
+  auto msg = GetStringFromHandleWithDispose(p->msg);
+  p->msg   = nullptr;
 
   const auto filter = GetStringFromHandleWithDispose(p->filter);
   p->filter         = nullptr;
@@ -20,9 +20,9 @@ extern "C" int zeromq_pub_send(zeromq_pub_sendParams *p)
 
   SendStorageVec sendStorage;
   sendStorage.emplace_back(SendStorage{filter});
-  sendStorage.emplace_back(SendStorage{msg});
+  sendStorage.emplace_back(SendStorage{std::move(msg)});
 
-  ZeroMQPublisherSend(sendStorage);
+  ZeroMQPublisherSend(DEFAULT_PUB_CHANNEL_NAME, std::move(sendStorage));
 
   END_OUTER_CATCH
 }
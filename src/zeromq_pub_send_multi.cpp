@@ -9,9 +9,10 @@ extern "C" int zeromq_pub_send_multi(zeromq_pub_send_multiParams *p)
 {
   BEGIN_OUTER_CATCH
 
-  const auto sendStorage = GatherPubData(p->payload);
+  auto sendStorage = GatherPubData(p->payload);
 
-  int rc = ZeroMQPublisherSend(sendStorage);
+  int rc =
+      ZeroMQPublisherSend(DEFAULT_PUB_CHANNEL_NAME, std::move(sendStorage));
   ASSERT(rc >= 0);
 
   END_OUTER_CATCH
@@ -0,0 +1,35 @@
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_pub_set_compression(string filter, string method, variable
+// threshold)
+extern "C" int zeromq_pub_set_compression(zeromq_pub_set_compressionParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto filter = GetStringFromHandleWithDispose(p->filter);
+  p->filter         = nullptr;
+
+  const auto method = GetStringFromHandleWithDispose(p->method);
+  p->method         = nullptr;
+
+  CompressionSettings settings;
+
+  if(!ParseCompressionMethod(method, settings.method))
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  if(!IsCompressionMethodAvailable(settings.method))
+  {
+    throw IgorException(COMPRESSION_UNAVAILABLE);
+  }
+
+  settings.threshold = lockToIntegerRange<size_t>(p->threshold);
+
+  GlobalData::Instance().SetPublisherCompression(filter, settings);
+
+  END_OUTER_CATCH
+}
@@ -0,0 +1,22 @@
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_pub_set_heartbeat(variable interval)
+extern "C" int zeromq_pub_set_heartbeat(zeromq_pub_set_heartbeatParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const std::chrono::milliseconds interval(
+      lockToIntegerRange<int32_t>(p->interval * 1000));
+
+  if(interval < MINIMUM_HEARTBEAT_INTERVAL)
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  HeartbeatPublisher::Instance().SetInterval(interval);
+
+  END_OUTER_CATCH
+}
@@ -0,0 +1,45 @@
+#include "ZeroMQ.h"
+#include "PublisherSender.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_pub_set_queue(string channel, variable capacity, string
+// dropPolicy)
+extern "C" int zeromq_pub_set_queue(zeromq_pub_set_queueParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto channel = GetStringFromHandleWithDispose(p->channel);
+  p->channel         = nullptr;
+
+  const auto dropPolicy = GetStringFromHandleWithDispose(p->dropPolicy);
+  p->dropPolicy         = nullptr;
+
+  if(!std::isfinite(p->capacity) || p->capacity < 0)
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  PublisherQueueSettings settings;
+  settings.capacity = lockToIntegerRange<size_t>(p->capacity);
+
+  if(!ParseDropPolicy(dropPolicy, settings.dropPolicy))
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  // throws for unknown channels
+  GlobalData::Instance().GetPublisherSettings(channel);
+
+  if(settings.capacity == 0)
+  {
+    PublisherSender::Instance().Stop(channel);
+  }
+  else
+  {
+    PublisherSender::Instance().Start(channel, settings);
+  }
+
+  END_OUTER_CATCH
+}
@@ -0,0 +1,31 @@
+#include "ZeroMQ.h"
+#include "PublisherFanIn.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_pub_set_thread_sockets(string channel, variable enable)
+extern "C" int
+zeromq_pub_set_thread_sockets(zeromq_pub_set_thread_socketsParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto channel = GetStringFromHandleWithDispose(p->channel);
+  p->channel         = nullptr;
+
+  const auto enable = lockToIntegerRange<bool>(p->enable);
+
+  // throws for unknown channels
+  GlobalData::Instance().GetPublisherSettings(channel);
+
+  if(enable)
+  {
+    PublisherFanIn::Instance().Start(channel);
+  }
+  else
+  {
+    PublisherFanIn::Instance().Stop(channel);
+  }
+
+  END_OUTER_CATCH
+}
@@ -0,0 +1,27 @@
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_server_instance_bind(string name, string localPoint)
+extern "C" int zeromq_server_instance_bind(zeromq_server_instance_bindParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto name = GetStringFromHandleWithDispose(p->name);
+  p->name         = nullptr;
+
+  const auto point = GetStringFromHandleWithDispose(p->localPoint);
+  p->localPoint    = nullptr;
+
+  GET_NAMED_SOCKET(socket, SocketTypes::Server, name);
+
+  const auto rc = zmq_bind(socket.get(), point.c_str());
+  ZEROMQ_ASSERT(rc == 0);
+
+  DEBUG_OUTPUT("server={}, point={}, rc={}", name, point, rc);
+  GlobalData::Instance().AddToListOfBindsOrConnections(
+      GetLastEndPoint(socket.get()), SocketTypes::Server, name);
+
+  END_OUTER_CATCH
+}
@@ -0,0 +1,31 @@
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_server_instance_create(string name, variable maxMessageSize,
+// variable priority, variable requestsPerIdle)
+extern "C" int
+zeromq_server_instance_create(zeromq_server_instance_createParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto name = GetStringFromHandleWithDispose(p->name);
+  p->name         = nullptr;
+
+  if(!std::isfinite(p->maxMessageSize) || p->maxMessageSize < -1 ||
+     !std::isfinite(p->priority) || !std::isfinite(p->requestsPerIdle) ||
+     p->requestsPerIdle < 0)
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  ServerSettings settings;
+  settings.maxMessageSize  = lockToIntegerRange<int64_t>(p->maxMessageSize);
+  settings.priority        = lockToIntegerRange<int>(p->priority);
+  settings.requestsPerIdle = lockToIntegerRange<size_t>(p->requestsPerIdle);
+
+  GlobalData::Instance().CreateServer(name, settings);
+
+  END_OUTER_CATCH
+}
@@ -0,0 +1,24 @@
+#include "ZeroMQ.h"
+#include "MessageHandler.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_server_instance_start(string name)
+extern "C" int
+zeromq_server_instance_start(zeromq_server_instance_startParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto name = GetStringFromHandleWithDispose(p->name);
+  p->name         = nullptr;
+
+  if(name.empty())
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  MessageHandler::Instance().Start(name);
+
+  END_OUTER_CATCH
+}
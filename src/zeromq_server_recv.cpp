@@ -20,7 +20,8 @@ extern "C" int zeromq_server_recv(zeromq_server_recvParams *p)
 
   for(;;)
   {
-    const int numBytes = ZeroMQServerReceive(&identityMsg, &payloadMsg);
+    const int numBytes =
+        ZeroMQServerReceive(DEFAULT_SERVER_NAME, &identityMsg, &payloadMsg);
 
     if(numBytes == -1 && zmq_errno() == EAGAIN) // timeout
     {
@@ -11,12 +11,12 @@ extern "C" int zeromq_server_send(zeromq_server_sendParams *p)
   const auto identity = GetStringFromHandle(p->identity);
   WMDisposeHandle(p->identity);
 
-  const auto msg = GetStringFromHandle(p->msg);
+  auto msg = GetStringFromHandle(p->msg);
   WMDisposeHandle(p->msg);
 
   GlobalData::Instance().AddLogEntry(msg, identity, MessageDirection::Outgoing);
 
-  ZeroMQServerSend(identity, msg);
+  ZeroMQServerSend(DEFAULT_SERVER_NAME, identity, std::move(msg));
 
   END_OUTER_CATCH
 }
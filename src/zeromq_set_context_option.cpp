@@ -0,0 +1,25 @@
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_set_context_option(string option, variable value)
+extern "C" int zeromq_set_context_option(zeromq_set_context_optionParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto name = GetStringFromHandleWithDispose(p->option);
+  p->option       = nullptr;
+
+  ZeroMQOption option;
+
+  if(!std::isfinite(p->value) ||
+     !ParseContextOption(name, lockToIntegerRange<int>(p->value), option))
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  GlobalData::Instance().SetContextOption(option);
+
+  END_OUTER_CATCH
+}
@@ -0,0 +1,30 @@
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_set_option(string socketType, string option, variable
+// value)
+extern "C" int zeromq_set_option(zeromq_set_optionParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto socketType = GetStringFromHandleWithDispose(p->socketType);
+  p->socketType         = nullptr;
+
+  const auto name = GetStringFromHandleWithDispose(p->option);
+  p->option       = nullptr;
+
+  SocketTypes st;
+  ZeroMQOption option;
+
+  if(!ParseSocketType(socketType, st) || !std::isfinite(p->value) ||
+     !ParseSocketOption(name, lockToIntegerRange<int>(p->value), option))
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  GlobalData::Instance().SetSocketOption(st, option);
+
+  END_OUTER_CATCH
+}
@@ -1,5 +1,8 @@
 #include "ZeroMQ.h"
 #include "MessageHandler.h"
+#include "PublisherFanIn.h"
+#include "PublisherSender.h"
+#include "SubscriberReceiver.h"
 
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
@@ -9,8 +12,12 @@ extern "C" int zeromq_stop(zeromq_stopParams *p)
 {
   BEGIN_OUTER_CATCH
 
-  MessageHandler::Instance().Stop();
+  MessageHandler::Instance().StopAll();
+  PublisherSender::Instance().StopAll();
+  PublisherFanIn::Instance().StopAll();
+  SubscriberReceiver::Instance().Stop();
   GlobalData::Instance().CloseConnections();
+  HeartbeatPublisher::Instance().SetInterval(DEFAULT_HEARTBEAT_INTERVAL);
 
   END_OUTER_CATCH
 }
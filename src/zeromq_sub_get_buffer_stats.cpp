@@ -0,0 +1,18 @@
+#include "ZeroMQ.h"
+#include "SubscriberReceiver.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// string zeromq_sub_get_buffer_stats()
+extern "C" int zeromq_sub_get_buffer_stats(zeromq_sub_get_buffer_statsParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto doc = SubscriberReceiver::Instance().GetStatistics();
+
+  p->result = GetHandleFromString(doc.dump(DEFAULT_INDENT));
+  ASSERT(p->result != nullptr);
+
+  END_OUTER_CATCH
+}
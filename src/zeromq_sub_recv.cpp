@@ -13,9 +13,8 @@ extern "C" int zeromq_sub_recv(zeromq_sub_recvParams *p)
   for(;;)
   {
     ZeroMQMessageSharedPtrVec vec;
-    int ret = ZeroMQSubscriberReceive(vec, false);
 
-    if(ret == -1 && zmq_errno() == EAGAIN) // timeout
+    if(!ZeroMQSubscriberReceive(vec, false)) // timeout
     {
       if(!wait || SpinProcess()) // user requested abort or we should not wait
       {
@@ -32,8 +31,6 @@ extern "C" int zeromq_sub_recv(zeromq_sub_recvParams *p)
       continue;
     }
 
-    ZEROMQ_ASSERT(ret == 0);
-
     auto filterMsg  = vec[0]->get();
     auto payloadMsg = vec[1]->get();
 
@@ -46,7 +43,6 @@ extern "C" int zeromq_sub_recv(zeromq_sub_recvParams *p)
     GlobalData::Instance().AddLogEntry(filter + ":" + msg,
                                        MessageDirection::Incoming);
 
-    DEBUG_OUTPUT("ret={}", ret);
     break;
   }
 
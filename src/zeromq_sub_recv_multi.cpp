@@ -14,9 +14,7 @@ extern "C" int zeromq_sub_recv_multi(zeromq_sub_recv_multiParams *p)
 
   for(;;)
   {
-    int ret = ZeroMQSubscriberReceive(vec, true);
-
-    if(ret == -1 && zmq_errno() == EAGAIN) // timeout
+    if(!ZeroMQSubscriberReceive(vec, true)) // timeout
     {
       if(!wait || SpinProcess()) // user requested abort or we should not wait
       {
@@ -31,9 +29,6 @@ extern "C" int zeromq_sub_recv_multi(zeromq_sub_recv_multiParams *p)
       continue;
     }
 
-    ZEROMQ_ASSERT(ret == 0);
-    DEBUG_OUTPUT("ret={}", ret);
-
     ConvertSubData(vec, p->payload);
     break;
   }
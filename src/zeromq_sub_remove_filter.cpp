@@ -1,4 +1,5 @@
 #include "ZeroMQ.h"
+#include "SubscriberReceiver.h"
 
 // This file is part of the `ZeroMQ-XOP` project and licensed under
 // BSD-3-Clause.
@@ -13,6 +14,7 @@ extern "C" int zeromq_sub_remove_filter(zeromq_sub_remove_filterParams *p)
   p->filter = nullptr;
 
   GlobalData::Instance().RemoveSubscriberMessageFilter(filter);
+  SubscriberReceiver::Instance().RemoveFilter(filter);
 
   END_OUTER_CATCH
 }
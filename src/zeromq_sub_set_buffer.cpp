@@ -0,0 +1,30 @@
+#include "ZeroMQ.h"
+#include "SubscriberReceiver.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_sub_set_buffer(string filter, variable capacity)
+extern "C" int zeromq_sub_set_buffer(zeromq_sub_set_bufferParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto filter = GetStringFromHandleWithDispose(p->filter);
+  p->filter         = nullptr;
+
+  if(!std::isfinite(p->capacity) || p->capacity < 1)
+  {
+    throw IgorException(INVALID_ARG);
+  }
+
+  const auto capacity = lockToIntegerRange<size_t>(p->capacity);
+
+  if(!GlobalData::Instance().HasSubscriberMessageFilter(filter))
+  {
+    throw IgorException(MESSAGE_FILTER_MISSING);
+  }
+
+  SubscriberReceiver::Instance().SetCapacity(filter, capacity);
+
+  END_OUTER_CATCH
+}
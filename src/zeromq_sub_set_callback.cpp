@@ -0,0 +1,33 @@
+#include "ZeroMQ.h"
+#include "SubscriberReceiver.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_sub_set_callback(string filter, string callback)
+extern "C" int zeromq_sub_set_callback(zeromq_sub_set_callbackParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto filter = GetStringFromHandleWithDispose(p->filter);
+  p->filter         = nullptr;
+
+  const auto callback = GetStringFromHandleWithDispose(p->callback);
+  p->callback         = nullptr;
+
+  if(!GlobalData::Instance().HasSubscriberMessageFilter(filter))
+  {
+    throw IgorException(MESSAGE_FILTER_MISSING);
+  }
+
+  FunctionInfo fip;
+
+  if(!callback.empty() && !GetSubscriberCallbackInfo(callback, fip))
+  {
+    throw IgorException(INVALID_CALLBACK);
+  }
+
+  SubscriberReceiver::Instance().SetCallback(filter, callback);
+
+  END_OUTER_CATCH
+}
@@ -0,0 +1,24 @@
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_sub_set_compression(string filter, variable enable)
+extern "C" int zeromq_sub_set_compression(zeromq_sub_set_compressionParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto filter = GetStringFromHandleWithDispose(p->filter);
+  p->filter         = nullptr;
+
+  const auto enable = lockToIntegerRange<bool>(p->enable);
+
+  if(!GlobalData::Instance().HasSubscriberMessageFilter(filter))
+  {
+    throw IgorException(MESSAGE_FILTER_MISSING);
+  }
+
+  GlobalData::Instance().SetSubscriberCompression(filter, enable);
+
+  END_OUTER_CATCH
+}
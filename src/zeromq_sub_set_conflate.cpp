@@ -0,0 +1,25 @@
+#include "ZeroMQ.h"
+#include "SubscriberReceiver.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// variable zeromq_sub_set_conflate(string filter, variable conflate)
+extern "C" int zeromq_sub_set_conflate(zeromq_sub_set_conflateParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto filter = GetStringFromHandleWithDispose(p->filter);
+  p->filter         = nullptr;
+
+  const auto conflate = lockToIntegerRange<bool>(p->conflate);
+
+  if(!GlobalData::Instance().HasSubscriberMessageFilter(filter))
+  {
+    throw IgorException(MESSAGE_FILTER_MISSING);
+  }
+
+  SubscriberReceiver::Instance().SetConflate(filter, conflate);
+
+  END_OUTER_CATCH
+}
@@ -15,7 +15,11 @@ extern "C" int zeromq_test_callfunction(zeromq_test_callfunctionParams *p)
 
   DEBUG_OUTPUT("input={}", msg);
 
-  auto doc = CallIgorFunctionFromMessage(msg);
+  // binary data follows after a null byte
+  std::string binary;
+  SplitBinaryPayload(msg, binary);
+
+  auto doc = CallIgorFunctionFromMessage(msg, std::move(binary));
 
   auto retMessage = doc.dump(DEFAULT_INDENT);
   auto len        = retMessage.size();
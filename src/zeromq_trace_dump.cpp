@@ -0,0 +1,17 @@
+#include "ZeroMQ.h"
+
+// This file is part of the `ZeroMQ-XOP` project and licensed under
+// BSD-3-Clause.
+
+// string zeromq_trace_dump()
+extern "C" int zeromq_trace_dump(zeromq_trace_dumpParams *p)
+{
+  BEGIN_OUTER_CATCH
+
+  const auto doc = Tracer::Instance().Dump();
+
+  p->result = GetHandleFromString(doc.dump());
+  ASSERT(p->result != nullptr);
+
+  END_OUTER_CATCH
+}
@@ -35,6 +35,41 @@ THREADSAFE variable zeromq_stop();
 /// @param flags One of @ref ZeroMQSetFlags
 THREADSAFE variable zeromq_set(variable flags);
 
+/// @brief Set a socket option for all sockets of the given type
+///
+/// The option is applied to the existing socket of the type and to all sockets
+/// created later, including named servers and publisher channels. The high
+/// water mark of zeromq_pub_channel_create() and the maximum message size of
+/// zeromq_server_instance_create() take precedence. The options must be set
+/// before binding or connecting and are reset by zeromq_stop().
+///
+/// Supported options:
+/// - `SNDHWM`, `RCVHWM`: high water marks in messages, 0 means no limit
+/// - `SNDBUF`, `RCVBUF`: kernel buffer sizes in bytes, -1 uses the OS default
+/// - `TCP_KEEPALIVE`: 1 to enable, 0 to disable, -1 uses the OS default
+/// - `TCP_KEEPALIVE_CNT`, `TCP_KEEPALIVE_IDLE`, `TCP_KEEPALIVE_INTVL`: -1 uses
+///   the OS default
+///
+/// @param socketType one of `client`, `server`, `publisher` or `subscriber`
+/// @param option     option name without `ZMQ_` prefix
+/// @param value      option value
+THREADSAFE variable zeromq_set_option(string socketType, string option, variable value);
+
+/// @brief Set an option of the ZeroMQ context
+///
+/// Can only be called if there are no sockets, so either before the first
+/// bind/connect or after zeromq_stop(). The options are kept until Igor Pro
+/// quits.
+///
+/// Supported options:
+/// - `IO_THREADS`: number of I/O threads, at least 1, defaults to 1
+/// - `THREAD_AFFINITY_CPU_ADD`, `THREAD_AFFINITY_CPU_REMOVE`: add or remove a
+///   CPU core from the affinity set of the I/O threads
+///
+/// @param option option name without `ZMQ_` prefix
+/// @param value  option value
+THREADSAFE variable zeromq_set_context_option(string option, variable value);
+
 /// @brief Start listening on the given TCP port
 ///
 /// @param localPoint transport protocol and address, something like
@@ -78,6 +113,21 @@ THREADSAFE variable zeromq_client_connect(string remotePoint);
 /// @return received message
 THREADSAFE string zeromq_client_recv();
 
+/// @brief Send a message to multiple servers and gather their replies
+///
+/// The message is sent to all endpoints at once, each over its own connection,
+/// so the call takes about as long as the slowest server. The default client
+/// socket and its connections are not used, socket options set for `client`
+/// apply.
+///
+/// @param endpoints 1D text wave with the protocol and address of the servers
+/// @param msg       message to send
+/// @param timeout   time in seconds to wait for all replies
+///
+/// @return JSON array with the endpoint, error, latency and reply of each
+///         server, see ScatterGather()
+THREADSAFE string zeromq_client_scatter(WAVE endpoints, string msg, variable timeout);
+
 /// @name Publishers and Subscribers
 ///
 /// @{
@@ -99,6 +149,107 @@ THREADSAFE variable zeromq_pub_send(string filter, string msg);
 /// @brief Multipart variant of zeromq_pub_send
 THREADSAFE variable zeromq_pub_send_multi(WAVEWAVE payload);
 
+/// @brief Compress published messages
+///
+/// All frames except the message filter of messages whose filter starts with
+/// `filter` are compressed, the longest matching filter wins. Frames smaller
+/// than `threshold` bytes or which would not get smaller are sent as is.
+/// Compressed frames start with the magic number of the zstd/lz4 frame format
+/// and are decompressed by zeromq_sub_recv() and zeromq_sub_recv_multi() for
+/// subscriptions enabled with zeromq_sub_set_compression().
+///
+/// The settings are reset by zeromq_stop().
+///
+/// @param filter    message filter prefix, use an empty string for all messages
+/// @param method    one of `zstd`, `lz4` or `none` to remove the setting
+/// @param threshold minimum frame size in bytes for compression
+THREADSAFE variable zeromq_pub_set_compression(string filter, string method, variable threshold);
+
+/// @brief Set the interval of the heartbeat messages
+///
+/// A message with the filter `heartbeat` is published every `interval` seconds
+/// (default: 5 seconds) if a publisher socket is bound. Its payload is a JSON
+/// object with health information, see the Readme. Changing the interval
+/// publishes a heartbeat immediately.
+///
+/// The interval is reset by zeromq_stop().
+///
+/// @param interval interval in seconds, must be at least 0.01
+THREADSAFE variable zeromq_pub_set_heartbeat(variable interval);
+
+/// @brief Send the messages of a publisher channel from a dedicated thread
+///
+/// The sending functions then only copy the message into a queue of at most
+/// `capacity` messages and return immediately. If the queue is full, the
+/// `dropPolicy` decides: `oldest` drops the oldest queued message, `newest`
+/// drops the message to send and `block` waits until the send thread made room.
+/// Changing the settings keeps the queued messages and the statistics, see
+/// zeromq_pub_get_queue_stats().
+///
+/// The queues are removed by zeromq_stop().
+///
+/// @param channel    name of the channel, use an empty string for the default
+///                   channel
+/// @param capacity   maximum number of queued messages, use 0 to send from the
+///                   calling thread again
+/// @param dropPolicy one of `oldest`, `newest` or `block`
+THREADSAFE variable zeromq_pub_set_queue(string channel, variable capacity, string dropPolicy);
+
+/// @brief Give every sending thread its own socket for a publisher channel
+///
+/// By default all threads publishing on a channel share its socket and
+/// serialize on it. With thread sockets each thread compresses and sends its
+/// messages over a socket of its own, and a forwarding thread passes them on
+/// to the publisher socket without copying. Meant for publishing from many
+/// Igor Pro preemptive threads. The messages of one thread keep their order.
+/// Channels with a send queue, see zeromq_pub_set_queue(), do not use the
+/// thread sockets.
+///
+/// @param channel name of the channel, use an empty string for the default
+///                channel
+/// @param enable  1 to use thread sockets, 0 to send over the publisher socket
+THREADSAFE variable zeromq_pub_set_thread_sockets(string channel, variable enable);
+
+/// @brief Return the send queue statistics of a publisher channel as JSON text
+///
+/// Holds the `capacity` and `dropPolicy` of the queue, the number of `queued`
+/// messages and the counters of `enqueued`, `sent` and `dropped` messages.
+/// Messages dropped by ZeroMQ due to the high water mark are not counted.
+///
+/// @param channel name of the channel, use an empty string for the default
+///                channel
+THREADSAFE string zeromq_pub_get_queue_stats(string channel);
+
+/// @brief Create a named publisher channel
+///
+/// Channels have their own `ZMQ_PUB` socket, so that e.g. publishing bulk
+/// data does not delay the heartbeat and small status messages of the default
+/// channel used by zeromq_pub_send(). Subscribers connect to the endpoints of
+/// the channel. All channels are closed by zeromq_stop().
+///
+/// @param name          name of the channel, must be unique and not empty
+/// @param highWaterMark maximum number of queued messages per subscriber
+///                      (ZMQ_SNDHWM), further messages are dropped, use 0 for
+///                      no limit
+/// @param sendThread    send the messages from a dedicated thread, see
+///                      zeromq_pub_set_queue() for the queue settings
+THREADSAFE variable zeromq_pub_channel_create(string name, variable highWaterMark, variable sendThread);
+
+/// @brief Start listening on the given point with the named channel
+///
+/// @param name       name of the channel
+/// @param localPoint see zeromq_pub_bind()
+THREADSAFE variable zeromq_pub_channel_bind(string name, string localPoint);
+
+/// @brief Variant of zeromq_pub_send() for named channels
+THREADSAFE variable zeromq_pub_channel_send(string name, string filter, string msg);
+
+/// @brief Variant of zeromq_pub_send_multi() for named channels
+THREADSAFE variable zeromq_pub_channel_send_multi(string name, WAVEWAVE payload);
+
+/// @brief Send the queued messages and close the named channel
+THREADSAFE variable zeromq_pub_channel_close(string name);
+
 /// @brief Connect to a ZMQ_PUB socket as ZMQ_SUB
 ///
 /// @param remotePoint Protocol and address of the server, usually something
@@ -125,6 +276,73 @@ THREADSAFE variable zeromq_sub_add_filter(string filter);
 /// to unsubscribe from all messages.
 THREADSAFE variable zeromq_sub_remove_filter(string filter);
 
+/// @brief Only keep the latest message per topic of the subscription
+///
+/// Meant for live displays which only need the newest data. A receive thread
+/// then reads all subscribed messages as they arrive. For conflated
+/// subscriptions it only keeps the latest message per topic, i.e. the first
+/// frame, so that zeromq_sub_recv() and zeromq_sub_recv_multi() never return
+/// outdated messages. The messages of the other subscriptions are returned
+/// unchanged.
+///
+/// The receive thread is stopped by zeromq_stop().
+///
+/// @param filter   message filter of zeromq_sub_add_filter()
+/// @param conflate 1 to only keep the latest message, 0 to keep all
+THREADSAFE variable zeromq_sub_set_conflate(string filter, variable conflate);
+
+/// @brief Decompress the messages of the subscription
+///
+/// Frames compressed with zeromq_pub_set_compression() are then decompressed
+/// by zeromq_sub_recv() and zeromq_sub_recv_multi(). Without this all frames
+/// are returned as received, as binary frames can start with the magic number
+/// of a compressed frame.
+///
+/// The setting is reset by zeromq_sub_remove_filter() and zeromq_stop().
+///
+/// @param filter message filter of zeromq_sub_add_filter()
+/// @param enable 1 to decompress, 0 to return the frames as received
+THREADSAFE variable zeromq_sub_set_compression(string filter, variable enable);
+
+/// @brief Set the number of messages buffered for the subscription
+///
+/// A receive thread then reads all subscribed messages as they arrive and
+/// keeps up to `capacity` unread messages of that subscription. If the buffer
+/// is full the oldest message is dropped. zeromq_sub_recv() and
+/// zeromq_sub_recv_multi() only dequeue from the buffers. Messages of
+/// subscriptions without own buffer share the default buffer with a capacity
+/// of 1000 messages. The capacity is not used for conflated subscriptions.
+///
+/// The receive thread is stopped by zeromq_stop().
+///
+/// @param filter   message filter of zeromq_sub_add_filter()
+/// @param capacity maximum number of unread messages, must be at least 1
+THREADSAFE variable zeromq_sub_set_buffer(string filter, variable capacity);
+
+/// @brief Return the receive buffer statistics of the subscriptions as JSON
+/// text
+///
+/// Holds an array with one object per buffer with its `filter`, `null` for
+/// the default buffer, `capacity`, `conflate` setting, the number of `queued`
+/// messages and the counters of `received` and `dropped` messages.
+THREADSAFE string zeromq_sub_get_buffer_stats();
+
+/// @brief Call an Igor function for each message of the subscription
+///
+/// A receive thread then reads all subscribed messages as they arrive and the
+/// messages of the subscription are passed to the function whenever Igor Pro
+/// is idle, all messages received until then in one go. Its signature must be
+/// `Function proto(string filter, string msg)`. The messages are not returned
+/// by zeromq_sub_recv() anymore. Messages with more than two frames are
+/// dropped.
+///
+/// The receive thread is stopped by zeromq_stop().
+///
+/// @param filter   message filter of zeromq_sub_add_filter()
+/// @param callback name of the Igor function, use an empty string to remove
+///                 the callback
+variable zeromq_sub_set_callback(string filter, string callback);
+
 /// @brief Receive subscribed messages
 THREADSAFE string zeromq_sub_recv(string *filter);
 /// @}
@@ -144,6 +362,42 @@ variable zeromq_handler_start();
 variable zeromq_handler_stop();
 /// @}
 
+/// @name Server instances
+///
+/// Additional named servers, each with its own `ROUTER` socket, receive thread
+/// and request queue. Requests of named servers are always handled by the
+/// message handler, zeromq_server_recv() and zeromq_server_send() only work
+/// with the default server. Use different servers for keeping e.g. a low
+/// latency control endpoint independent from a bulk data endpoint.
+/// @{
+
+/// @brief Create a named server
+///
+/// @param name            name of the server, must be unique and not empty
+/// @param maxMessageSize  maximum size in bytes of received messages, clients
+///                        sending larger messages are disconnected, use -1 for
+///                        no limit
+/// @param priority        requests of servers with higher priority are
+///                        called first during IDLE events
+/// @param requestsPerIdle maximum number of requests called per IDLE event,
+///                        use 0 for no limit
+THREADSAFE variable zeromq_server_instance_create(string name, variable maxMessageSize, variable priority, variable requestsPerIdle);
+
+/// @brief Start listening on the given point with the named server
+///
+/// @param name       name of the server
+/// @param localPoint see zeromq_server_bind()
+THREADSAFE variable zeromq_server_instance_bind(string name, string localPoint);
+
+/// @brief Start the receive thread of the named server
+variable zeromq_server_instance_start(string name);
+
+/// @brief Stop the receive thread of the named server and close its socket
+///
+/// All named servers are closed by zeromq_stop().
+variable zeromq_server_instance_close(string name);
+/// @}
+
 /// Set logging template
 ///
 /// Set the JSON text used as template for the JSONL log file.
@@ -156,6 +410,32 @@ variable zeromq_handler_stop();
 /// - Top-level entity must be a JSON object and does not have reserved keys
 THREADSAFE variable zeromq_set_logging_template(string jsonString);
 
+/// @name Metrics
+///
+/// Latency histograms and counters of all XOP functions and of the stages of
+/// the message handler. Recording must be enabled with
+/// `zeromq_set(ZeroMQ_SET_FLAGS_METRICS)`, the metrics are then also published
+/// with the heartbeat using the message filter `stats`.
+/// @{
+
+/// @brief Return all metrics as JSON text
+THREADSAFE string zeromq_metrics_get();
+
+/// @brief Reset all metrics to zero
+THREADSAFE variable zeromq_metrics_reset();
+/// @}
+
+/// @name Tracing
+///
+/// Spans of the message handler stages with thread and request numbers.
+/// Recording must be enabled with `zeromq_set(ZeroMQ_SET_FLAGS_TRACING)`.
+/// @{
+
+/// @brief Return all recorded spans in the Chrome trace event format and
+/// clear them
+THREADSAFE string zeromq_trace_dump();
+/// @}
+
 /// @cond DOXYGEN_IGNORES_THIS
 /// @name Functions used for testing and debugging
 /// @{